@@ -10,6 +10,7 @@
 #include "EthosNBackendUtils.hpp"
 #include "EthosNLayerSupport.hpp"
 #include "EthosNMapping.hpp"
+#include "EthosNProcessContext.hpp"
 #include "EthosNSubgraphViewConverter.hpp"
 #include "EthosNWorkloadFactory.hpp"
 
@@ -812,7 +813,7 @@ void CreatePreCompiledLayerInGraph(OptimizationViews& optimizationViews,
                                    const EthosNMappings& mappings)
 {
     SubgraphView subgraphToCompile = subgraph;
-    g_EthosNConfig                 = GetEthosNConfig();
+    g_EthosNConfig                 = GetEthosNProcessContext()->GetConfig();
 
     // Graph is needed here to keep ownership of the layers
     Graph newGraph = Graph();
@@ -917,8 +918,9 @@ IBackendInternal::ILayerSupportSharedPtr EthosNBackend::GetLayerSupport() const
 OptimizationViews EthosNBackend::OptimizeSubgraphView(const SubgraphView& subgraph) const
 {
     OptimizationViews optimizationViews;
-    g_EthosNConfig   = GetEthosNConfig();
-    g_EthosNMappings = GetMappings(g_EthosNConfig.m_PerfMappingFile);
+    std::shared_ptr<const EthosNProcessContext> context = GetEthosNProcessContext();
+    g_EthosNConfig                                      = context->GetConfig();
+    g_EthosNMappings                                    = context->GetMappings();
 
     // Create a pre-compiled layer
     armnn::CreatePreCompiledLayerInGraph(optimizationViews, subgraph, g_EthosNMappings);
@@ -0,0 +1,251 @@
+//
+// Copyright © 2020 Arm Limited. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "EthosNCompiledNetworkCache.hpp"
+
+#include <Filesystem.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <thread>
+
+namespace armnn
+{
+
+namespace
+{
+
+// Entries in memory are dropped, least recently used first, once they take more than this
+constexpr uint64_t g_EthosNCompiledNetworkCacheMaxMemoryBytes = 256 * 1024 * 1024;
+
+/// Must be incremented whenever a change is made to the layout of the files, so that files written by older
+/// versions are ignored. Changes to the compiled networks themselves are covered by the key.
+constexpr uint32_t g_EthosNCompiledNetworkCacheVersion = 1;
+
+struct EntryHeader
+{
+    char m_Magic[4];
+    uint32_t m_Version;
+    uint64_t m_KeySize;
+    uint64_t m_NumNetworks;
+};
+
+constexpr char g_EntryMagic[4] = { 'E', 'N', 'C', 'N' };
+
+std::string GetEntryPath(const std::string& dir, const std::vector<uint8_t>& key)
+{
+    std::stringstream path;
+    path << dir << "/" << std::hex << std::setfill('0');
+    for (uint8_t byte : key)
+    {
+        path << std::setw(2) << static_cast<uint32_t>(byte);
+    }
+    path << ".bin";
+    return path.str();
+}
+
+/// Reads the next size bytes of the file contents at offset, returning false if there are not enough.
+bool Read(const std::string& contents, size_t& offset, void* dst, uint64_t size)
+{
+    if (size > contents.size() - offset)
+    {
+        return false;
+    }
+    std::memcpy(dst, contents.data() + offset, size);
+    offset += size;
+    return true;
+}
+
+bool LoadFromFile(const std::vector<uint8_t>& key,
+                  const std::string& dir,
+                  EthosNCompiledNetworkCache::SerializedNetworks& networks)
+{
+    std::ifstream file(GetEntryPath(dir, key), std::ios::binary);
+    if (!file.good())
+    {
+        return false;
+    }
+    const std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    size_t offset = 0;
+    EntryHeader header;
+    if (!Read(contents, offset, &header, sizeof(header)) ||
+        std::memcmp(header.m_Magic, g_EntryMagic, sizeof(g_EntryMagic)) != 0 ||
+        header.m_Version != g_EthosNCompiledNetworkCacheVersion || header.m_KeySize != key.size())
+    {
+        return false;
+    }
+
+    if (key.size() > contents.size() - offset || std::memcmp(contents.data() + offset, key.data(), key.size()) != 0)
+    {
+        return false;
+    }
+    offset += key.size();
+
+    EthosNCompiledNetworkCache::SerializedNetworks result;
+    for (uint64_t i = 0; i < header.m_NumNetworks; ++i)
+    {
+        uint64_t size;
+        if (!Read(contents, offset, &size, sizeof(size)) || size > contents.size() - offset)
+        {
+            return false;
+        }
+        result.emplace_back(contents, offset, size);
+        offset += size;
+    }
+
+    if (offset != contents.size())
+    {
+        return false;
+    }
+
+    networks = std::move(result);
+    return true;
+}
+
+void StoreInFile(const std::vector<uint8_t>& key,
+                 const std::string& dir,
+                 const EthosNCompiledNetworkCache::SerializedNetworks& networks)
+{
+    EntryHeader header;
+    std::memcpy(header.m_Magic, g_EntryMagic, sizeof(g_EntryMagic));
+    header.m_Version     = g_EthosNCompiledNetworkCacheVersion;
+    header.m_KeySize     = key.size();
+    header.m_NumNetworks = networks.size();
+
+    std::error_code error;
+    fs::create_directories(dir, error);
+
+    // Write to a file which no other thread or process will be using, then move it into place in one step.
+    const std::string path = GetEntryPath(dir, key);
+    std::stringstream tmpPath;
+    tmpPath << path << ".tmp" << std::hex << std::hash<std::thread::id>()(std::this_thread::get_id()) << "_"
+            << std::random_device()();
+
+    {
+        std::ofstream out(tmpPath.str(), std::ios::binary);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(key.data()), static_cast<std::streamsize>(key.size()));
+        for (const std::string& network : networks)
+        {
+            const uint64_t size = network.size();
+            out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+            out.write(network.data(), static_cast<std::streamsize>(network.size()));
+        }
+        out.close();
+        if (!out.good())
+        {
+            std::remove(tmpPath.str().c_str());
+            return;
+        }
+    }
+
+    if (std::rename(tmpPath.str().c_str(), path.c_str()) != 0)
+    {
+        std::remove(tmpPath.str().c_str());
+    }
+}
+
+}    // namespace
+
+EthosNCompiledNetworkCache::EthosNCompiledNetworkCache(uint64_t maxMemoryBytes)
+    : m_MaxMemoryBytes(maxMemoryBytes)
+    , m_MemoryBytes(0)
+{}
+
+EthosNCompiledNetworkCache& EthosNCompiledNetworkCache::GetInstance()
+{
+    static EthosNCompiledNetworkCache cache(g_EthosNCompiledNetworkCacheMaxMemoryBytes);
+    return cache;
+}
+
+bool EthosNCompiledNetworkCache::Load(const std::vector<uint8_t>& key,
+                                      const std::string& dir,
+                                      SerializedNetworks& networks)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto it = m_EntriesByKey.find(key);
+        if (it != m_EntriesByKey.end())
+        {
+            // Move the entry to the front, as it is now the most recently used
+            m_Entries.splice(m_Entries.begin(), m_Entries, it->second);
+            networks = it->second->m_Networks;
+            return true;
+        }
+    }
+
+    if (dir.empty() || !LoadFromFile(key, dir, networks))
+    {
+        return false;
+    }
+
+    StoreInMemory(key, networks);
+    return true;
+}
+
+void EthosNCompiledNetworkCache::Store(const std::vector<uint8_t>& key,
+                                       const std::string& dir,
+                                       const SerializedNetworks& networks)
+{
+    StoreInMemory(key, networks);
+
+    if (!dir.empty())
+    {
+        StoreInFile(key, dir, networks);
+    }
+}
+
+uint64_t EthosNCompiledNetworkCache::GetMemoryBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_MemoryBytes;
+}
+
+void EthosNCompiledNetworkCache::StoreInMemory(const std::vector<uint8_t>& key, const SerializedNetworks& networks)
+{
+    uint64_t sizeBytes = key.size();
+    for (const std::string& network : networks)
+    {
+        sizeBytes += network.size();
+    }
+
+    // Entries which could never fit are not kept at all, rather than evicting everything else
+    if (sizeBytes > m_MaxMemoryBytes)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    // Replace any existing entry with this key
+    auto it = m_EntriesByKey.find(key);
+    if (it != m_EntriesByKey.end())
+    {
+        m_MemoryBytes -= it->second->m_SizeBytes;
+        m_Entries.erase(it->second);
+        m_EntriesByKey.erase(it);
+    }
+
+    m_Entries.push_front(Entry{ key, networks, sizeBytes });
+    m_EntriesByKey.emplace(key, m_Entries.begin());
+    m_MemoryBytes += sizeBytes;
+
+    while (m_MemoryBytes > m_MaxMemoryBytes)
+    {
+        auto lru = std::prev(m_Entries.end());
+        m_EntriesByKey.erase(lru->m_Key);
+        m_MemoryBytes -= lru->m_SizeBytes;
+        m_Entries.erase(lru);
+    }
+}
+
+}    // namespace armnn
@@ -0,0 +1,69 @@
+//
+// Copyright © 2020 Arm Limited. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace armnn
+{
+
+/// A cache of the serialized CompiledNetworks which result from compiling subgraphs, so that loading the same model
+/// again does not compile it again. Entries are kept in memory for the lifetime of the process and, if a directory is
+/// given, also stored in files so that they are reused by later processes.
+///
+/// Entries are identified by the key returned by ethosn::support_library::GetCompilationKey(), which is a SHA-256
+/// digest of everything the compiled networks depend on. Each file is named after its key and also stores it, which
+/// is compared when the entry is loaded so that a renamed or truncated file is never used.
+/// Files are written to a temporary file which is then renamed, so concurrent readers and writers never see a
+/// partially written entry. All errors in reading or writing files are treated as cache misses.
+class EthosNCompiledNetworkCache
+{
+public:
+    /// The serialized CompiledNetworks resulting from the compilation of one subgraph.
+    using SerializedNetworks = std::vector<std::string>;
+
+    /// Entries are evicted from memory, least recently used first, when their total size exceeds maxMemoryBytes.
+    explicit EthosNCompiledNetworkCache(uint64_t maxMemoryBytes);
+
+    /// Returns the cache shared by every subgraph compiled in this process.
+    static EthosNCompiledNetworkCache& GetInstance();
+
+    /// Looks up the entry with the given key, first in memory and then in dir unless that is empty.
+    /// Returns false if there is no valid entry.
+    bool Load(const std::vector<uint8_t>& key, const std::string& dir, SerializedNetworks& networks);
+
+    /// Adds or replaces the entry with the given key, in memory and in dir unless that is empty.
+    void Store(const std::vector<uint8_t>& key, const std::string& dir, const SerializedNetworks& networks);
+
+    /// The total size of the keys and networks of the entries in memory.
+    uint64_t GetMemoryBytes() const;
+
+private:
+    struct Entry
+    {
+        std::vector<uint8_t> m_Key;
+        SerializedNetworks m_Networks;
+        uint64_t m_SizeBytes;
+    };
+
+    void StoreInMemory(const std::vector<uint8_t>& key, const SerializedNetworks& networks);
+
+    uint64_t m_MaxMemoryBytes;
+
+    /// Protects the members below
+    mutable std::mutex m_Mutex;
+    /// Most recently used first
+    std::list<Entry> m_Entries;
+    /// Entries indexed by their key
+    std::map<std::vector<uint8_t>, std::list<Entry>::iterator> m_EntriesByKey;
+    uint64_t m_MemoryBytes;
+};
+
+}    // namespace armnn
@@ -77,6 +77,8 @@ constexpr char EthosNConfig::PERF_ACTIVATION_COMPRESSION_SAVING[];
 constexpr char EthosNConfig::PERF_CURRENT[];
 constexpr char EthosNConfig::COMPILER_ALGORITHM[];
 constexpr char EthosNConfig::INTERMEDIATE_COMPRESSION[];
+constexpr char EthosNConfig::COMPILED_NETWORK_CACHE_DIR[];
+constexpr char EthosNConfig::DEFERRED_COMPILATION[];
 
 EthosNConfig GetEthosNConfig()
 {
@@ -117,6 +119,9 @@ std::ostream& operator<<(std::ostream& configFile, const armnn::EthosNConfig& co
     }
     configFile << armnn::EthosNConfig::INTERMEDIATE_COMPRESSION << " = " << config.m_IntermediateCompression
                << std::endl;
+    configFile << armnn::EthosNConfig::COMPILED_NETWORK_CACHE_DIR << " = " << config.m_CompiledNetworkCacheDir
+               << std::endl;
+    configFile << armnn::EthosNConfig::DEFERRED_COMPILATION << " = " << config.m_DeferredCompilation << std::endl;
     configFile.flush();
 
     return configFile;
@@ -221,6 +226,14 @@ std::istream& operator>>(std::istream& configFile, armnn::EthosNConfig& config)
                 {
                     config.m_IntermediateCompression = TryConvertToBool(m[2], line, lineNo);
                 }
+                else if (m[1] == armnn::EthosNConfig::COMPILED_NETWORK_CACHE_DIR)
+                {
+                    config.m_CompiledNetworkCacheDir = m[2];
+                }
+                else if (m[1] == armnn::EthosNConfig::DEFERRED_COMPILATION)
+                {
+                    config.m_DeferredCompilation = TryConvertToBool(m[2], line, lineNo);
+                }
                 else
                 {
                     throw armnn::Exception("Unknown var in config file: line " + std::to_string(lineNo) + ": " + line);
@@ -12,7 +12,8 @@
 namespace armnn
 {
 
-/// Ethos-N backend configuration. It should be obtained via GetEthosNConfig()
+/// Ethos-N backend configuration. Within the backend it should be obtained from GetEthosNProcessContext(),
+/// which reads it once and shares it, rather than from GetEthosNConfig()
 struct EthosNConfig
 {
     // Environment variable that points to the config file
@@ -32,6 +33,8 @@ struct EthosNConfig
     static constexpr char PERF_CURRENT[]                        = "PERFORMANCE_CURRENT";                          // boolean
     static constexpr char COMPILER_ALGORITHM[]                  = "COMPILER_ALGORITHM";                           // enum
     static constexpr char INTERMEDIATE_COMPRESSION[]            = "INTERMEDIATE_COMPRESSION";                     // boolean
+    static constexpr char COMPILED_NETWORK_CACHE_DIR[]          = "COMPILED_NETWORK_CACHE_DIR";                   // string
+    static constexpr char DEFERRED_COMPILATION[]                = "DEFERRED_COMPILATION";                         // boolean
     // clang-format on
 
     bool m_PerfOnly                                      = false;
@@ -48,8 +51,16 @@ struct EthosNConfig
     ethosn::support_library::CompilerAlgorithm m_CompilerAlgorithm =
         ethosn::support_library::CompilerAlgorithm::NonCascadingOnly;
     bool m_IntermediateCompression = true;
+    /// If not empty, compiled subgraphs are also cached in files in this directory, so that they are reused by
+    /// later processes. They are always cached in memory.
+    std::string m_CompiledNetworkCacheDir = "";
+    /// If enabled, subgraphs are compiled on worker threads in the background, so that several subgraphs are
+    /// compiled at once, and the workloads wait for them to be compiled when they are created.
+    /// A subgraph which fails to compile then makes the creation of its workload fail, rather than falling back
+    /// to another backend.
+    bool m_DeferredCompilation = false;
 
-    std::vector<char> GetCapabilities()
+    std::vector<char> GetCapabilities() const
     {
         return m_PerfOnly ? ethosn::support_library::GetFwAndHwCapabilities(m_PerfVariant, m_PerfSramSizeBytesOverride)
                           : ethosn::driver_library::GetFirmwareAndHardwareCapabilities();
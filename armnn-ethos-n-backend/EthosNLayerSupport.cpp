@@ -8,6 +8,7 @@
 #include "EthosNBackend.hpp"
 #include "EthosNConfig.hpp"
 #include "EthosNMapping.hpp"
+#include "EthosNProcessContext.hpp"
 #include "EthosNTensorUtils.hpp"
 #include "InternalTypes.hpp"
 #include "LayerSupportCommon.hpp"
@@ -177,12 +178,11 @@ bool CheckSupportedLevel(ethosn_lib::SupportedLevel level, bool perfOnly)
 }    // anonymous namespace
 
 EthosNLayerSupport::EthosNLayerSupport()
-    : m_Config(GetEthosNConfig())
-    , m_Mappings(GetMappings(m_Config.m_PerfMappingFile))
-    , m_Queries(m_Config.GetCapabilities())
+    : m_Context(GetEthosNProcessContext())
+    , m_Queries(m_Context->GetSupportQueries())
 {
-    g_EthosNConfig   = m_Config;
-    g_EthosNMappings = m_Mappings;
+    g_EthosNConfig   = m_Context->GetConfig();
+    g_EthosNMappings = m_Context->GetMappings();
 }
 
 using namespace ethosntensorutils;
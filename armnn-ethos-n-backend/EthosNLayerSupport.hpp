@@ -6,6 +6,7 @@
 
 #include "EthosNConfig.hpp"
 #include "EthosNMapping.hpp"
+#include "EthosNProcessContext.hpp"
 
 #include <armnn/ILayerSupport.hpp>
 #include <ethosn_support_library/SupportQueries.hpp>
@@ -410,9 +411,8 @@ private:
                                     const std::vector<TensorInfo>& outputs,
                                     Optional<std::string&> reasonIfUnsupported) const;
 
-    EthosNConfig m_Config;
-    EthosNMappings m_Mappings;
-    ethosn::support_library::SupportQueries m_Queries;
+    std::shared_ptr<const EthosNProcessContext> m_Context;
+    const ethosn::support_library::SupportQueries& m_Queries;
 };
 
 }    // namespace armnn
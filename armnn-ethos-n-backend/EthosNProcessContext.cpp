@@ -0,0 +1,151 @@
+//
+// Copyright © 2020 Arm Limited. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#include "EthosNProcessContext.hpp"
+
+#include <ethosn_driver_library/Buffer.hpp>
+
+#include <cstdlib>
+#include <string>
+#if defined(__unix__)
+#include <unistd.h>
+#endif
+
+namespace armnn
+{
+
+namespace
+{
+
+struct ProcessContextCache
+{
+    std::mutex m_Mutex;
+    std::shared_ptr<const EthosNProcessContext> m_Context;
+    /// The value of EthosNConfig::CONFIG_FILE_ENV when m_Context was loaded
+    std::string m_ConfigFile;
+};
+
+ProcessContextCache& GetProcessContextCache()
+{
+    static ProcessContextCache cache;
+    return cache;
+}
+
+// Not setting the environment variable gives the same config as setting it to an empty path, so they are not
+// distinguished
+std::string GetConfigFileEnv()
+{
+    const char* configFile = std::getenv(EthosNConfig::CONFIG_FILE_ENV);
+    return configFile != nullptr ? configFile : "";
+}
+
+/// Must be called with the cache mutex held
+std::shared_ptr<const EthosNProcessContext> LoadProcessContext(ProcessContextCache& cache, std::string configFile)
+{
+    // The mapping file is named in the config, so the config must be read first
+    EthosNConfig config     = GetEthosNConfig();
+    EthosNMappings mappings = GetMappings(config.m_PerfMappingFile);
+
+    // Only update the cache once both files have been read successfully, so a failure leaves it unchanged
+    cache.m_Context    = std::make_shared<const EthosNProcessContext>(std::move(config), std::move(mappings));
+    cache.m_ConfigFile = std::move(configFile);
+    return cache.m_Context;
+}
+
+bool ProbeBufferImport()
+{
+#if defined(__unix__)
+    namespace dl          = ethosn::driver_library;
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    void* memory          = nullptr;
+    if (posix_memalign(&memory, pageSize, pageSize) != 0)
+    {
+        return false;
+    }
+    bool supported = true;
+    try
+    {
+        dl::Buffer buffer(dl::MemorySource::UserPointer, reinterpret_cast<uintptr_t>(memory),
+                          static_cast<uint32_t>(pageSize), dl::DataFormat::NHWC);
+    }
+    catch (const std::exception&)
+    {
+        supported = false;
+    }
+    free(memory);
+    return supported;
+#else
+    return false;
+#endif
+}
+
+}    // namespace
+
+EthosNProcessContext::EthosNProcessContext(EthosNConfig config, EthosNMappings mappings)
+    : m_Config(std::move(config))
+    , m_Mappings(std::move(mappings))
+{}
+
+const EthosNConfig& EthosNProcessContext::GetConfig() const
+{
+    return m_Config;
+}
+
+const EthosNMappings& EthosNProcessContext::GetMappings() const
+{
+    return m_Mappings;
+}
+
+const std::vector<char>& EthosNProcessContext::GetCapabilities() const
+{
+    LoadCapabilities();
+    return m_Capabilities;
+}
+
+const ethosn::support_library::SupportQueries& EthosNProcessContext::GetSupportQueries() const
+{
+    LoadCapabilities();
+    return *m_SupportQueries;
+}
+
+void EthosNProcessContext::LoadCapabilities() const
+{
+    // If the query throws, the flag is left unset and the next call retries it
+    std::call_once(m_CapabilitiesLoaded, [this]() {
+        std::vector<char> capabilities = m_Config.GetCapabilities();
+        m_SupportQueries               = std::make_unique<ethosn::support_library::SupportQueries>(capabilities);
+        m_Capabilities                 = std::move(capabilities);
+    });
+}
+
+bool EthosNProcessContext::IsBufferImportSupported() const
+{
+    // There is no device to import into when only estimating performance
+    std::call_once(m_BufferImportProbed,
+                   [this]() { m_BufferImportSupported = !m_Config.m_PerfOnly && ProbeBufferImport(); });
+    return m_BufferImportSupported;
+}
+
+std::shared_ptr<const EthosNProcessContext> GetEthosNProcessContext()
+{
+    ProcessContextCache& cache = GetProcessContextCache();
+    std::string configFile     = GetConfigFileEnv();
+
+    std::lock_guard<std::mutex> lock(cache.m_Mutex);
+    if (cache.m_Context && cache.m_ConfigFile == configFile)
+    {
+        return cache.m_Context;
+    }
+    return LoadProcessContext(cache, std::move(configFile));
+}
+
+std::shared_ptr<const EthosNProcessContext> ReloadEthosNProcessContext()
+{
+    ProcessContextCache& cache = GetProcessContextCache();
+
+    std::lock_guard<std::mutex> lock(cache.m_Mutex);
+    return LoadProcessContext(cache, GetConfigFileEnv());
+}
+
+}    // namespace armnn
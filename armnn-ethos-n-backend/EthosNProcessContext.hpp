@@ -0,0 +1,66 @@
+//
+// Copyright © 2020 Arm Limited. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#pragma once
+
+#include "EthosNConfig.hpp"
+#include "EthosNMapping.hpp"
+
+#include <ethosn_support_library/SupportQueries.hpp>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace armnn
+{
+
+/// The Ethos-N backend configuration, mappings and capabilities, which are loaded once and then shared by
+/// everything in the backend rather than being read again from their files and the device each time they are needed.
+/// A context never changes once created. A different configuration results in a new context instead.
+class EthosNProcessContext
+{
+public:
+    EthosNProcessContext(EthosNConfig config, EthosNMappings mappings);
+
+    EthosNProcessContext(const EthosNProcessContext&) = delete;
+    EthosNProcessContext& operator=(const EthosNProcessContext&) = delete;
+
+    const EthosNConfig& GetConfig() const;
+    const EthosNMappings& GetMappings() const;
+
+    /// The capabilities are only queried when first needed, so that the device is not opened by code paths
+    /// which only need the config.
+    const std::vector<char>& GetCapabilities() const;
+    const ethosn::support_library::SupportQueries& GetSupportQueries() const;
+
+    /// Whether the driver can wrap memory allocated by the application in a buffer without copying it. This is only
+    /// possible when the NPU is behind an IOMMU, so it is found by trying to import a page of memory the first time
+    /// it is needed.
+    bool IsBufferImportSupported() const;
+
+private:
+    void LoadCapabilities() const;
+
+    const EthosNConfig m_Config;
+    const EthosNMappings m_Mappings;
+
+    mutable std::once_flag m_CapabilitiesLoaded;
+    mutable std::vector<char> m_Capabilities;
+    mutable std::unique_ptr<ethosn::support_library::SupportQueries> m_SupportQueries;
+
+    mutable std::once_flag m_BufferImportProbed;
+    mutable bool m_BufferImportSupported = false;
+};
+
+/// Returns the context for the config file named by the environment variable EthosNConfig::CONFIG_FILE_ENV.
+/// The config and mapping files are read the first time this is called, and again only if the environment variable
+/// has since been changed. Contexts which have already been returned remain valid and unchanged.
+std::shared_ptr<const EthosNProcessContext> GetEthosNProcessContext();
+
+/// Reads the config and mapping files again, so that later calls to GetEthosNProcessContext() see any changes made
+/// to them since they were last read, and returns the new context.
+std::shared_ptr<const EthosNProcessContext> ReloadEthosNProcessContext();
+
+}    // namespace armnn
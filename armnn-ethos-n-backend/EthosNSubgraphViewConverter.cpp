@@ -5,12 +5,15 @@
 
 #include "EthosNSubgraphViewConverter.hpp"
 
+#include "EthosNCompiledNetworkCache.hpp"
 #include "EthosNConfig.hpp"
 #include "EthosNTensorUtils.hpp"
+#include "EthosNThreadPool.hpp"
 #include "LayersFwd.hpp"
 #include "workloads/EthosNPreCompiledWorkload.hpp"
 
 #include <Filesystem.hpp>
+#include <armnn/Exceptions.hpp>
 #include <armnn/Logging.hpp>
 #include <armnn/Optional.hpp>
 #include <armnn/utility/Assert.hpp>
@@ -19,6 +22,8 @@
 #include <ethosn_driver_library/Network.hpp>
 
 #include <algorithm>
+#include <future>
+#include <sstream>
 
 namespace armnn
 {
@@ -30,7 +35,8 @@ uint32_t EthosNSubgraphViewConverter::ms_NextInstanceId = 0;
 EthosNSubgraphViewConverter::EthosNSubgraphViewConverter(const SubgraphView& subgraph)
     : m_InstanceId(ms_NextInstanceId++)
     , m_Subgraph(subgraph)
-    , m_EthosNConfig(GetEthosNConfig())
+    , m_Context(GetEthosNProcessContext())
+    , m_EthosNConfig(m_Context->GetConfig())
 {}
 
 template <typename Layer>
@@ -666,8 +672,8 @@ void EthosNSubgraphViewConverter::CreateUncompiledNetwork()
     }
 
     // Initialize a new network
-    m_Network = m_EthosNConfig.m_PerfOnly ? ethosn_lib::CreateEstimationNetwork(m_EthosNConfig.GetCapabilities())
-                                          : ethosn_lib::CreateNetwork(m_EthosNConfig.GetCapabilities());
+    m_Network = m_EthosNConfig.m_PerfOnly ? ethosn_lib::CreateEstimationNetwork(m_Context->GetCapabilities())
+                                          : ethosn_lib::CreateNetwork(m_Context->GetCapabilities());
 
     // Add inputs
     for (uint32_t inputSlotIdx = 0; inputSlotIdx < m_Subgraph.GetNumInputSlots(); ++inputSlotIdx)
@@ -758,44 +764,152 @@ std::vector<CompiledBlobPtr> EthosNSubgraphViewConverter::CompileNetwork()
     return compiledBlobs;
 }
 
-std::vector<CompiledBlobPtr>
-    EthosNSubgraphViewConverter::Compile(const ethosn_lib::CompilationOptions& ethosnCompilationOpts)
+namespace
 {
-    std::vector<CompiledBlobPtr> compiledBlobs;
 
-    std::vector<EthosNCompiledNetworkPtr> compiledNetworks = ethosn_lib::Compile(*m_Network, ethosnCompilationOpts);
+/// Compiles the network, or returns the result of compiling an identical network from the compiled network cache.
+std::vector<EthosNCompiledNetworkPtr>
+    CompileOrLoadFromCache(const ethosn_lib::Network& network,
+                           const ethosn_lib::CompilationOptions& ethosnCompilationOpts,
+                           const std::string& cacheDir)
+{
+    // The debug files are only written when actually compiling
+    if (ethosnCompilationOpts.m_DebugInfo.m_DumpDebugFiles != ethosn_lib::CompilationOptions::DebugLevel::None)
+    {
+        return ethosn_lib::Compile(network, ethosnCompilationOpts);
+    }
+
+    EthosNCompiledNetworkCache& cache = EthosNCompiledNetworkCache::GetInstance();
+    const std::vector<uint8_t> key    = ethosn_lib::GetCompilationKey(network, ethosnCompilationOpts);
+    std::vector<EthosNCompiledNetworkPtr> compiledNetworks;
+    EthosNCompiledNetworkCache::SerializedNetworks serializedNetworks;
 
-    // Create a list of generic type-agnostic compiled "blobs"
-    for (EthosNCompiledNetworkPtr& compiledNetwork : compiledNetworks)
+    if (cache.Load(key, cacheDir, serializedNetworks))
     {
-        // Map Arm NN input slots to Ethos-N input indices, based on the data we gathered while adding the Ethos-N operations.
-        std::unordered_map<uint32_t, uint32_t> inputSlotsToEthosNInputs;
-        for (uint32_t ethosnInputIdx = 0; ethosnInputIdx < compiledNetwork->GetInputBufferInfos().size();
-             ++ethosnInputIdx)
+        try
         {
-            const ethosn_lib::InputBufferInfo& inputBufferInfo = compiledNetwork->GetInputBufferInfos()[ethosnInputIdx];
-            uint32_t inputSlotIdx                              = m_EthosNInputIdToInputSlot.at(
-                { inputBufferInfo.m_SourceOperationId, inputBufferInfo.m_SourceOperationOutputIndex });
-            inputSlotsToEthosNInputs[inputSlotIdx] = ethosnInputIdx;
+            for (const std::string& serializedNetwork : serializedNetworks)
+            {
+                std::istringstream stream(serializedNetwork);
+                compiledNetworks.push_back(ethosn_lib::DeserializeCompiledNetwork(stream));
+            }
+            // The operation ids in the compiled networks match those of the network, as the ids are assigned in
+            // the order the operations are added, which is part of the key.
+            return compiledNetworks;
         }
-
-        // Map Arm NN output slots to Ethos-N output indices, based on the data we gathered while adding the Ethos-N operations.
-        std::unordered_map<uint32_t, uint32_t> outputSlotsToEthosNOutputs;
-        for (uint32_t ethosnOutputIdx = 0; ethosnOutputIdx < compiledNetwork->GetOutputBufferInfos().size();
-             ++ethosnOutputIdx)
+        catch (const std::exception& e)
         {
-            const ethosn_lib::OutputBufferInfo& outputBufferInfo =
-                compiledNetwork->GetOutputBufferInfos()[ethosnOutputIdx];
-            uint32_t outputSlotIdx = m_EthosNOutputIdToOutputSlot.at(
-                { outputBufferInfo.m_SourceOperationId, outputBufferInfo.m_SourceOperationOutputIndex });
-            outputSlotsToEthosNOutputs[outputSlotIdx] = ethosnOutputIdx;
+            ARMNN_LOG(warning) << "Ignoring invalid compiled network in cache: " << e.what();
+            compiledNetworks.clear();
         }
+    }
+
+    compiledNetworks = ethosn_lib::Compile(network, ethosnCompilationOpts);
+
+    serializedNetworks.clear();
+    for (const EthosNCompiledNetworkPtr& compiledNetwork : compiledNetworks)
+    {
+        std::ostringstream stream;
+        compiledNetwork->Serialize(stream);
+        serializedNetworks.push_back(stream.str());
+    }
+    cache.Store(key, cacheDir, serializedNetworks);
+
+    return compiledNetworks;
+}
+
+/// Creates the data needed by the workload from a compiled network, mapping Arm NN input and output slots to Ethos-N
+/// input and output indices, based on the data we gathered while adding the Ethos-N operations.
+EthosNPreCompiledObject::Network
+    CreatePreCompiledNetwork(EthosNCompiledNetworkPtr compiledNetwork,
+                             const std::map<EthosNInputOutputId, uint32_t>& ethosnInputIdToInputSlot,
+                             const std::map<EthosNInputOutputId, uint32_t>& ethosnOutputIdToOutputSlot)
+{
+    std::unordered_map<uint32_t, uint32_t> inputSlotsToEthosNInputs;
+    for (uint32_t ethosnInputIdx = 0; ethosnInputIdx < compiledNetwork->GetInputBufferInfos().size(); ++ethosnInputIdx)
+    {
+        const ethosn_lib::InputBufferInfo& inputBufferInfo = compiledNetwork->GetInputBufferInfos()[ethosnInputIdx];
+        uint32_t inputSlotIdx                              = ethosnInputIdToInputSlot.at(
+            { inputBufferInfo.m_SourceOperationId, inputBufferInfo.m_SourceOperationOutputIndex });
+        inputSlotsToEthosNInputs[inputSlotIdx] = ethosnInputIdx;
+    }
 
+    std::unordered_map<uint32_t, uint32_t> outputSlotsToEthosNOutputs;
+    for (uint32_t ethosnOutputIdx = 0; ethosnOutputIdx < compiledNetwork->GetOutputBufferInfos().size();
+         ++ethosnOutputIdx)
+    {
+        const ethosn_lib::OutputBufferInfo& outputBufferInfo = compiledNetwork->GetOutputBufferInfos()[ethosnOutputIdx];
+        uint32_t outputSlotIdx                               = ethosnOutputIdToOutputSlot.at(
+            { outputBufferInfo.m_SourceOperationId, outputBufferInfo.m_SourceOperationOutputIndex });
+        outputSlotsToEthosNOutputs[outputSlotIdx] = ethosnOutputIdx;
+    }
+
+    return EthosNPreCompiledObject::Network(std::move(compiledNetwork), std::move(inputSlotsToEthosNInputs),
+                                            std::move(outputSlotsToEthosNOutputs));
+}
+
+/// The worker threads which compile subgraphs in the background, shared by the whole process.
+EthosNThreadPool& GetCompilationThreadPool()
+{
+    // The pool's destructor waits for the queued compilations, which use the compiled network cache, so the cache
+    // must be constructed first in order to be destroyed after the pool
+    EthosNCompiledNetworkCache::GetInstance();
+    static EthosNThreadPool pool(0);
+    return pool;
+}
+
+}    // namespace
+
+std::vector<CompiledBlobPtr>
+    EthosNSubgraphViewConverter::Compile(const ethosn_lib::CompilationOptions& ethosnCompilationOpts)
+{
+    std::vector<CompiledBlobPtr> compiledBlobs;
+
+    if (m_EthosNConfig.m_DeferredCompilation)
+    {
+        // Compile on a worker thread, so that Arm NN carries on converting and compiling other subgraphs meanwhile,
+        // and return straight away. The task takes copies of everything it needs, as neither the converter nor the
+        // Arm NN graph outlive this call. The compiler returns at most one compiled network, so there is one blob,
+        // and the workload waits for it to be compiled when it is created.
+        std::future<EthosNPreCompiledObject::Network> futureNetwork = GetCompilationThreadPool().AddTask(
+            [network = m_Network, ethosnCompilationOpts, cacheDir = m_EthosNConfig.m_CompiledNetworkCacheDir,
+             ethosnInputIdToInputSlot = m_EthosNInputIdToInputSlot,
+             ethosnOutputIdToOutputSlot = m_EthosNOutputIdToOutputSlot]() {
+                std::vector<EthosNCompiledNetworkPtr> compiledNetworks;
+                try
+                {
+                    compiledNetworks = CompileOrLoadFromCache(*network, ethosnCompilationOpts, cacheDir);
+                }
+                catch (const std::exception& e)
+                {
+                    throw RuntimeException(std::string("Failed to compile subgraph for the Ethos-N: ") + e.what());
+                }
+                if (compiledNetworks.empty())
+                {
+                    throw RuntimeException("Failed to compile subgraph for the Ethos-N");
+                }
+                return CreatePreCompiledNetwork(std::move(compiledNetworks[0]), ethosnInputIdToInputSlot,
+                                                ethosnOutputIdToOutputSlot);
+            });
+
+        auto preCompiledObject =
+            std::make_unique<EthosNPreCompiledObject>(std::move(futureNetwork), m_EthosNOperationNameMapping);
+        compiledBlobs.emplace_back(preCompiledObject.release(), DeleteAsType<EthosNPreCompiledObject>);
+
+        return compiledBlobs;
+    }
+
+    std::vector<EthosNCompiledNetworkPtr> compiledNetworks =
+        CompileOrLoadFromCache(*m_Network, ethosnCompilationOpts, m_EthosNConfig.m_CompiledNetworkCacheDir);
+
+    // Create a list of generic type-agnostic compiled "blobs"
+    for (EthosNCompiledNetworkPtr& compiledNetwork : compiledNetworks)
+    {
         // Construct a EthosNPreCompiledObject containing the ethosn_lib::CompiledNetwork along with
         // other data needed by the workload.
         auto preCompiledObject = std::make_unique<EthosNPreCompiledObject>(
-            EthosNPreCompiledObject::Network(std::move(compiledNetwork), inputSlotsToEthosNInputs,
-                                             outputSlotsToEthosNOutputs),
+            CreatePreCompiledNetwork(std::move(compiledNetwork), m_EthosNInputIdToInputSlot,
+                                     m_EthosNOutputIdToOutputSlot),
             m_EthosNOperationNameMapping);
 
         // Convert the EthosNPreCompiledObject into a "blob" (void) object and attach the custom blob deleter
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "EthosNConfig.hpp"
+#include "EthosNProcessContext.hpp"
 #include "ISubgraphViewConverter.hpp"
 #include "SubgraphView.hpp"
 
@@ -133,6 +134,8 @@ private:
     /// (i.e. within m_Subgraph.GetOutputSlots()).
     std::map<EthosNInputOutputId, uint32_t> m_EthosNOutputIdToOutputSlot;
 
+    /// Kept so that the capabilities are available without querying the device again
+    std::shared_ptr<const EthosNProcessContext> m_Context;
     EthosNConfig m_EthosNConfig;
 
     /// Map from Ethos-N operation ID to the corresponding Arm NN layer name.
@@ -4,6 +4,7 @@
 //
 #pragma once
 
+#include "EthosNProcessContext.hpp"
 #include "EthosNTensorUtils.hpp"
 
 #include "armnn/Exceptions.hpp"
@@ -13,17 +14,35 @@
 #include <CompatibleTypes.hpp>
 #include <armnn/utility/Assert.hpp>
 #include <ethosn_driver_library/Buffer.hpp>
+#include <ethosn_driver_library/BufferPool.hpp>
+
+#include <cstdint>
+#include <memory>
+#if defined(__unix__)
+#include <unistd.h>
+#endif
 
 namespace armnn
 {
 
+// Tensor handles are created for every workload, so their buffers are recycled through a pool shared by the whole
+// process rather than allocated from the device each time. The pool keeps at most this much memory in reserve.
+constexpr uint64_t g_EthosNBufferPoolMaxPooledBytes = 64 * 1024 * 1024;
+
+inline ethosn::driver_library::BufferPool& GetEthosNBufferPool()
+{
+    static ethosn::driver_library::BufferPool pool(g_EthosNBufferPoolMaxPooledBytes);
+    return pool;
+}
+
 // Abstract tensor handles wrapping a Ethos-N readable region of memory, interpreting it as tensor data.
 class EthosNTensorHandle : public ITensorHandle
 {
 public:
     explicit EthosNTensorHandle(const TensorInfo& tensorInfo)
         : m_TensorInfo(tensorInfo)
-        , m_Buffer(tensorInfo.GetNumElements(), ethosn::driver_library::DataFormat::NHWC)
+        , m_Buffer(
+              GetEthosNBufferPool().Allocate(tensorInfo.GetNumElements(), ethosn::driver_library::DataFormat::NHWC))
     {
         using namespace ethosntensorutils;
         // NOTE: The Ethos-N API is unclear on whether the size specified for a Buffer is the number of elements, or
@@ -49,9 +68,59 @@ public:
         return nullptr;
     }
 
+    // Inputs and outputs can be read from and written to memory allocated by the application without copying,
+    // if it is malloc memory whose address and size are page-aligned, or a dma-buf, and the driver supports importing
+    // memory. For MemorySource::DmaBuf, memory points to the int file descriptor of the dma-buf.
+    unsigned int GetImportFlags() const override
+    {
+        return static_cast<MemorySourceFlags>(MemorySource::Malloc) |
+               static_cast<MemorySourceFlags>(MemorySource::DmaBuf);
+    }
+
+    bool CanBeImported(void* memory, MemorySource source) override
+    {
+        if (!GetEthosNProcessContext()->IsBufferImportSupported())
+        {
+            return false;
+        }
+        switch (source)
+        {
+            case MemorySource::Malloc:
+                return memory != nullptr && reinterpret_cast<uintptr_t>(memory) % GetPageSize() == 0 &&
+                       m_TensorInfo.GetNumBytes() % GetPageSize() == 0;
+            case MemorySource::DmaBuf:
+                return memory != nullptr;
+            default:
+                return false;
+        }
+    }
+
+    bool Import(void* memory, MemorySource source) override
+    {
+        namespace dl = ethosn::driver_library;
+        if (!CanBeImported(memory, source))
+        {
+            return false;
+        }
+        const bool isDmaBuf = source == MemorySource::DmaBuf;
+        const uint64_t handle =
+            isDmaBuf ? static_cast<uint64_t>(*static_cast<int*>(memory)) : reinterpret_cast<uintptr_t>(memory);
+        try
+        {
+            m_Buffer = std::make_shared<dl::Buffer>(isDmaBuf ? dl::MemorySource::DmaBuf : dl::MemorySource::UserPointer,
+                                                    handle, m_TensorInfo.GetNumBytes(), dl::DataFormat::NHWC);
+        }
+        catch (const std::exception&)
+        {
+            // E.g. the NPU is not behind an IOMMU, so it can only access memory allocated by the kernel module.
+            return false;
+        }
+        return true;
+    }
+
     virtual const void* Map(bool /* blocking = true */) const override
     {
-        return static_cast<const void*>(m_Buffer.GetMappedBuffer());
+        return static_cast<const void*>(m_Buffer->GetMappedBuffer());
     }
 
     virtual void Unmap() const override
@@ -81,18 +150,18 @@ public:
 
     ethosn::driver_library::Buffer& GetBuffer()
     {
-        return m_Buffer;
+        return *m_Buffer;
     }
     ethosn::driver_library::Buffer const& GetBuffer() const
     {
-        return m_Buffer;
+        return *m_Buffer;
     }
 
     template <typename T>
     T* GetTensor() const
     {
         ARMNN_ASSERT(CompatibleTypes<T>(GetTensorInfo().GetDataType()));
-        return reinterpret_cast<T*>(m_Buffer.GetMappedBuffer());
+        return reinterpret_cast<T*>(m_Buffer->GetMappedBuffer());
     }
 
     void CopyOutTo(void* memory) const override
@@ -106,11 +175,21 @@ public:
     }
 
 private:
+    static uintptr_t GetPageSize()
+    {
+#if defined(__unix__)
+        return static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+#else
+        return 4096;
+#endif
+    }
+
     EthosNTensorHandle(const EthosNTensorHandle& other) = delete;
     EthosNTensorHandle& operator=(const EthosNTensorHandle& other) = delete;
 
     TensorInfo m_TensorInfo;
-    mutable ethosn::driver_library::Buffer m_Buffer;
+    /// Taken from the buffer pool, or wrapping imported memory.
+    std::shared_ptr<ethosn::driver_library::Buffer> m_Buffer;
 };
 
 }    // namespace armnn
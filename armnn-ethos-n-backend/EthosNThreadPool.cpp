@@ -0,0 +1,66 @@
+//
+// Copyright © 2020 Arm Limited. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "EthosNThreadPool.hpp"
+
+#include <algorithm>
+
+namespace armnn
+{
+
+EthosNThreadPool::EthosNThreadPool(uint32_t numThreads)
+    : m_Stopping(false)
+{
+    if (numThreads == 0)
+    {
+        // hardware_concurrency() is allowed to return 0 if the value is not known
+        numThreads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    m_Threads.reserve(numThreads);
+    for (uint32_t i = 0; i < numThreads; ++i)
+    {
+        m_Threads.emplace_back(&EthosNThreadPool::WorkerMain, this);
+    }
+}
+
+EthosNThreadPool::~EthosNThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stopping = true;
+    }
+    m_TaskAvailable.notify_all();
+    for (std::thread& t : m_Threads)
+    {
+        t.join();
+    }
+}
+
+uint32_t EthosNThreadPool::GetNumThreads() const
+{
+    return static_cast<uint32_t>(m_Threads.size());
+}
+
+void EthosNThreadPool::WorkerMain()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_TaskAvailable.wait(lock, [this]() { return m_Stopping || !m_Tasks.empty(); });
+            if (m_Tasks.empty())
+            {
+                // Only reached when stopping, as remaining tasks are always run first
+                return;
+            }
+            task = std::move(m_Tasks.front());
+            m_Tasks.pop();
+        }
+        task();
+    }
+}
+
+}    // namespace armnn
@@ -0,0 +1,63 @@
+//
+// Copyright © 2020 Arm Limited. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace armnn
+{
+
+/// A fixed size pool of worker threads which run tasks in the order they are added.
+/// The worker threads are joined when the pool is destroyed, after any queued tasks have run.
+class EthosNThreadPool
+{
+public:
+    /// Creates a pool with the given number of worker threads.
+    /// A value of zero means use as many threads as there are hardware threads available.
+    explicit EthosNThreadPool(uint32_t numThreads);
+    ~EthosNThreadPool();
+
+    EthosNThreadPool(const EthosNThreadPool&) = delete;
+    EthosNThreadPool& operator=(const EthosNThreadPool&) = delete;
+
+    uint32_t GetNumThreads() const;
+
+    /// Queues a task to be run on one of the worker threads.
+    /// The returned future becomes ready once the task has run, and returns its result or rethrows any exception
+    /// thrown by the task.
+    template <typename Task>
+    auto AddTask(Task task) -> std::future<decltype(task())>
+    {
+        using Result = decltype(task());
+        // std::function requires a copyable callable, which std::packaged_task is not
+        auto packagedTask          = std::make_shared<std::packaged_task<Result()>>(std::move(task));
+        std::future<Result> result = packagedTask->get_future();
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Tasks.push([packagedTask]() { (*packagedTask)(); });
+        }
+        m_TaskAvailable.notify_one();
+        return result;
+    }
+
+private:
+    void WorkerMain();
+
+    std::vector<std::thread> m_Threads;
+    std::queue<std::function<void()>> m_Tasks;
+    std::mutex m_Mutex;
+    std::condition_variable m_TaskAvailable;
+    bool m_Stopping;
+};
+
+}    // namespace armnn
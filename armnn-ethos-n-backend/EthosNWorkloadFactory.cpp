@@ -6,6 +6,7 @@
 #include "EthosNWorkloadFactory.hpp"
 
 #include "EthosNBackendId.hpp"
+#include "EthosNProcessContext.hpp"
 #include "EthosNTensorHandle.hpp"
 #include "EthosNWorkloads.hpp"
 
@@ -54,8 +55,7 @@ std::unique_ptr<ITensorHandle>
     {
         return nullptr;
     }
-    auto ethosnConfig = GetEthosNConfig();
-    if (ethosnConfig.m_PerfOnly)
+    if (GetEthosNProcessContext()->GetConfig().m_PerfOnly)
     {
         return std::make_unique<ScopedCpuTensorHandle>(tensorInfo);
     }
@@ -0,0 +1,77 @@
+//
+// Copyright © 2020 Arm Limited. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "EthosNTestUtils.hpp"
+
+#include <EthosNCompiledNetworkCache.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(EthosNCompiledNetworkCache)
+
+BOOST_AUTO_TEST_CASE(LoadFromMemory)
+{
+    armnn::EthosNCompiledNetworkCache cache(1024);
+    const std::vector<uint8_t> key = { 1, 2, 3 };
+    armnn::EthosNCompiledNetworkCache::SerializedNetworks networks;
+
+    BOOST_CHECK(!cache.Load(key, "", networks));
+
+    cache.Store(key, "", { "network0", "network1" });
+    BOOST_CHECK(cache.Load(key, "", networks));
+    BOOST_CHECK(networks == armnn::EthosNCompiledNetworkCache::SerializedNetworks({ "network0", "network1" }));
+
+    BOOST_CHECK(!cache.Load({ 1, 2, 4 }, "", networks));
+}
+
+BOOST_AUTO_TEST_CASE(LoadFromDisk)
+{
+    const testing_utils::TempDir tmpDir;
+    const std::vector<uint8_t> key = { 1, 2, 3 };
+    armnn::EthosNCompiledNetworkCache::SerializedNetworks networks;
+
+    {
+        armnn::EthosNCompiledNetworkCache cache(1024);
+        cache.Store(key, tmpDir.Str(), { "network0", "" });
+    }
+
+    // A new cache, as in a later process, which has nothing in memory
+    armnn::EthosNCompiledNetworkCache cache(1024);
+    BOOST_CHECK(!cache.Load(key, "", networks));
+    BOOST_CHECK(!cache.Load({ 1, 2 }, tmpDir.Str(), networks));
+    BOOST_CHECK(cache.Load(key, tmpDir.Str(), networks));
+    BOOST_CHECK(networks == armnn::EthosNCompiledNetworkCache::SerializedNetworks({ "network0", "" }));
+
+    // The entry is now also in memory
+    networks.clear();
+    BOOST_CHECK(cache.Load(key, "", networks));
+    BOOST_CHECK(networks == armnn::EthosNCompiledNetworkCache::SerializedNetworks({ "network0", "" }));
+}
+
+BOOST_AUTO_TEST_CASE(EvictLeastRecentlyUsed)
+{
+    // Room for two entries of 3 + 7 bytes
+    armnn::EthosNCompiledNetworkCache cache(25);
+    armnn::EthosNCompiledNetworkCache::SerializedNetworks networks;
+
+    cache.Store({ 1, 1, 1 }, "", { "network" });
+    cache.Store({ 2, 2, 2 }, "", { "network" });
+    BOOST_CHECK(cache.GetMemoryBytes() == 20);
+
+    // Use the first entry so that the second is evicted
+    BOOST_CHECK(cache.Load({ 1, 1, 1 }, "", networks));
+    cache.Store({ 3, 3, 3 }, "", { "network" });
+    BOOST_CHECK(cache.GetMemoryBytes() == 20);
+    BOOST_CHECK(cache.Load({ 1, 1, 1 }, "", networks));
+    BOOST_CHECK(!cache.Load({ 2, 2, 2 }, "", networks));
+    BOOST_CHECK(cache.Load({ 3, 3, 3 }, "", networks));
+
+    // Entries larger than the cache are not kept
+    cache.Store({ 4 }, "", { std::string(30, 'x') });
+    BOOST_CHECK(!cache.Load({ 4 }, "", networks));
+    BOOST_CHECK(cache.GetMemoryBytes() == 20);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
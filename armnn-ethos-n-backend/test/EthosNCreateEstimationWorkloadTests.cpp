@@ -38,6 +38,8 @@ BOOST_AUTO_TEST_CASE(ParseEthosNConfig)
         os << armnn::EthosNConfig::PERF_CURRENT << " = 0\n";
         os << armnn::EthosNConfig::COMPILER_ALGORITHM << " = Auto\n";
         os << armnn::EthosNConfig::INTERMEDIATE_COMPRESSION << " = 1\n";
+        os << armnn::EthosNConfig::COMPILED_NETWORK_CACHE_DIR << " = cache\n";
+        os << armnn::EthosNConfig::DEFERRED_COMPILATION << " = 1\n";
     }
     SetEnv(armnn::EthosNConfig::CONFIG_FILE_ENV, configFile.c_str());
 
@@ -53,6 +55,8 @@ BOOST_AUTO_TEST_CASE(ParseEthosNConfig)
     BOOST_CHECK(config.m_PerfCurrent == false);
     BOOST_CHECK(config.m_CompilerAlgorithm == ethosn::support_library::CompilerAlgorithm::Auto);
     BOOST_CHECK(config.m_IntermediateCompression == true);
+    BOOST_CHECK(config.m_CompiledNetworkCacheDir == "cache");
+    BOOST_CHECK(config.m_DeferredCompilation == true);
 }
 
 BOOST_AUTO_TEST_CASE(ParseEthosNConfigCascadingOk)
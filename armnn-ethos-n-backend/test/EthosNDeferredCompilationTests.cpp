@@ -0,0 +1,152 @@
+//
+// Copyright © 2020 Arm Limited. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "EthosNTestUtils.hpp"
+
+#include <EthosNSubgraphViewConverter.hpp>
+#include <EthosNThreadPool.hpp>
+#include <Graph.hpp>
+#include <armnn/Exceptions.hpp>
+#include <backendsCommon/test/CommonTestUtils.hpp>
+#include <workloads/EthosNPreCompiledWorkload.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+
+armnn::SubgraphView::SubgraphViewPtr BuildReluSubgraph(armnn::Graph& graph, unsigned int numChannels)
+{
+    using namespace armnn;
+
+    const TensorInfo tensorInfo({ 1, 16, 16, numChannels }, DataType::QAsymmU8, 1.0f, 0);
+
+    Layer* const inputLayer = graph.AddLayer<InputLayer>(0, "input");
+    inputLayer->GetOutputSlot(0).SetTensorInfo(tensorInfo);
+    Layer* const outputLayer = graph.AddLayer<OutputLayer>(0, "output");
+
+    ActivationDescriptor reluDescriptor;
+    reluDescriptor.m_Function        = ActivationFunction::BoundedReLu;
+    reluDescriptor.m_A               = 6.0f;
+    reluDescriptor.m_B               = 0.0f;
+    ActivationLayer* const reluLayer = graph.AddLayer<ActivationLayer>(reluDescriptor, "relu");
+    reluLayer->GetOutputSlot(0).SetTensorInfo(tensorInfo);
+
+    inputLayer->GetOutputSlot(0).Connect(reluLayer->GetInputSlot(0));
+    reluLayer->GetOutputSlot(0).Connect(outputLayer->GetInputSlot(0));
+
+    return CreateSubgraphViewFrom(CreateInputsFrom({ reluLayer }), CreateOutputsFrom({ reluLayer }), { reluLayer });
+}
+
+}    // namespace
+
+BOOST_AUTO_TEST_SUITE(EthosNDeferredCompilation)
+
+BOOST_AUTO_TEST_CASE(ThreadPoolRunsTasks)
+{
+    armnn::EthosNThreadPool pool(4);
+    BOOST_TEST(pool.GetNumThreads() == 4);
+
+    std::atomic<int> sum(0);
+    std::vector<std::future<int>> results;
+    for (int i = 0; i < 100; ++i)
+    {
+        results.push_back(pool.AddTask([i, &sum]() {
+            sum += i;
+            return i * 2;
+        }));
+    }
+    for (int i = 0; i < 100; ++i)
+    {
+        BOOST_TEST(results[i].get() == i * 2);
+    }
+    BOOST_TEST(sum == 4950);
+}
+
+BOOST_AUTO_TEST_CASE(ThreadPoolRethrows)
+{
+    armnn::EthosNThreadPool pool(0);
+    BOOST_TEST(pool.GetNumThreads() > 0);
+
+    std::future<void> result = pool.AddTask([]() { throw std::runtime_error("task failed"); });
+    BOOST_CHECK_THROW(result.get(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(PreCompiledObjectWaitsForNetwork)
+{
+    using Network = armnn::EthosNPreCompiledObject::Network;
+
+    std::promise<Network> promise;
+    armnn::EthosNPreCompiledObject object(promise.get_future(), {});
+    BOOST_TEST(!object.IsPerfEstimationOnly());
+
+    std::thread compileThread([&promise]() { promise.set_value(Network(nullptr, { { 0, 1 } }, { { 1, 0 } })); });
+
+    // Waits for the network to be set
+    const Network* network = object.GetNetwork();
+    compileThread.join();
+    BOOST_TEST(network->m_InputSlotsToEthosNInputs.at(0) == 1);
+    BOOST_TEST(network->m_OutputSlotsToEthosNOutputs.at(1) == 0);
+}
+
+BOOST_AUTO_TEST_CASE(PreCompiledObjectRethrowsCompilationFailure)
+{
+    using Network = armnn::EthosNPreCompiledObject::Network;
+
+    std::promise<Network> promise;
+    armnn::EthosNPreCompiledObject object(promise.get_future(), {});
+    promise.set_exception(std::make_exception_ptr(armnn::RuntimeException("Failed to compile")));
+
+    BOOST_CHECK_THROW(object.GetNetwork(), armnn::RuntimeException);
+}
+
+// Several subgraphs are compiled at once on the worker threads, and each workload gets its own compiled network
+BOOST_AUTO_TEST_CASE(CompileSubgraphsInParallel)
+{
+    using namespace testing_utils;
+
+    const TempDir tmpDir;
+    const std::string configFile = tmpDir.Str() + "/config.txt";
+    {
+        armnn::EthosNConfig config;
+        config.m_DeferredCompilation = true;
+        std::ofstream os(configFile);
+        os << config;
+    }
+    SetEnv(armnn::EthosNConfig::CONFIG_FILE_ENV, configFile.c_str());
+
+    // Each subgraph is different, so that none is loaded from the compiled network cache instead of being compiled
+    constexpr unsigned int numSubgraphs = 8;
+    std::vector<armnn::Graph> graphs(numSubgraphs);
+    std::vector<armnn::SubgraphView::SubgraphViewPtr> subgraphs;
+    std::vector<armnn::CompiledBlobPtr> compiledBlobs;
+    for (unsigned int i = 0; i < numSubgraphs; ++i)
+    {
+        subgraphs.push_back(BuildReluSubgraph(graphs[i], 16 * (i + 1)));
+        armnn::EthosNSubgraphViewConverter converter(*subgraphs.back());
+        std::vector<armnn::CompiledBlobPtr> blobs = converter.CompileNetwork();
+        BOOST_REQUIRE(blobs.size() == 1);
+        compiledBlobs.push_back(std::move(blobs[0]));
+    }
+
+    for (unsigned int i = 0; i < numSubgraphs; ++i)
+    {
+        auto preCompiledObject = static_cast<const armnn::EthosNPreCompiledObject*>(compiledBlobs[i].get());
+        const auto network     = preCompiledObject->GetNetwork();
+        BOOST_REQUIRE(network != nullptr);
+        BOOST_TEST(network->m_CompiledNetwork != nullptr);
+        BOOST_TEST(network->m_InputSlotsToEthosNInputs.size() == 1);
+        BOOST_TEST(network->m_OutputSlotsToEthosNOutputs.size() == 1);
+    }
+
+    // Later tests which do not set a config file should not compile in the background
+    SetEnv(armnn::EthosNConfig::CONFIG_FILE_ENV, "");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -54,6 +54,8 @@ ARMNN_AUTO_TEST_CASE(PreCompiledAddition, PreCompiledAdditionTest)
 ARMNN_AUTO_TEST_CASE(PreCompiledMultiInput, PreCompiledMultiInputTest)
 ARMNN_AUTO_TEST_CASE(PreCompiledMultiOutput, PreCompiledMultiOutputTest)
 
+ARMNN_AUTO_TEST_CASE(PreCompiledAsyncInferences, PreCompiledAsyncInferencesTest)
+
 ARMNN_AUTO_TEST_CASE(PreCompiled1dTensor, PreCompiled1dTensorTest)
 ARMNN_AUTO_TEST_CASE(PreCompiled2dTensor, PreCompiled2dTensorTest)
 ARMNN_AUTO_TEST_CASE(PreCompiled3dTensor, PreCompiled3dTensorTest)
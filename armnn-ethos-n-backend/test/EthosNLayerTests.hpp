@@ -141,6 +141,13 @@ std::vector<LayerTestResult<uint8_t, 4>>
     return PreCompiledMultiOutputTestImpl(workloadFactory, memoryManager);
 }
 
+std::vector<LayerTestResult<uint8_t, 4>>
+    PreCompiledAsyncInferencesTest(armnn::IWorkloadFactory& workloadFactory,
+                                   const armnn::IBackendInternal::IMemoryManagerSharedPtr& memoryManager)
+{
+    return PreCompiledAsyncInferencesTestImpl(workloadFactory, memoryManager);
+}
+
 LayerTestResult<uint8_t, 1>
     PreCompiled1dTensorTest(armnn::IWorkloadFactory& workloadFactory,
                             const armnn::IBackendInternal::IMemoryManagerSharedPtr& memoryManager)
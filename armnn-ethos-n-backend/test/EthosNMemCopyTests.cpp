@@ -5,6 +5,7 @@
 
 #include "EthosNWorkloadFactoryHelper.hpp"
 
+#include <EthosNTensorHandle.hpp>
 #include <EthosNWorkloadFactory.hpp>
 #include <aclCommon/test/MemCopyTestImpl.hpp>
 #include <boost/test/unit_test.hpp>
@@ -42,4 +43,24 @@ BOOST_AUTO_TEST_CASE(CopyBetweenEthosNAndCpuWithSubtensors)
     BOOST_TEST(CompareTensors(result.output, result.outputExpected));
 }
 
+BOOST_AUTO_TEST_CASE(ImportFlagsAndAlignment)
+{
+    using namespace armnn;
+    const TensorInfo tensorInfo({ 1, 16, 16, 16 }, DataType::QAsymmU8);
+    EthosNTensorHandle handle(tensorInfo);
+
+    BOOST_TEST((handle.GetImportFlags() & static_cast<MemorySourceFlags>(MemorySource::Malloc)) != 0);
+    BOOST_TEST((handle.GetImportFlags() & static_cast<MemorySourceFlags>(MemorySource::DmaBuf)) != 0);
+
+    // Only page-aligned malloc memory can be imported. 64 KiB is a multiple of every page size in use.
+    const uintptr_t alignment = 65536;
+    std::vector<uint8_t> memory(2 * alignment);
+    uint8_t* aligned =
+        reinterpret_cast<uint8_t*>((reinterpret_cast<uintptr_t>(memory.data()) + alignment - 1) & ~(alignment - 1));
+    BOOST_TEST(handle.CanBeImported(aligned, MemorySource::Malloc));
+    BOOST_TEST(!handle.CanBeImported(aligned + 1, MemorySource::Malloc));
+    BOOST_TEST(!handle.CanBeImported(nullptr, MemorySource::Malloc));
+    BOOST_TEST(!handle.CanBeImported(aligned, MemorySource::Undefined));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,95 @@
+//
+// Copyright © 2020 Arm Limited. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "EthosNTestUtils.hpp"
+
+#include <EthosNProcessContext.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+
+BOOST_AUTO_TEST_SUITE(EthosNProcessContext)
+
+namespace
+{
+
+void WriteConfigFile(const std::string& configFile, ethosn::support_library::EthosNVariant variant)
+{
+    armnn::EthosNConfig config;
+    config.m_PerfOnly    = true;
+    config.m_PerfVariant = variant;
+    std::ofstream os(configFile);
+    os << config;
+}
+
+}    // namespace
+
+BOOST_AUTO_TEST_CASE(ContextIsSharedUntilReloaded)
+{
+    using namespace testing_utils;
+    using ethosn::support_library::EthosNVariant;
+
+    const TempDir tmpDir;
+    const std::string configFile = tmpDir.Str() + "/config.txt";
+    WriteConfigFile(configFile, EthosNVariant::ETHOS_N57);
+    SetEnv(armnn::EthosNConfig::CONFIG_FILE_ENV, configFile.c_str());
+
+    std::shared_ptr<const armnn::EthosNProcessContext> context = armnn::GetEthosNProcessContext();
+    BOOST_TEST(context->GetConfig().m_PerfOnly);
+    BOOST_TEST((context->GetConfig().m_PerfVariant == EthosNVariant::ETHOS_N57));
+    BOOST_TEST(context->GetMappings().empty());
+    BOOST_TEST(!context->GetCapabilities().empty());
+    BOOST_TEST(&context->GetCapabilities() == &context->GetCapabilities());
+    BOOST_TEST(armnn::GetEthosNProcessContext() == context);
+
+    // Changes to the file are not seen until it is explicitly reloaded
+    WriteConfigFile(configFile, EthosNVariant::ETHOS_N37);
+    BOOST_TEST(armnn::GetEthosNProcessContext() == context);
+
+    std::shared_ptr<const armnn::EthosNProcessContext> reloaded = armnn::ReloadEthosNProcessContext();
+    BOOST_TEST(reloaded != context);
+    BOOST_TEST((reloaded->GetConfig().m_PerfVariant == EthosNVariant::ETHOS_N37));
+    BOOST_TEST(armnn::GetEthosNProcessContext() == reloaded);
+
+    // The previous context is left as it was
+    BOOST_TEST((context->GetConfig().m_PerfVariant == EthosNVariant::ETHOS_N57));
+}
+
+BOOST_AUTO_TEST_CASE(ContextIsReloadedForNewConfigFile)
+{
+    using namespace testing_utils;
+    using ethosn::support_library::EthosNVariant;
+
+    const TempDir tmpDir;
+    const std::string configFile1 = tmpDir.Str() + "/config1.txt";
+    const std::string configFile2 = tmpDir.Str() + "/config2.txt";
+    WriteConfigFile(configFile1, EthosNVariant::ETHOS_N57);
+    WriteConfigFile(configFile2, EthosNVariant::ETHOS_N37);
+
+    SetEnv(armnn::EthosNConfig::CONFIG_FILE_ENV, configFile1.c_str());
+    std::shared_ptr<const armnn::EthosNProcessContext> context1 = armnn::GetEthosNProcessContext();
+    BOOST_TEST((context1->GetConfig().m_PerfVariant == EthosNVariant::ETHOS_N57));
+
+    SetEnv(armnn::EthosNConfig::CONFIG_FILE_ENV, configFile2.c_str());
+    std::shared_ptr<const armnn::EthosNProcessContext> context2 = armnn::GetEthosNProcessContext();
+    BOOST_TEST((context2->GetConfig().m_PerfVariant == EthosNVariant::ETHOS_N37));
+}
+
+BOOST_AUTO_TEST_CASE(BufferImportIsNotSupportedWhenOnlyEstimatingPerformance)
+{
+    using namespace testing_utils;
+
+    const TempDir tmpDir;
+    const std::string configFile = tmpDir.Str() + "/config.txt";
+    WriteConfigFile(configFile, ethosn::support_library::EthosNVariant::ETHOS_N57);
+    SetEnv(armnn::EthosNConfig::CONFIG_FILE_ENV, configFile.c_str());
+
+    std::shared_ptr<const armnn::EthosNProcessContext> context = armnn::ReloadEthosNProcessContext();
+    BOOST_TEST(!context->IsBufferImportSupported());
+    BOOST_TEST(!context->IsBufferImportSupported());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -16,6 +16,7 @@
 #include <backendsCommon/WorkloadFactory.hpp>
 #include <backendsCommon/test/TensorCopyUtils.hpp>
 #include <test/TensorHelpers.hpp>
+#include <workloads/EthosNPreCompiledWorkload.hpp>
 
 #include <algorithm>
 
@@ -1288,3 +1289,83 @@ LayerTestResult<uint8_t, 3> PreCompiled3dTensorTestImpl(armnn::IWorkloadFactory&
 
     return OptimiseAndRunNetwork<3>(workloadFactory, net, inputInfo, inputData, reshapeInfo, expectedOutputData);
 }
+
+/// Checks that two inferences of the same workload can be in flight at once, each on its own tensor handles.
+std::vector<LayerTestResult<uint8_t, 4>>
+    PreCompiledAsyncInferencesTestImpl(armnn::IWorkloadFactory& workloadFactory,
+                                       const armnn::IBackendInternal::IMemoryManagerSharedPtr&)
+{
+    const TensorInfo tensorInfo({ 1, 16, 16, 1 }, DataType::QAsymmU8, 1.0f, 0);
+
+    // Construct network
+    Network net;
+    IConnectableLayer* const inputLayer = net.AddInputLayer(0, "input");
+    inputLayer->GetOutputSlot(0).SetTensorInfo(tensorInfo);
+
+    ActivationDescriptor reluDesc;
+    reluDesc.m_Function                = ActivationFunction::BoundedReLu;
+    reluDesc.m_A                       = 255.0f;
+    reluDesc.m_B                       = 0.0f;
+    IConnectableLayer* const reluLayer = net.AddActivationLayer(reluDesc, "relu");
+    reluLayer->GetOutputSlot(0).SetTensorInfo(tensorInfo);
+    inputLayer->GetOutputSlot(0).Connect(reluLayer->GetInputSlot(0));
+
+    IConnectableLayer* const outputLayer = net.AddOutputLayer(0, "output");
+    reluLayer->GetOutputSlot(0).Connect(outputLayer->GetInputSlot(0));
+
+    // Different input data for each inference, so that swapped outputs are detected
+    std::vector<std::vector<uint8_t>> inputData(2, std::vector<uint8_t>(tensorInfo.GetNumElements()));
+    std::iota(inputData[0].begin(), inputData[0].end(), 0);
+    std::iota(inputData[1].rbegin(), inputData[1].rend(), 0);
+
+    // Optimize the network for the backend supported by the factory
+    std::vector<BackendId> backends = { workloadFactory.GetBackendId() };
+    IRuntimePtr runtime(IRuntime::Create(IRuntime::CreationOptions()));
+    IOptimizedNetworkPtr optimizedNet = Optimize(net, backends, runtime->GetDeviceSpec());
+
+    Graph& optimisedGraph              = static_cast<OptimizedNetwork*>(optimizedNet.get())->GetGraph();
+    PreCompiledLayer* preCompiledLayer = FindPreCompiledLayer(optimisedGraph);
+    if (!preCompiledLayer)
+    {
+        throw RuntimeException("Could not find pre-compiled layer in optimised graph", CHECK_LOCATION());
+    }
+
+    TensorHandleFactoryRegistry tmpRegistry;
+    for (auto&& layer : optimisedGraph.TopologicalSort())
+    {
+        layer->CreateTensorHandles(tmpRegistry, workloadFactory);
+    }
+    std::unique_ptr<IWorkload> workload = preCompiledLayer->CreateWorkload(workloadFactory);
+    const EthosNPreCompiledWorkload& preCompiledWorkload =
+        *PolymorphicPointerDowncast<EthosNPreCompiledWorkload>(workload.get());
+
+    // The first inference uses the workload's own tensor handles and the second uses new ones
+    const QueueDescriptor& workloadData = preCompiledWorkload.GetData();
+    std::unique_ptr<ITensorHandle> secondInput  = workloadFactory.CreateTensorHandle(tensorInfo);
+    std::unique_ptr<ITensorHandle> secondOutput = workloadFactory.CreateTensorHandle(tensorInfo);
+    const std::vector<std::vector<ITensorHandle*>> inputs  = { workloadData.m_Inputs, { secondInput.get() } };
+    const std::vector<std::vector<ITensorHandle*>> outputs = { workloadData.m_Outputs, { secondOutput.get() } };
+
+    // Schedule both inferences before waiting for either
+    std::vector<std::unique_ptr<ethosn::driver_library::Inference>> inferences;
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        CopyDataToITensorHandle(inputs[i][0], inputData[i].data());
+        inferences.push_back(preCompiledWorkload.ScheduleAsync(inputs[i], outputs[i]));
+    }
+    for (const std::unique_ptr<ethosn::driver_library::Inference>& inference : inferences)
+    {
+        preCompiledWorkload.Wait(*inference);
+    }
+
+    // The relu leaves every input value unchanged
+    std::vector<LayerTestResult<uint8_t, 4>> results;
+    for (size_t i = 0; i < outputs.size(); ++i)
+    {
+        LayerTestResult<uint8_t, 4> result(tensorInfo);
+        result.outputExpected = MakeTensor<uint8_t, 4>(tensorInfo, inputData[i]);
+        CopyDataFromITensorHandle(result.output.data(), outputs[i][0]);
+        results.push_back(result);
+    }
+    return results;
+}
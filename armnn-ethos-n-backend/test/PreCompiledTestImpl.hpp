@@ -75,6 +75,10 @@ std::vector<LayerTestResult<uint8_t, 4>>
     PreCompiledMultiOutputTestImpl(armnn::IWorkloadFactory& workloadFactory,
                                    const armnn::IBackendInternal::IMemoryManagerSharedPtr& memoryManager);
 
+std::vector<LayerTestResult<uint8_t, 4>>
+    PreCompiledAsyncInferencesTestImpl(armnn::IWorkloadFactory& workloadFactory,
+                                       const armnn::IBackendInternal::IMemoryManagerSharedPtr& memoryManager);
+
 LayerTestResult<uint8_t, 1>
     PreCompiled1dTensorTestImpl(armnn::IWorkloadFactory& workloadFactory,
                                 const armnn::IBackendInternal::IMemoryManagerSharedPtr& memoryManager);
@@ -215,37 +215,26 @@ void SendProfilingEvents()
     }
 }
 
-}    // anonymous namespace
-
-void EthosNPreCompiledWorkload::Init(const PreCompiledDescriptor& descriptor,
-                                     const EthosNPreCompiledObject::Network& network)
+/// Gets the buffers of the given tensor handles, remapping the indices from the Arm NN slots order to the Ethos-N
+/// inputs or outputs order.
+/// The buffers are looked up for every inference, as importing memory into a tensor handle replaces its buffer.
+std::vector<ethosn::driver_library::Buffer*>
+    GetEthosNBuffers(const std::vector<ITensorHandle*>& tensorHandles,
+                     const std::unordered_map<uint32_t, uint32_t>& slotsToEthosNIndices)
 {
-    // Set up the buffers in the PreCompiledLayer::CreateWorkload() method, pass them in PreCompiledQueueDescriptor
-    unsigned int numInputBuffers = descriptor.m_NumInputSlots;
-    m_InputBuffers.resize(numInputBuffers);
-
-    // Fill m_InputBuffers from the input tensor handles, taking care to remap the indices from
-    // the Arm NN input slots order to the Ethos-N  inputs order.
-    for (unsigned int inputSlotIdx = 0; inputSlotIdx < numInputBuffers; ++inputSlotIdx)
+    std::vector<ethosn::driver_library::Buffer*> buffers(tensorHandles.size());
+    for (uint32_t slotIdx = 0; slotIdx < tensorHandles.size(); ++slotIdx)
     {
-        uint32_t ethosnInputIdx = network.m_InputSlotsToEthosNInputs.at(inputSlotIdx);
-        m_InputBuffers[ethosnInputIdx] =
-            &(static_cast<EthosNTensorHandle*>(m_Data.m_Inputs[inputSlotIdx])->GetBuffer());
+        uint32_t ethosnIdx = slotsToEthosNIndices.at(slotIdx);
+        buffers.at(ethosnIdx) = &(static_cast<EthosNTensorHandle*>(tensorHandles[slotIdx])->GetBuffer());
     }
+    return buffers;
+}
 
-    // Set up the buffers in the PreCompiledLayer::CreateWorkload() method, pass them in PreCompiledQueueDescriptor
-    unsigned int numOutputBuffers = descriptor.m_NumOutputSlots;
-    m_OutputBuffers.resize(numOutputBuffers);
-
-    // Fill m_OutputBuffers from the output tensor handles, taking care to remap the indices from
-    // the Arm NN output slots order to the Ethos-N outputs order.
-    for (unsigned int outputSlotIdx = 0; outputSlotIdx < numOutputBuffers; ++outputSlotIdx)
-    {
-        uint32_t ethosnOutputIdx = network.m_OutputSlotsToEthosNOutputs.at(outputSlotIdx);
-        m_OutputBuffers[ethosnOutputIdx] =
-            &(static_cast<EthosNTensorHandle*>(m_Data.m_Outputs[outputSlotIdx])->GetBuffer());
-    }
+}    // anonymous namespace
 
+void EthosNPreCompiledWorkload::Init(const EthosNPreCompiledObject::Network& network)
+{
     m_Network = std::make_unique<ethosn::driver_library::Network>(
         const_cast<ethosn::support_library::CompiledNetwork&>(*network.m_CompiledNetwork));
     m_Network->SetDebugName(std::to_string(m_Guid).c_str());
@@ -264,7 +253,12 @@ EthosNPreCompiledWorkload::EthosNPreCompiledWorkload(const PreCompiledQueueDescr
 
     if (!m_PreCompiledObject->IsPerfEstimationOnly())
     {
-        Init(descriptor.m_Parameters, *m_PreCompiledObject->GetNetwork());
+        if (m_Data.m_Inputs.size() != descriptor.m_Parameters.m_NumInputSlots ||
+            m_Data.m_Outputs.size() != descriptor.m_Parameters.m_NumOutputSlots)
+        {
+            throw InvalidArgumentException("EthosNPreCompiledWorkload has the wrong number of inputs or outputs");
+        }
+        Init(*m_PreCompiledObject->GetNetwork());
     }
 }
 
@@ -278,28 +272,54 @@ void EthosNPreCompiledWorkload::Execute() const
     }
     else
     {
-        uint32_t numInputBuffers  = static_cast<uint32_t>(m_InputBuffers.size());
-        uint32_t numOutputBuffers = static_cast<uint32_t>(m_OutputBuffers.size());
+        const std::unique_ptr<ethosn::driver_library::Inference> inference =
+            ScheduleAsync(m_Data.m_Inputs, m_Data.m_Outputs);
 
-        const std::unique_ptr<ethosn::driver_library::Inference> inference(m_Network->ScheduleInference(
-            m_InputBuffers.data(), numInputBuffers, m_OutputBuffers.data(), numOutputBuffers));
+        Wait(*inference);
+    }
+}
 
-        WaitStatus result = WaitForInference(inference->GetFileDescriptor(), 60);
+std::unique_ptr<ethosn::driver_library::Inference>
+    EthosNPreCompiledWorkload::ScheduleAsync(const std::vector<ITensorHandle*>& inputs,
+                                             const std::vector<ITensorHandle*>& outputs) const
+{
+    if (m_PreCompiledObject->IsPerfEstimationOnly())
+    {
+        throw RuntimeException("Inferences cannot be scheduled in performance estimation mode");
+    }
+    if (inputs.size() != m_Data.m_Inputs.size() || outputs.size() != m_Data.m_Outputs.size())
+    {
+        throw InvalidArgumentException("Wrong number of tensor handles for the inputs or outputs of the workload");
+    }
 
-        if (EthosNBackendProfilingService::Instance().IsProfilingEnabled())
-        {
-            SendProfilingEvents();
-        }
-        switch (result.GetErrorCode())
-        {
-            case WaitErrorCode::Success:
-                break;
-            case WaitErrorCode::Timeout:
-            case WaitErrorCode::Error:
-            default:
-                throw RuntimeException("An error has occurred waiting for the inference of a pre-compiled object: " +
-                                       result.GetErrorDescription());
-        }
+    const EthosNPreCompiledObject::Network& network = *m_PreCompiledObject->GetNetwork();
+    std::vector<ethosn::driver_library::Buffer*> inputBuffers =
+        GetEthosNBuffers(inputs, network.m_InputSlotsToEthosNInputs);
+    std::vector<ethosn::driver_library::Buffer*> outputBuffers =
+        GetEthosNBuffers(outputs, network.m_OutputSlotsToEthosNOutputs);
+
+    return std::unique_ptr<ethosn::driver_library::Inference>(
+        m_Network->ScheduleInference(inputBuffers.data(), static_cast<uint32_t>(inputBuffers.size()),
+                                     outputBuffers.data(), static_cast<uint32_t>(outputBuffers.size())));
+}
+
+void EthosNPreCompiledWorkload::Wait(ethosn::driver_library::Inference& inference) const
+{
+    WaitStatus result = WaitForInference(inference.GetFileDescriptor(), 60);
+
+    if (EthosNBackendProfilingService::Instance().IsProfilingEnabled())
+    {
+        SendProfilingEvents();
+    }
+    switch (result.GetErrorCode())
+    {
+        case WaitErrorCode::Success:
+            break;
+        case WaitErrorCode::Timeout:
+        case WaitErrorCode::Error:
+        default:
+            throw RuntimeException("An error has occurred waiting for the inference of a pre-compiled object: " +
+                                   result.GetErrorDescription());
     }
 }
 
@@ -15,6 +15,7 @@
 #include <ethosn_driver_library/Network.hpp>
 #include <ethosn_support_library/Support.hpp>
 
+#include <future>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -63,6 +64,11 @@ public:
     };
 
     EthosNPreCompiledObject(Network network, std::map<uint32_t, std::string> ethosnOperationNameMapping)
+        : EthosNPreCompiledObject(MakeReadyFuture(std::move(network)), std::move(ethosnOperationNameMapping))
+    {}
+
+    /// For a network which is still being compiled in the background, that becomes ready once it has been compiled.
+    EthosNPreCompiledObject(std::future<Network> network, std::map<uint32_t, std::string> ethosnOperationNameMapping)
         : m_IsPerfEstimationOnly(false)
         , m_Network(std::move(network))
         , m_EthosNOperationNameMapping(ethosnOperationNameMapping)
@@ -82,7 +88,7 @@ public:
         }
         else
         {
-            m_Network.~Network();
+            m_Network.~NetworkFuture();
         }
     }
 
@@ -91,9 +97,11 @@ public:
         return m_IsPerfEstimationOnly;
     }
 
+    /// Waits for the network to be compiled if it is being compiled in the background, and rethrows any exception
+    /// thrown while compiling it.
     const Network* GetNetwork() const
     {
-        return !m_IsPerfEstimationOnly ? &m_Network : nullptr;
+        return !m_IsPerfEstimationOnly ? &m_Network.get() : nullptr;
     }
 
     const PerfData* GetPerfData() const
@@ -107,11 +115,20 @@ public:
     }
 
 private:
+    using NetworkFuture = std::shared_future<Network>;
+
+    static std::future<Network> MakeReadyFuture(Network network)
+    {
+        std::promise<Network> promise;
+        promise.set_value(std::move(network));
+        return promise.get_future();
+    }
+
     const bool m_IsPerfEstimationOnly;
 
     union
     {
-        Network m_Network;
+        NetworkFuture m_Network;
         PerfData m_PerfData;
     };
 
@@ -125,8 +142,20 @@ public:
     EthosNPreCompiledWorkload(const PreCompiledQueueDescriptor& descriptor, const WorkloadInfo& info);
     void Execute() const override;
 
+    /// Schedules an inference of the workload on the given input and output tensor handles, in Arm NN slot order,
+    /// and returns it without waiting for it to complete. The handles must be EthosNTensorHandles with the same
+    /// shapes as those the workload was created with.
+    /// Any number of inferences may be in flight at once, each with its own tensor handles, so that the NPU can run
+    /// while the caller copies in the next inputs or processes earlier outputs on the CPU.
+    std::unique_ptr<ethosn::driver_library::Inference> ScheduleAsync(const std::vector<ITensorHandle*>& inputs,
+                                                                     const std::vector<ITensorHandle*>& outputs) const;
+
+    /// Waits for an inference returned by ScheduleAsync() to complete.
+    /// Throws a RuntimeException if the inference fails or times out.
+    void Wait(ethosn::driver_library::Inference& inference) const;
+
 private:
-    void Init(const PreCompiledDescriptor& descriptor, const EthosNPreCompiledObject::Network& network);
+    void Init(const EthosNPreCompiledObject::Network& network);
     void SavePerformanceJson() const;
 
     // The workload does not own the EthosNPreCompiledObject, the ownership is still retained by the pre-compiled layer
@@ -134,9 +163,6 @@ private:
 
     // The workload does own the network and the inference instances
     mutable std::unique_ptr<ethosn::driver_library::Network> m_Network;
-
-    std::vector<ethosn::driver_library::Buffer*> m_InputBuffers{};
-    std::vector<ethosn::driver_library::Buffer*> m_OutputBuffers{};
 };
 
 }    //namespace armnn
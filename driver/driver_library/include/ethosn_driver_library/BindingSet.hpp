@@ -0,0 +1,50 @@
+//
+// Copyright © 2021 Arm Limited. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include "Buffer.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ethosn
+{
+namespace driver_library
+{
+
+class Network;
+
+/// A fixed set of input & output buffers bound to a Network, created with Network::CreateBindingSet().
+/// Scheduling an inference with a BindingSet avoids resolving and re-binding the buffers for every inference,
+/// which makes it cheaper than passing the buffers to Network::ScheduleInference() each time.
+/// The buffers must outlive the BindingSet and any inferences scheduled with it.
+class BindingSet
+{
+public:
+    /// network is the Network which created the BindingSet, which is the only one it can be scheduled with.
+    /// The file descriptor is owned by the BindingSet, or is -1 if the target has no kernel binding sets.
+    BindingSet(const Network& network,
+               Buffer* const inputBuffers[],
+               uint32_t numInputBuffers,
+               Buffer* const outputBuffers[],
+               uint32_t numOutputBuffers,
+               int fileDescriptor);
+    ~BindingSet();
+
+    const Network& GetNetwork() const;
+    const std::vector<Buffer*>& GetInputBuffers() const;
+    const std::vector<Buffer*>& GetOutputBuffers() const;
+
+    int GetFileDescriptor() const;
+
+private:
+    class BindingSetImpl;
+    std::unique_ptr<BindingSetImpl> bindingSetImpl;
+};
+
+}    // namespace driver_library
+}    // namespace ethosn
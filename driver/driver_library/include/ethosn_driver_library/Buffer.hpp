@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include "Device.hpp"
+
 #include <ethosn_support_library/Support.hpp>
 
 #include <cstdint>
@@ -23,11 +25,19 @@ enum class DataFormat
     NHWCB
 };
 
+// Sources of memory which a Buffer can wrap without copying it.
+enum class MemorySource
+{
+    // A dma-buf file descriptor, e.g. from a camera or display driver.
+    DmaBuf,
+    // Memory in the address space of the process, e.g. from malloc.
+    // The address and the size must both be multiples of the page size.
+    UserPointer,
+};
+
 class Buffer
 {
 public:
-    // FIXME: Need an API where an external buffer is provided, without any copy. (Jira NNXSW-605)
-
     // Ethos-N allocates the buffer.
     Buffer(uint32_t size, DataFormat format);
 
@@ -42,6 +52,17 @@ public:
     // FIXME: Fix as part of Jira NNXSW-610 - Refactor Driver Library
     Buffer(uint8_t* src, uint32_t size, DataFormat format);
 
+    // As above, but the buffer is allocated by the given device rather than the default one.
+    Buffer(uint32_t size, DataFormat format, const Device& device);
+    Buffer(uint8_t* src, uint32_t size, DataFormat format, const Device& device);
+
+    // The buffer wraps existing memory rather than allocating its own, so that inferences read from and write to
+    // that memory directly. handle is a dma-buf file descriptor or the address of the memory, depending on source.
+    // The memory must stay valid until the buffer is destroyed.
+    // Only the kernel module backend supports this, and only when the NPU is behind an IOMMU.
+    Buffer(MemorySource source, uint64_t handle, uint32_t size, DataFormat format);
+    Buffer(MemorySource source, uint64_t handle, uint32_t size, DataFormat format, const Device& device);
+
     ~Buffer();
 
     // Returns the size of the buffer.
@@ -0,0 +1,72 @@
+//
+// Copyright © 2021 Arm Limited. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include "Buffer.hpp"
+#include "Device.hpp"
+
+#include <cstdint>
+#include <memory>
+
+namespace ethosn
+{
+namespace driver_library
+{
+
+struct BufferPoolStats
+{
+    /// The number of allocations satisfied by recycling a buffer held by the pool.
+    uint64_t m_NumHits;
+    /// The number of allocations which had to create a new buffer.
+    uint64_t m_NumMisses;
+    /// The total size of the buffers currently allocated from the pool and not yet released.
+    uint64_t m_NumBytesInUse;
+    /// The total size of the released buffers held by the pool for recycling.
+    uint64_t m_NumBytesPooled;
+    /// The largest value m_NumBytesInUse + m_NumBytesPooled has reached.
+    uint64_t m_HighWaterMarkBytes;
+};
+
+/// Recycles buffers, so that allocating a buffer doesn't need to allocate, map, unmap and free device memory every
+/// time it is done.
+///
+/// Requested sizes are rounded up to a size class and a released buffer is reused for any later allocation of the
+/// same size class and format, from any network. Size classes are a whole number of pages, as device memory is
+/// allocated in pages, and are at most 25% larger than the sizes in them apart from that rounding.
+///
+/// All methods are thread-safe. Buffers may outlive the pool. Those released after it is destroyed are still pooled,
+/// and are freed together once the last of them is released.
+class BufferPool
+{
+public:
+    /// Creates a pool which holds at most maxPooledBytes of released buffers, freeing any beyond that.
+    /// Buffers are allocated by the default device.
+    explicit BufferPool(uint64_t maxPooledBytes = UINT64_MAX);
+    /// As above, but buffers are allocated by the given device.
+    BufferPool(const Device& device, uint64_t maxPooledBytes = UINT64_MAX);
+    ~BufferPool();
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /// Returns a buffer of at least size bytes, which is released back to the pool when the last reference to it is
+    /// dropped. GetSize() on the buffer returns the size of its size class.
+    /// The buffer is zero-filled if zeroFill is set. Otherwise its contents are undefined: a recycled buffer holds
+    /// whatever data it held when released, and a new buffer may hold stale data.
+    std::shared_ptr<Buffer> Allocate(uint32_t size, DataFormat format, bool zeroFill = false);
+
+    /// Frees all the released buffers held by the pool.
+    void Trim();
+
+    BufferPoolStats GetStats() const;
+
+private:
+    class BufferPoolImpl;
+    std::shared_ptr<BufferPoolImpl> m_Impl;
+};
+
+}    // namespace driver_library
+}    // namespace ethosn
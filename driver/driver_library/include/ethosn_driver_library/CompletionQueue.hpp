@@ -0,0 +1,81 @@
+//
+// Copyright © 2021 Arm Limited. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include "Inference.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace ethosn
+{
+namespace driver_library
+{
+
+/// Waits for the completion of many inferences at once, so that a single thread can service any number of
+/// in-flight inferences instead of blocking one thread in poll() per inference.
+///
+/// Inferences are registered with Add() and their completions are either:
+///    * returned by WaitAny() and WaitAll(), which all wait on a single epoll set, or
+///    * delivered to a callback, which is called on a reactor thread owned by the queue.
+///
+/// All methods are thread-safe. The queue does not take ownership of the inferences registered with it.
+class CompletionQueue
+{
+public:
+    struct Completion
+    {
+        Inference* m_Inference;
+        InferenceResult m_Result;
+    };
+
+    /// Called on the reactor thread when an inference completes. The callback must not throw, and may register
+    /// further inferences with the queue.
+    using Callback = std::function<void(Inference* inference, InferenceResult result)>;
+
+    CompletionQueue();
+    ~CompletionQueue();
+
+    CompletionQueue(const CompletionQueue&) = delete;
+    CompletionQueue& operator=(const CompletionQueue&) = delete;
+
+    /// Registers an inference whose completion will be returned by WaitAny() or WaitAll().
+    /// The inference must stay alive until its completion has been returned or it has been removed.
+    void Add(Inference* inference);
+
+    /// Registers an inference whose completion will be delivered by calling the given callback on the reactor thread.
+    /// The callback is never called on the calling thread, even if the inference has already completed.
+    /// The reactor thread is started the first time this is called.
+    /// The inference must stay alive until the callback has been called or it has been removed.
+    void Add(Inference* inference, Callback callback);
+
+    /// Unregisters an inference which has not completed yet.
+    /// Returns false if the inference is not registered, including if its completion has already been delivered.
+    /// Note that a callback may still be running on the reactor thread when this returns false.
+    bool Remove(Inference* inference);
+
+    /// Waits until at least one of the inferences registered without a callback completes, or until the timeout
+    /// expires. Returns up to maxCompletions completions, in the order that they were observed, or an empty vector
+    /// on timeout or if there are no such inferences pending. A negative timeout waits indefinitely.
+    std::vector<Completion> WaitAny(int timeoutMs, uint32_t maxCompletions = UINT32_MAX);
+
+    /// Waits until all the inferences registered without a callback have completed, or until the timeout expires.
+    /// The completions observed are appended to completions. Returns true if no such inferences remain pending.
+    /// A negative timeout waits indefinitely.
+    bool WaitAll(std::vector<Completion>& completions, int timeoutMs);
+
+    /// Returns the number of registered inferences which have not yet completed, including those with a callback.
+    uint32_t GetNumPending() const;
+
+private:
+    class CompletionQueueImpl;
+    std::unique_ptr<CompletionQueueImpl> m_Impl;
+};
+
+}    // namespace driver_library
+}    // namespace ethosn
@@ -0,0 +1,42 @@
+//
+// Copyright © 2020 Arm Limited. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+namespace ethosn
+{
+namespace driver_library
+{
+
+// A handle to an Ethos-N device node, which stays open for as long as any copy of the handle exists.
+// Networks and buffers created with the same handle share its file descriptor rather than each opening the device
+// node, and the capabilities of the device are only queried from the kernel once.
+// Only the kernel module backend has device nodes. With other backends, the device can't be queried.
+class Device
+{
+public:
+    // Opens the given device node, e.g. to use a device other than the default one on a host with several devices.
+    explicit Device(const char* deviceNode);
+
+    // Returns the handle of the default device node, which is opened on first use and kept open by the process.
+    // This is the device used by the functions and constructors which don't take a Device.
+    static const Device& GetDefault();
+
+    // Returns the opaque block of data representing the capabilities of the firmware and hardware of the device.
+    // See GetFirmwareAndHardwareCapabilities() in Network.hpp.
+    const std::vector<char>& GetFirmwareAndHardwareCapabilities() const;
+
+    // Returns the raw file descriptor of the device node.
+    int GetDeviceHandle() const;
+
+private:
+    class DeviceImpl;
+    std::shared_ptr<DeviceImpl> m_DeviceImpl;
+};
+}    // namespace driver_library
+}    // namespace ethosn
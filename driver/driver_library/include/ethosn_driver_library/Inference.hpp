@@ -23,6 +23,16 @@ enum class InferenceResult
     Error     = 3,
 };
 
+/// Priority class of the inferences scheduled by a network. Queued inferences of a higher priority are always
+/// scheduled before those of a lower priority.
+/// Note this must be kept in-sync with the kernel driver's definitions.
+enum class InferencePriority
+{
+    Low    = 0,
+    Medium = 1,
+    High   = 2,
+};
+
 class Inference
 {
 public:
@@ -5,11 +5,16 @@
 
 #pragma once
 
+#include "BindingSet.hpp"
 #include "Buffer.hpp"
+#include "Device.hpp"
 #include "Inference.hpp"
 
 #include <ethosn_support_library/Support.hpp>
 
+#include <memory>
+#include <vector>
+
 // Version information
 #define ETHOSN_DRIVER_LIBRARY_VERSION_MAJOR 0
 #define ETHOSN_DRIVER_LIBRARY_VERSION_MINOR 1
@@ -38,12 +43,25 @@ const Version GetLibraryVersion();
 /// This data should be passed to the Support Library (in its CompilationOptions constructor)
 /// to provide details of what features of the hardware it should compile for.
 std::vector<char> GetFirmwareAndHardwareCapabilities();
+/// As above, but for the given device rather than the default one.
+std::vector<char> GetFirmwareAndHardwareCapabilities(const Device& device);
+
+// The input & output buffers of one inference in a batch scheduled with Network::ScheduleInferences.
+struct BufferSet
+{
+    Buffer* const* m_InputBuffers;
+    uint32_t m_NumInputBuffers;
+    Buffer* const* m_OutputBuffers;
+    uint32_t m_NumOutputBuffers;
+};
 
 // The Network class maintains references to the command stream, ple kernels & weights.
 class Network
 {
 public:
     Network(support_library::CompiledNetwork&);
+    // As above, but the network is registered with the given device rather than the default one, and so runs on it.
+    Network(support_library::CompiledNetwork&, const Device& device);
 
     ~Network();
 
@@ -54,8 +72,36 @@ public:
                                  Buffer* const outputBuffers[],
                                  uint32_t numOutputBuffers) const;
 
+    // Schedule a batch of inferences with the network, one for each of the buffer sets supplied.
+    // Either all the inferences are scheduled or, if an exception is thrown, none are.
+    // There can be at most 64 inferences in a batch.
+    // Returns one Inference object per buffer set, in the same order.
+    std::vector<std::unique_ptr<Inference>> ScheduleInferences(const BufferSet bufferSets[],
+                                                               uint32_t numBufferSets) const;
+
+    // Bind the input & output buffers supplied to the network once, so that they can be used for any number of
+    // inferences. Returns a BindingSet object.
+    BindingSet* CreateBindingSet(Buffer* const inputBuffers[],
+                                 uint32_t numInputBuffers,
+                                 Buffer* const outputBuffers[],
+                                 uint32_t numOutputBuffers) const;
+
+    // Schedule an inference with the network and the buffers of a BindingSet created by this network.
+    // Throws std::invalid_argument if the BindingSet was created by a different network.
+    // Returns a Inference object.
+    Inference* ScheduleInference(const BindingSet& bindingSet) const;
+
     void SetDebugName(const char* name);
 
+    // Set the priority of the inferences and binding sets subsequently scheduled or created by this network.
+    // The default is InferencePriority::Medium. InferencePriority::High needs the CAP_SYS_NICE capability.
+    void SetPriority(InferencePriority priority);
+
+    // Set the share of the device this network is given among the networks with inferences queued at the same
+    // priority: up to weight inferences of this network are scheduled in turn. The default weight is 1.
+    // Weights above 4 need the CAP_SYS_NICE capability, and weights above 64 are treated as 64.
+    void SetSchedulingWeight(uint32_t weight);
+
 private:
     std::unique_ptr<NetworkImpl> m_NetworkImpl;
 };
@@ -190,6 +190,12 @@ public:
 
 std::vector<ProfilingEntry> ReportNewProfilingData();
 
+/// Converts the binary trace streamed to the file given by the dumpFile option of the
+/// ETHOSN_DRIVER_LIBRARY_PROFILING_CONFIG environment variable, when its dumpFormat option is binary, to a JSON file.
+/// The ethosn_convert_profiling_trace tool does the same from the command line.
+/// Returns false if the trace can't be read or the JSON file can't be written.
+bool ConvertProfilingTraceToJson(const char* traceFilename, const char* jsonFilename);
+
 const char* MetadataCategoryToCString(ProfilingEntry::MetadataCategory category);
 
 const char* MetadataTypeToCString(ProfilingEntry::Type type);
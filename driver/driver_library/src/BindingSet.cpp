@@ -0,0 +1,81 @@
+//
+// Copyright © 2021 Arm Limited. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "../include/ethosn_driver_library/BindingSet.hpp"
+
+#if defined(__unix__)
+#include <unistd.h>
+#endif
+
+namespace ethosn
+{
+namespace driver_library
+{
+
+class BindingSet::BindingSetImpl
+{
+public:
+    BindingSetImpl(const Network& network,
+                   Buffer* const inputBuffers[],
+                   uint32_t numInputBuffers,
+                   Buffer* const outputBuffers[],
+                   uint32_t numOutputBuffers,
+                   int fileDescriptor)
+        : m_Network(network)
+        , m_InputBuffers(inputBuffers, inputBuffers + numInputBuffers)
+        , m_OutputBuffers(outputBuffers, outputBuffers + numOutputBuffers)
+        , m_FileDescriptor(fileDescriptor)
+    {}
+
+    ~BindingSetImpl()
+    {
+#if defined(__unix__)
+        if (m_FileDescriptor >= 0)
+        {
+            close(m_FileDescriptor);
+        }
+#endif
+    }
+
+    const Network& m_Network;
+    const std::vector<Buffer*> m_InputBuffers;
+    const std::vector<Buffer*> m_OutputBuffers;
+    const int m_FileDescriptor;
+};
+
+BindingSet::BindingSet(const Network& network,
+                       Buffer* const inputBuffers[],
+                       uint32_t numInputBuffers,
+                       Buffer* const outputBuffers[],
+                       uint32_t numOutputBuffers,
+                       int fileDescriptor)
+    : bindingSetImpl{ std::make_unique<BindingSetImpl>(network, inputBuffers, numInputBuffers, outputBuffers,
+                                                       numOutputBuffers, fileDescriptor) }
+{}
+
+BindingSet::~BindingSet() = default;
+
+const Network& BindingSet::GetNetwork() const
+{
+    return bindingSetImpl->m_Network;
+}
+
+const std::vector<Buffer*>& BindingSet::GetInputBuffers() const
+{
+    return bindingSetImpl->m_InputBuffers;
+}
+
+const std::vector<Buffer*>& BindingSet::GetOutputBuffers() const
+{
+    return bindingSetImpl->m_OutputBuffers;
+}
+
+int BindingSet::GetFileDescriptor() const
+{
+    return bindingSetImpl->m_FileDescriptor;
+}
+
+}    // namespace driver_library
+}    // namespace ethosn
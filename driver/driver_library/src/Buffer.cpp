@@ -12,35 +12,88 @@
 #include "ModelBuffer.hpp"
 #endif
 
+#include <ethosn_utils/Macros.hpp>
+
 #include <chrono>
+#include <stdexcept>
 
 namespace ethosn
 {
 namespace driver_library
 {
 
-Buffer::Buffer(uint32_t size, DataFormat format)
-    : bufferImpl{ std::make_unique<BufferImpl>(size, format) }
+namespace
+{
+
+void RecordBufferLifetimeStart(profiling::LifetimeEvent& event)
 {
     if (profiling::g_CurrentConfiguration.m_EnableProfiling)
     {
-        RecordLifetimeEvent(this, profiling::g_BufferToLifetimeEventId,
-                            profiling::ProfilingEntry::Type::TimelineEventStart,
+        RecordLifetimeEvent(event, profiling::g_NumLiveBuffers, profiling::ProfilingEntry::Type::TimelineEventStart,
                             profiling::ProfilingEntry::MetadataCategory::BufferLifetime);
     }
 }
 
+}    // namespace
+
+Buffer::Buffer(uint32_t size, DataFormat format)
+    : bufferImpl{ std::make_unique<BufferImpl>(size, format) }
+{
+    RecordBufferLifetimeStart(bufferImpl->GetLifetimeEvent());
+}
+
 Buffer::Buffer(uint8_t* src, uint32_t size, DataFormat format)
     : bufferImpl{ std::make_unique<BufferImpl>(src, size, format) }
 {
-    if (profiling::g_CurrentConfiguration.m_EnableProfiling)
-    {
-        RecordLifetimeEvent(this, profiling::g_BufferToLifetimeEventId,
-                            profiling::ProfilingEntry::Type::TimelineEventStart,
-                            profiling::ProfilingEntry::MetadataCategory::BufferLifetime);
-    }
+    RecordBufferLifetimeStart(bufferImpl->GetLifetimeEvent());
+}
+
+Buffer::Buffer(uint32_t size, DataFormat format, const Device& device)
+#ifdef TARGET_KMOD
+    : bufferImpl{ std::make_unique<BufferImpl>(size, format, device) }
+#else
+    : bufferImpl{ std::make_unique<BufferImpl>(size, format) }
+#endif
+{
+    ETHOSN_UNUSED(device);
+    RecordBufferLifetimeStart(bufferImpl->GetLifetimeEvent());
 }
 
+Buffer::Buffer(uint8_t* src, uint32_t size, DataFormat format, const Device& device)
+#ifdef TARGET_KMOD
+    : bufferImpl{ std::make_unique<BufferImpl>(src, size, format, device) }
+#else
+    : bufferImpl{ std::make_unique<BufferImpl>(src, size, format) }
+#endif
+{
+    ETHOSN_UNUSED(device);
+    RecordBufferLifetimeStart(bufferImpl->GetLifetimeEvent());
+}
+
+#ifdef TARGET_KMOD
+Buffer::Buffer(MemorySource source, uint64_t handle, uint32_t size, DataFormat format)
+    : bufferImpl{ std::make_unique<BufferImpl>(source, handle, size, format) }
+{
+    RecordBufferLifetimeStart(bufferImpl->GetLifetimeEvent());
+}
+
+Buffer::Buffer(MemorySource source, uint64_t handle, uint32_t size, DataFormat format, const Device& device)
+    : bufferImpl{ std::make_unique<BufferImpl>(source, handle, size, format, device) }
+{
+    RecordBufferLifetimeStart(bufferImpl->GetLifetimeEvent());
+}
+#else
+Buffer::Buffer(MemorySource, uint64_t, uint32_t, DataFormat)
+{
+    throw std::runtime_error("Importing memory is only supported by the kernel module backend");
+}
+
+Buffer::Buffer(MemorySource, uint64_t, uint32_t, DataFormat, const Device&)
+{
+    throw std::runtime_error("Importing memory is only supported by the kernel module backend");
+}
+#endif
+
 uint32_t Buffer::GetSize()
 {
     return bufferImpl->GetSize();
@@ -55,7 +108,7 @@ Buffer::~Buffer()
 {
     if (profiling::g_CurrentConfiguration.m_EnableProfiling)
     {
-        RecordLifetimeEvent(this, profiling::g_BufferToLifetimeEventId,
+        RecordLifetimeEvent(bufferImpl->GetLifetimeEvent(), profiling::g_NumLiveBuffers,
                             profiling::ProfilingEntry::Type::TimelineEventEnd,
                             profiling::ProfilingEntry::MetadataCategory::BufferLifetime);
     }
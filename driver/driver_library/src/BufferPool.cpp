@@ -0,0 +1,204 @@
+//
+// Copyright © 2021 Arm Limited. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "../include/ethosn_driver_library/BufferPool.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#if defined(__unix__)
+#include <unistd.h>
+#endif
+
+namespace ethosn
+{
+namespace driver_library
+{
+
+namespace
+{
+
+/// Device memory is allocated in whole pages, so size classes are always a whole number of pages.
+uint64_t GetPageSize()
+{
+#if defined(__unix__)
+    static const uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    return pageSize;
+#else
+    return 4096;
+#endif
+}
+
+/// Rounds size up to the next of four evenly spaced steps between consecutive powers of two, or to the next page for
+/// sizes where those steps would be smaller than a page.
+uint64_t GetSizeClass(uint32_t size)
+{
+    const uint64_t pageSize = GetPageSize();
+    if (size <= pageSize)
+    {
+        return pageSize;
+    }
+    uint32_t log2 = 0;
+    for (uint64_t n = size - 1; n > 1; n >>= 1)
+    {
+        ++log2;
+    }
+    // Both are powers of two, so the larger is a multiple of the page size
+    const uint64_t step = std::max(uint64_t{ 1 } << (log2 - 2), pageSize);
+    return (size + step - 1) & ~(step - 1);
+}
+
+}    // namespace
+
+class BufferPool::BufferPoolImpl
+{
+public:
+    BufferPoolImpl(std::unique_ptr<Device> device, uint64_t maxPooledBytes)
+        : m_Device(std::move(device))
+        , m_MaxPooledBytes(maxPooledBytes)
+        , m_Stats()
+    {}
+
+    std::unique_ptr<Buffer> Acquire(uint32_t size, DataFormat format, bool zeroFill)
+    {
+        const uint64_t sizeClass = GetSizeClass(size);
+        if (sizeClass > UINT32_MAX)
+        {
+            throw std::invalid_argument("Buffer size is too large to be pooled");
+        }
+
+        std::unique_ptr<Buffer> buffer;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            std::vector<std::unique_ptr<Buffer>>& freeList = m_FreeLists[Key(sizeClass, format)];
+            if (!freeList.empty())
+            {
+                buffer = std::move(freeList.back());
+                freeList.pop_back();
+                ++m_Stats.m_NumHits;
+                m_Stats.m_NumBytesPooled -= sizeClass;
+            }
+            else
+            {
+                ++m_Stats.m_NumMisses;
+            }
+            // Account for a new buffer before creating it, so that the high-water mark includes buffers being
+            // created concurrently.
+            m_Stats.m_NumBytesInUse += sizeClass;
+            m_Stats.m_HighWaterMarkBytes =
+                std::max(m_Stats.m_HighWaterMarkBytes, m_Stats.m_NumBytesInUse + m_Stats.m_NumBytesPooled);
+        }
+
+        if (!buffer)
+        {
+            // Create the buffer outside the lock so that other threads can recycle buffers meanwhile.
+            try
+            {
+                const uint32_t bufferSize = static_cast<uint32_t>(sizeClass);
+                buffer = m_Device ? std::make_unique<Buffer>(bufferSize, format, *m_Device)
+                                  : std::make_unique<Buffer>(bufferSize, format);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_Stats.m_NumBytesInUse -= sizeClass;
+                throw;
+            }
+        }
+
+        // New buffers are not zeroed either, as not every kernel allocator zeroes the memory it allocates.
+        if (zeroFill)
+        {
+            std::memset(buffer->GetMappedBuffer(), 0, buffer->GetSize());
+        }
+        return buffer;
+    }
+
+    void Release(std::unique_ptr<Buffer> buffer)
+    {
+        // The buffer is freed, if it isn't pooled, after the lock is released.
+        const uint64_t sizeClass = buffer->GetSize();
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stats.m_NumBytesInUse -= sizeClass;
+        if (m_Stats.m_NumBytesPooled + sizeClass > m_MaxPooledBytes)
+        {
+            return;
+        }
+        try
+        {
+            m_FreeLists[Key(sizeClass, buffer->GetDataFormat())].push_back(std::move(buffer));
+            m_Stats.m_NumBytesPooled += sizeClass;
+        }
+        catch (const std::bad_alloc&)
+        {
+            // The buffer is just freed instead.
+        }
+    }
+
+    void Trim()
+    {
+        std::map<Key, std::vector<std::unique_ptr<Buffer>>> freeLists;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            std::swap(freeLists, m_FreeLists);
+            m_Stats.m_NumBytesPooled = 0;
+        }
+    }
+
+    BufferPoolStats GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Stats;
+    }
+
+private:
+    using Key = std::pair<uint64_t, DataFormat>;
+
+    /// Null to allocate buffers with the default device.
+    std::unique_ptr<Device> m_Device;
+    const uint64_t m_MaxPooledBytes;
+
+    /// Protects the members below.
+    mutable std::mutex m_Mutex;
+    std::map<Key, std::vector<std::unique_ptr<Buffer>>> m_FreeLists;
+    BufferPoolStats m_Stats;
+};
+
+BufferPool::BufferPool(uint64_t maxPooledBytes)
+    : m_Impl(std::make_shared<BufferPoolImpl>(nullptr, maxPooledBytes))
+{}
+
+BufferPool::BufferPool(const Device& device, uint64_t maxPooledBytes)
+    : m_Impl(std::make_shared<BufferPoolImpl>(std::make_unique<Device>(device), maxPooledBytes))
+{}
+
+BufferPool::~BufferPool() = default;
+
+std::shared_ptr<Buffer> BufferPool::Allocate(uint32_t size, DataFormat format, bool zeroFill)
+{
+    std::unique_ptr<Buffer> buffer = m_Impl->Acquire(size, format, zeroFill);
+    // The deleter keeps the impl alive, so that buffers can be released after the pool is destroyed.
+    std::shared_ptr<BufferPoolImpl> impl = m_Impl;
+    return std::shared_ptr<Buffer>(buffer.release(),
+                                   [impl](Buffer* released) { impl->Release(std::unique_ptr<Buffer>(released)); });
+}
+
+void BufferPool::Trim()
+{
+    m_Impl->Trim();
+}
+
+BufferPoolStats BufferPool::GetStats() const
+{
+    return m_Impl->GetStats();
+}
+
+}    // namespace driver_library
+}    // namespace ethosn
@@ -0,0 +1,551 @@
+//
+// Copyright © 2021 Arm Limited. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "../include/ethosn_driver_library/CompletionQueue.hpp"
+
+#include <ethosn_utils/Macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#if defined(__unix__)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+namespace ethosn
+{
+namespace driver_library
+{
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+/// Maximum number of events retrieved by a single call to epoll_wait.
+constexpr int g_MaxEventsPerWait = 64;
+
+/// Bounds of the delay before the reactor thread retries after epoll_wait fails, which doubles on each consecutive
+/// failure so that a persistent error does not make it spin.
+constexpr std::chrono::milliseconds g_MinReactorBackoff(1);
+constexpr std::chrono::milliseconds g_MaxReactorBackoff(1000);
+
+#if defined(__unix__)
+InferenceResult ReadInferenceResult(int fd)
+{
+    InferenceResult result;
+    if (read(fd, &result, sizeof(result)) != static_cast<ssize_t>(sizeof(result)))
+    {
+        return InferenceResult::Error;
+    }
+    return result;
+}
+
+/// Owns a file descriptor and closes it when destroyed, so that none are leaked if construction of the
+/// CompletionQueue fails part way through.
+class FileDescriptor
+{
+public:
+    explicit FileDescriptor(int fd)
+        : m_Fd(fd)
+    {}
+
+    FileDescriptor(FileDescriptor&& other)
+        : m_Fd(other.m_Fd)
+    {
+        other.m_Fd = -1;
+    }
+
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+    ~FileDescriptor()
+    {
+        if (m_Fd >= 0)
+        {
+            close(m_Fd);
+        }
+    }
+
+    int Get() const
+    {
+        return m_Fd;
+    }
+
+private:
+    int m_Fd;
+};
+
+FileDescriptor CreateEpoll()
+{
+    FileDescriptor fd(epoll_create1(EPOLL_CLOEXEC));
+    if (fd.Get() < 0)
+    {
+        throw std::runtime_error(std::string("Failed to create epoll set: ") + strerror(errno));
+    }
+    return fd;
+}
+
+/// Creates an eventfd used to wake up a thread blocked in epoll_wait on the given epoll set and adds it to the set.
+FileDescriptor CreateWakeFd(const FileDescriptor& epollFd)
+{
+    FileDescriptor fd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK));
+    if (fd.Get() < 0)
+    {
+        throw std::runtime_error(std::string("Failed to create eventfd: ") + strerror(errno));
+    }
+    epoll_event event = {};
+    event.events      = EPOLLIN;
+    event.data.fd     = fd.Get();
+    if (epoll_ctl(epollFd.Get(), EPOLL_CTL_ADD, fd.Get(), &event) != 0)
+    {
+        throw std::runtime_error(std::string("Failed to add eventfd to epoll set: ") + strerror(errno));
+    }
+    return fd;
+}
+
+void Wake(const FileDescriptor& wakeFd)
+{
+    const uint64_t one = 1;
+    ssize_t ret        = write(wakeFd.Get(), &one, sizeof(one));
+    // The eventfd counter can only overflow after ~2^64 wake-ups, which would have been consumed long before.
+    (void)ret;
+}
+#endif
+
+}    // namespace
+
+class CompletionQueue::CompletionQueueImpl
+{
+public:
+    CompletionQueueImpl()
+        : m_NumWaitablePending(0)
+        , m_IsPolling(false)
+        , m_StopReactor(false)
+#if defined(__unix__)
+        , m_WaitEpollFd(CreateEpoll())
+        , m_WaitWakeFd(CreateWakeFd(m_WaitEpollFd))
+        , m_ReactorEpollFd(CreateEpoll())
+        , m_ReactorWakeFd(CreateWakeFd(m_ReactorEpollFd))
+#endif
+    {}
+
+    ~CompletionQueueImpl()
+    {
+        if (m_Reactor.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_StopReactor = true;
+            }
+            m_Cv.notify_all();
+#if defined(__unix__)
+            Wake(m_ReactorWakeFd);
+#endif
+            m_Reactor.join();
+        }
+    }
+
+    void Add(Inference* inference, Callback callback)
+    {
+        const int fd           = inference->GetFileDescriptor();
+        const bool hasCallback = static_cast<bool>(callback);
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (!m_Entries.emplace(fd, Entry{ inference, std::move(callback) }).second)
+            {
+                throw std::invalid_argument("Inference is already registered with the CompletionQueue");
+            }
+            if (!hasCallback)
+            {
+                ++m_NumWaitablePending;
+            }
+#if defined(__unix__)
+            else if (!m_Reactor.joinable())
+            {
+                m_Reactor = std::thread(&CompletionQueueImpl::RunReactor, this);
+            }
+#endif
+        }
+
+#if defined(__unix__)
+        epoll_event event = {};
+        event.events      = EPOLLIN | EPOLLONESHOT;
+        event.data.fd     = fd;
+        if (epoll_ctl(GetEpollFd(hasCallback), EPOLL_CTL_ADD, fd, &event) != 0)
+        {
+            int err = errno;
+            if (err == EPERM)
+            {
+                // The file does not support polling, which is the case for the simulated inferences of the
+                // dump-only target. Such files are always ready, so complete the inference straight away.
+                // Callbacks are still only ever called on the reactor thread.
+                const InferenceResult result = ReadInferenceResult(fd);
+                if (hasCallback)
+                {
+                    PostToReactor(fd, result);
+                }
+                else
+                {
+                    CompleteNow(fd, result);
+                }
+                return;
+            }
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            EraseEntry(m_Entries.find(fd));
+            throw std::runtime_error(std::string("Failed to add inference to the CompletionQueue: ") + strerror(err));
+        }
+#else
+        // For platforms other than Linux we assume we are running on the model and therefore there is no need to wait.
+        CompleteNow(fd, InferenceResult::Completed);
+#endif
+    }
+
+    bool Remove(Inference* inference)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        const int fd = inference->GetFileDescriptor();
+        auto it      = m_Entries.find(fd);
+        if (it == m_Entries.end() || it->second.m_Inference != inference)
+        {
+            return false;
+        }
+#if defined(__unix__)
+        epoll_ctl(GetEpollFd(static_cast<bool>(it->second.m_Callback)), EPOLL_CTL_DEL, fd, nullptr);
+#endif
+        EraseEntry(it);
+        // A waiter may have nothing left to wait for
+        m_Cv.notify_all();
+#if defined(__unix__)
+        Wake(m_WaitWakeFd);
+#endif
+        return true;
+    }
+
+    /// Collects completions of the inferences registered without a callback into completions, until either
+    /// one has been collected (or none are pending) or, when waitForAll is set, until none are pending.
+    /// Returns false if the timeout expired first.
+    bool Wait(std::vector<Completion>& completions, uint32_t maxCompletions, bool waitForAll, int timeoutMs)
+    {
+        const Clock::time_point deadline =
+            timeoutMs < 0 ? Clock::time_point::max() : Clock::now() + std::chrono::milliseconds(timeoutMs);
+        uint32_t numCollected = 0;
+        bool expired          = false;
+
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        while (true)
+        {
+            while (!m_Ready.empty() && (waitForAll || numCollected < maxCompletions))
+            {
+                completions.push_back(m_Ready.front());
+                m_Ready.pop_front();
+                ++numCollected;
+            }
+            const bool nonePending = m_NumWaitablePending == 0 && m_Ready.empty();
+            if (nonePending || (!waitForAll && numCollected > 0))
+            {
+                return true;
+            }
+            if (expired)
+            {
+                return false;
+            }
+
+            // Only one thread waits on the epoll set at a time. The others wait for it to move the completions
+            // it observes into m_Ready.
+            if (!m_IsPolling)
+            {
+                m_IsPolling = true;
+                lock.unlock();
+                try
+                {
+                    Poll(false, GetRemainingMs(deadline));
+                }
+                catch (...)
+                {
+                    lock.lock();
+                    m_IsPolling = false;
+                    m_Cv.notify_all();
+                    throw;
+                }
+                lock.lock();
+                m_IsPolling = false;
+                m_Cv.notify_all();
+            }
+            else
+            {
+                m_Cv.wait_until(lock, deadline);
+            }
+            expired = Clock::now() >= deadline;
+        }
+    }
+
+    uint32_t GetNumPending() const
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return static_cast<uint32_t>(m_Entries.size());
+    }
+
+private:
+    struct Entry
+    {
+        Inference* m_Inference;
+        Callback m_Callback;
+    };
+
+    using Entries = std::unordered_map<int, Entry>;
+
+    static int GetRemainingMs(Clock::time_point deadline)
+    {
+        if (deadline == Clock::time_point::max())
+        {
+            return -1;
+        }
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+        return remaining > 0 ? static_cast<int>(remaining) : 0;
+    }
+
+#if defined(__unix__)
+    int GetEpollFd(bool hasCallback) const
+    {
+        return hasCallback ? m_ReactorEpollFd.Get() : m_WaitEpollFd.Get();
+    }
+#endif
+
+    /// Must be called with m_Mutex held.
+    void EraseEntry(Entries::iterator it)
+    {
+        if (!it->second.m_Callback)
+        {
+            --m_NumWaitablePending;
+        }
+        m_Entries.erase(it);
+    }
+
+    /// Must be called with m_Mutex held. Moves the completion of a finished inference to m_Ready, or to callbacks
+    /// for inferences registered with a callback.
+    void Complete(Entries::iterator it,
+                  InferenceResult result,
+                  std::vector<std::pair<Callback, Completion>>& callbacks)
+    {
+        const Completion completion{ it->second.m_Inference, result };
+        if (it->second.m_Callback)
+        {
+            callbacks.emplace_back(std::move(it->second.m_Callback), completion);
+            m_Entries.erase(it);
+        }
+        else
+        {
+            m_Ready.push_back(completion);
+            --m_NumWaitablePending;
+            m_Entries.erase(it);
+            m_Cv.notify_all();
+        }
+    }
+
+    void CompleteNow(int fd, InferenceResult result)
+    {
+        std::vector<std::pair<Callback, Completion>> callbacks;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            auto it = m_Entries.find(fd);
+            if (it != m_Entries.end())
+            {
+                Complete(it, result, callbacks);
+            }
+        }
+        InvokeCallbacks(callbacks);
+    }
+
+#if defined(__unix__)
+    /// Completes an inference registered with a callback, leaving the callback to be called on the reactor thread.
+    void PostToReactor(int fd, InferenceResult result)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            auto it = m_Entries.find(fd);
+            if (it == m_Entries.end())
+            {
+                return;
+            }
+            Complete(it, result, m_PostedCallbacks);
+        }
+        Wake(m_ReactorWakeFd);
+    }
+#endif
+
+    static void InvokeCallbacks(const std::vector<std::pair<Callback, Completion>>& callbacks)
+    {
+        for (const std::pair<Callback, Completion>& callback : callbacks)
+        {
+            callback.first(callback.second.m_Inference, callback.second.m_Result);
+        }
+    }
+
+    /// Waits for events on one of the epoll sets and completes the inferences that have finished.
+    void Poll(bool reactor, int timeoutMs)
+    {
+#if defined(__unix__)
+        const int epollFd = reactor ? m_ReactorEpollFd.Get() : m_WaitEpollFd.Get();
+        const int wakeFd  = reactor ? m_ReactorWakeFd.Get() : m_WaitWakeFd.Get();
+
+        epoll_event events[g_MaxEventsPerWait];
+        int numEvents = epoll_wait(epollFd, events, g_MaxEventsPerWait, timeoutMs);
+        if (numEvents < 0)
+        {
+            if (errno == EINTR)
+            {
+                return;
+            }
+            throw std::runtime_error(std::string("Error while waiting for inferences to complete: ") +
+                                     strerror(errno));
+        }
+
+        std::vector<std::pair<Callback, Completion>> callbacks;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (reactor)
+            {
+                callbacks.swap(m_PostedCallbacks);
+            }
+            for (int i = 0; i < numEvents; ++i)
+            {
+                const int fd = events[i].data.fd;
+                if (fd == wakeFd)
+                {
+                    uint64_t count;
+                    ssize_t ret = read(wakeFd, &count, sizeof(count));
+                    (void)ret;
+                    continue;
+                }
+
+                // The inference may have been removed since epoll_wait returned, in which case its file descriptor
+                // may have been closed. Only registered inferences are guaranteed to still be alive.
+                auto it = m_Entries.find(fd);
+                if (it == m_Entries.end())
+                {
+                    continue;
+                }
+                const InferenceResult result = ReadInferenceResult(fd);
+                if (result == InferenceResult::Scheduled || result == InferenceResult::Running)
+                {
+                    // A stale event for a removed inference whose file descriptor number has since been reused.
+                    epoll_event event = {};
+                    event.events      = EPOLLIN | EPOLLONESHOT;
+                    event.data.fd     = fd;
+                    epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+                    continue;
+                }
+                epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+                Complete(it, result, callbacks);
+            }
+        }
+        InvokeCallbacks(callbacks);
+#else
+        ETHOSN_UNUSED(reactor);
+        ETHOSN_UNUSED(timeoutMs);
+#endif
+    }
+
+    void RunReactor()
+    {
+        std::chrono::milliseconds backoff(0);
+        while (!m_StopReactor)
+        {
+            try
+            {
+                Poll(true, -1);
+                backoff = std::chrono::milliseconds(0);
+            }
+            catch (const std::runtime_error&)
+            {
+                // There is no caller to report the error to, so keep servicing the remaining inferences, but wait
+                // before retrying in case the error persists.
+                backoff = std::min(std::max(backoff * 2, g_MinReactorBackoff), g_MaxReactorBackoff);
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_Cv.wait_for(lock, backoff, [this]() { return m_StopReactor.load(); });
+            }
+        }
+    }
+
+    mutable std::mutex m_Mutex;
+    std::condition_variable m_Cv;
+    /// Registered inferences that have not completed yet, keyed by their file descriptor.
+    Entries m_Entries;
+    /// Completions of the inferences registered without a callback, yet to be returned by Wait.
+    std::deque<Completion> m_Ready;
+    uint32_t m_NumWaitablePending;
+    /// Whether a thread is currently waiting on m_WaitEpollFd.
+    bool m_IsPolling;
+    /// Callbacks of inferences which completed as soon as they were added, yet to be called by the reactor thread.
+    std::vector<std::pair<Callback, Completion>> m_PostedCallbacks;
+
+    std::thread m_Reactor;
+    std::atomic<bool> m_StopReactor;
+
+#if defined(__unix__)
+    FileDescriptor m_WaitEpollFd;
+    FileDescriptor m_WaitWakeFd;
+    FileDescriptor m_ReactorEpollFd;
+    FileDescriptor m_ReactorWakeFd;
+#endif
+};
+
+CompletionQueue::CompletionQueue()
+    : m_Impl(std::make_unique<CompletionQueueImpl>())
+{}
+
+CompletionQueue::~CompletionQueue() = default;
+
+void CompletionQueue::Add(Inference* inference)
+{
+    m_Impl->Add(inference, nullptr);
+}
+
+void CompletionQueue::Add(Inference* inference, Callback callback)
+{
+    if (!callback)
+    {
+        throw std::invalid_argument("CompletionQueue callback must not be empty");
+    }
+    m_Impl->Add(inference, std::move(callback));
+}
+
+bool CompletionQueue::Remove(Inference* inference)
+{
+    return m_Impl->Remove(inference);
+}
+
+std::vector<CompletionQueue::Completion> CompletionQueue::WaitAny(int timeoutMs, uint32_t maxCompletions)
+{
+    std::vector<Completion> completions;
+    m_Impl->Wait(completions, maxCompletions, false, timeoutMs);
+    return completions;
+}
+
+bool CompletionQueue::WaitAll(std::vector<Completion>& completions, int timeoutMs)
+{
+    return m_Impl->Wait(completions, UINT32_MAX, true, timeoutMs);
+}
+
+uint32_t CompletionQueue::GetNumPending() const
+{
+    return m_Impl->GetNumPending();
+}
+
+}    // namespace driver_library
+}    // namespace ethosn
@@ -8,8 +8,16 @@
 #include "ProfilingInternal.hpp"
 #include "Utils.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <mutex>
 #include <ostream>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace ethosn
@@ -19,10 +27,168 @@ namespace driver_library
 namespace profiling
 {
 
-void DumpAllProfilingData(std::ostream& outStream)
+namespace
 {
-    std::vector<ProfilingEntry> entries = profiling::g_ProfilingEntries;
-    // As well as dumping the currently queued profiling events, include a sample of every pollable counter.
+
+const char g_TraceMagic[8]       = { 'E', 'T', 'N', 'T', 'R', 'A', 'C', 'E' };
+const uint32_t g_TraceVersion    = 1;
+const auto g_DumpFlushPeriod     = std::chrono::milliseconds(100);
+
+/// Appends the profiling entries to g_DumpFile from a background thread, periodically or when requested.
+/// Each entry is written once, so the cost of dumping doesn't grow over the run.
+class DumpWriter
+{
+public:
+    DumpWriter(const std::string& filename, DumpFormat format)
+        : m_File(filename, std::ios_base::out | std::ios_base::trunc | std::ofstream::binary)
+        , m_Format(format)
+        , m_NumWritten(0)
+        , m_Stop(false)
+        , m_FlushRequested(false)
+        , m_NumDroppedReported(0)
+    {
+        if (m_Format == DumpFormat::Binary)
+        {
+            TraceHeader header = {};
+            std::copy(std::begin(g_TraceMagic), std::end(g_TraceMagic), header.m_Magic);
+            header.m_Version    = g_TraceVersion;
+            header.m_RecordSize = sizeof(TraceRecord);
+            m_File.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        }
+        else
+        {
+            m_File << "[\n";
+            EndJsonArray();
+        }
+
+        m_Thread = std::thread(&DumpWriter::Run, this);
+    }
+
+    ~DumpWriter()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Stop = true;
+        }
+        m_ConditionVariable.notify_one();
+        m_Thread.join();
+    }
+
+    void RequestFlush()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_FlushRequested = true;
+        }
+        m_ConditionVariable.notify_one();
+    }
+
+private:
+    void Run()
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        bool stop = false;
+        while (!stop)
+        {
+            m_ConditionVariable.wait_for(lock, g_DumpFlushPeriod, [this] { return m_Stop || m_FlushRequested; });
+            // Flush once more after being stopped, to write the entries of the last inferences
+            stop             = m_Stop;
+            m_FlushRequested = false;
+
+            lock.unlock();
+            Flush();
+            lock.lock();
+        }
+    }
+
+    void Flush()
+    {
+        m_Entries.clear();
+        g_ProfilingEntries.PopAll(ProfilingEntries::Consumer::Dump, m_Entries);
+
+        if (!m_Entries.empty())
+        {
+            if (m_Format == DumpFormat::Binary)
+            {
+                WriteTraceRecords();
+            }
+            else
+            {
+                WriteJsonEntries();
+            }
+            m_File.flush();
+        }
+
+        uint64_t numDropped = g_ProfilingEntries.GetNumDropped(ProfilingEntries::Consumer::Dump);
+        if (numDropped != m_NumDroppedReported)
+        {
+            std::cerr << "Dropped " << (numDropped - m_NumDroppedReported)
+                      << " profiling entries because the profiling buffer was full\n";
+            m_NumDroppedReported = numDropped;
+        }
+    }
+
+    void WriteTraceRecords()
+    {
+        for (const ProfilingEntry& entry : m_Entries)
+        {
+            TraceRecord record;
+            record.m_Timestamp        = entry.m_Timestamp.time_since_epoch().count();
+            record.m_Id               = entry.m_Id;
+            record.m_MetadataValue    = entry.m_MetadataValue;
+            record.m_Type             = static_cast<uint32_t>(entry.m_Type);
+            record.m_MetadataCategory = static_cast<uint32_t>(entry.m_MetadataCategory);
+            m_File.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        }
+    }
+
+    /// Overwrites the end of the array with the new entries, then ends it again, so the file is always a complete
+    /// JSON array in the same format as DumpProfilingData() writes.
+    void WriteJsonEntries()
+    {
+        m_File.seekp(m_JsonArrayEnd);
+        for (const ProfilingEntry& entry : m_Entries)
+        {
+            if (m_NumWritten++ != 0)
+            {
+                m_File << ",\n";
+            }
+            DumpProfilingEntry(entry, m_File);
+        }
+        EndJsonArray();
+    }
+
+    void EndJsonArray()
+    {
+        m_JsonArrayEnd = m_File.tellp();
+        m_File << "\n]\n";
+    }
+
+    std::ofstream m_File;
+    DumpFormat m_Format;
+    uint64_t m_NumWritten;
+    /// Where the next JSON entry is written, overwriting the end of the array.
+    std::ofstream::pos_type m_JsonArrayEnd;
+    /// Reused by every flush, so that it is only allocated once.
+    std::vector<ProfilingEntry> m_Entries;
+
+    std::mutex m_Mutex;
+    std::condition_variable m_ConditionVariable;
+    bool m_Stop;
+    bool m_FlushRequested;
+    uint64_t m_NumDroppedReported;
+
+    std::thread m_Thread;
+};
+
+}    // namespace
+
+void StreamProfilingData()
+{
+    // Started on first use and stopped at exit, after a final flush
+    static DumpWriter writer(g_DumpFile, g_DumpFormat);
+
+    // As well as streaming the profiling events, include a sample of every pollable counter.
     for (PollCounterName counter = static_cast<PollCounterName>(PollCounterName::DriverLibraryNumLiveBuffers);
          counter < PollCounterName::NumValues; counter = NextEnumValue(counter))
     {
@@ -33,9 +199,183 @@ void DumpAllProfilingData(std::ostream& outStream)
         entry.m_MetadataCategory = ProfilingEntry::MetadataCategory::CounterValue;
         entry.m_MetadataValue    = metadata::CreateCounterValue(GetCounterValue(counter));
 
+        g_ProfilingEntries.Push(entry);
+    }
+
+    // Don't wait for the next periodic flush if entries might soon be dropped
+    if (g_ProfilingEntries.IsThreadBufferHalfFull(ProfilingEntries::Consumer::Dump))
+    {
+        writer.RequestFlush();
+    }
+}
+
+bool ConvertProfilingTrace(std::istream& trace, std::ostream& outStream)
+{
+    TraceHeader header;
+    if (!trace.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        !std::equal(std::begin(g_TraceMagic), std::end(g_TraceMagic), header.m_Magic) ||
+        header.m_Version != g_TraceVersion || header.m_RecordSize != sizeof(TraceRecord))
+    {
+        return false;
+    }
+
+    std::vector<ProfilingEntry> entries;
+    TraceRecord record;
+    while (trace.read(reinterpret_cast<char*>(&record), sizeof(record)))
+    {
+        ProfilingEntry entry;
+        entry.m_Timestamp = std::chrono::time_point<std::chrono::high_resolution_clock>(
+            std::chrono::high_resolution_clock::duration(record.m_Timestamp));
+        entry.m_Id               = record.m_Id;
+        entry.m_MetadataValue    = record.m_MetadataValue;
+        entry.m_Type             = static_cast<ProfilingEntry::Type>(record.m_Type);
+        entry.m_MetadataCategory = static_cast<ProfilingEntry::MetadataCategory>(record.m_MetadataCategory);
         entries.push_back(entry);
     }
+
     DumpProfilingData(entries, outStream);
+    return true;
+}
+
+bool ConvertProfilingTraceToJson(const char* traceFilename, const char* jsonFilename)
+{
+    std::ifstream trace(traceFilename, std::ios_base::in | std::ifstream::binary);
+    std::ofstream json(jsonFilename, std::ios_base::out | std::ofstream::binary);
+    return ConvertProfilingTrace(trace, json) && json.good();
+}
+
+void DumpProfilingEntry(const ProfilingEntry& entry, std::ostream& o)
+{
+    o << "\t{\n";
+    o << "\t\t"
+      << R"("time_stamp": )" << std::to_string(entry.m_Timestamp.time_since_epoch().count()) << ",\n";
+    o << "\t\t"
+      << R"("type": )" << std::to_string(static_cast<uint64_t>(entry.m_Type)) << ",\n";
+    o << "\t\t"
+      << R"("id": )" << std::to_string(entry.m_Id) << ",\n";
+    o << "\t\t"
+      << R"("metadata_category": )" << std::to_string(static_cast<uint64_t>(entry.m_MetadataCategory)) << ",\n";
+    o << "\t\t"
+      << R"("metadata_value":)"
+      << "\n";
+    o << "\t\t{\n";
+    switch (entry.m_MetadataCategory)
+    {
+        case ProfilingEntry::MetadataCategory::FirmwareWfeSleeping:
+        {
+            o << "\t\t\t"
+              << R"("firmware_wfe_sleeping_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
+            break;
+        }
+        case ProfilingEntry::MetadataCategory::FirmwareInference:
+        {
+            o << "\t\t\t"
+              << R"("firmware_inference_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
+            break;
+        }
+        case ProfilingEntry::MetadataCategory::FirmwareCommand:
+        {
+            o << "\t\t\t"
+              << R"("firmware_command_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
+            break;
+        }
+        case ProfilingEntry::MetadataCategory::FirmwareDma:
+        {
+            o << "\t\t\t"
+              << R"("firmware_dma_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
+            break;
+        }
+        case ProfilingEntry::MetadataCategory::FirmwareTsu:
+        {
+            o << "\t\t\t"
+              << R"("firmware_tsu_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
+            break;
+        }
+        case ProfilingEntry::MetadataCategory::FirmwareMceStripeSetup:
+        {
+            o << "\t\t\t"
+              << R"("firmware_mce_stripe_setup_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
+            break;
+        }
+        case ProfilingEntry::MetadataCategory::FirmwarePleStripeSetup:
+        {
+            o << "\t\t\t"
+              << R"("firmware_ple_stripe_setup_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
+            break;
+        }
+        case ProfilingEntry::MetadataCategory::FirmwareLabel:
+        {
+            o << "\t\t\t"
+              << R"("firmware_label_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
+            break;
+        }
+        case ProfilingEntry::MetadataCategory::FirmwareDmaSetup:
+        {
+            o << "\t\t\t"
+              << R"("firmware_dma_setup_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
+            break;
+        }
+        case ProfilingEntry::MetadataCategory::FirmwareGetCompleteCommand:
+        {
+            o << "\t\t\t"
+              << R"("firmware_get_complete_command_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
+            break;
+        }
+        case ProfilingEntry::MetadataCategory::FirmwareScheduleNextCommand:
+        {
+            o << "\t\t\t"
+              << R"("firmware_schedule_next_command_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
+            break;
+        }
+        case ProfilingEntry::MetadataCategory::FirmwareWfeChecking:
+        {
+            o << "\t\t\t"
+              << R"("firmware_wfe_checking_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
+            break;
+        }
+        case ProfilingEntry::MetadataCategory::FirmwareTimeSync:
+        {
+            o << "\t\t\t"
+              << R"("firmware_time_sync_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
+            break;
+        }
+        case ProfilingEntry::MetadataCategory::FirmwareAgent:
+        {
+            o << "\t\t\t"
+              << R"("firmware_agent_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
+            break;
+        }
+        case ProfilingEntry::MetadataCategory::FirmwareAgentStripe:
+        {
+            o << "\t\t\t"
+              << R"("firmware_agent_stripe_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
+            break;
+        }
+        case ProfilingEntry::MetadataCategory::InferenceLifetime:
+        {
+            o << "\t\t\t"
+              << R"("inference_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
+            break;
+        }
+        case ProfilingEntry::MetadataCategory::BufferLifetime:
+        {
+            o << "\t\t\t"
+              << R"("buffer_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
+            break;
+        }
+        case ProfilingEntry::MetadataCategory::CounterValue:
+        {
+            o << "\t\t\t"
+              << R"("counter_value": )" << std::to_string(entry.GetCounterValue()) << "\n";
+            break;
+        }
+        default:
+        {
+            // Some Metadata categories don't have metadata
+        }
+    }
+    o << "\t\t}\n";
+    o << "\t}";
 }
 
 void DumpProfilingData(const std::vector<ProfilingEntry>& profilingData, std::ostream& outStream)
@@ -45,142 +385,10 @@ void DumpProfilingData(const std::vector<ProfilingEntry>& profilingData, std::os
         return;
     }
     outStream << "[\n";
-    auto DumpEntry = [& o = outStream](const ProfilingEntry& entry) {
-        o << "\t{\n";
-        o << "\t\t"
-          << R"("time_stamp": )" << std::to_string(entry.m_Timestamp.time_since_epoch().count()) << ",\n";
-        o << "\t\t"
-          << R"("type": )" << std::to_string(static_cast<uint64_t>(entry.m_Type)) << ",\n";
-        o << "\t\t"
-          << R"("id": )" << std::to_string(entry.m_Id) << ",\n";
-        o << "\t\t"
-          << R"("metadata_category": )" << std::to_string(static_cast<uint64_t>(entry.m_MetadataCategory)) << ",\n";
-        o << "\t\t"
-          << R"("metadata_value":)"
-          << "\n";
-        o << "\t\t{\n";
-        switch (entry.m_MetadataCategory)
-        {
-            case ProfilingEntry::MetadataCategory::FirmwareWfeSleeping:
-            {
-                o << "\t\t\t"
-                  << R"("firmware_wfe_sleeping_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
-                break;
-            }
-            case ProfilingEntry::MetadataCategory::FirmwareInference:
-            {
-                o << "\t\t\t"
-                  << R"("firmware_inference_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
-                break;
-            }
-            case ProfilingEntry::MetadataCategory::FirmwareCommand:
-            {
-                o << "\t\t\t"
-                  << R"("firmware_command_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
-                break;
-            }
-            case ProfilingEntry::MetadataCategory::FirmwareDma:
-            {
-                o << "\t\t\t"
-                  << R"("firmware_dma_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
-                break;
-            }
-            case ProfilingEntry::MetadataCategory::FirmwareTsu:
-            {
-                o << "\t\t\t"
-                  << R"("firmware_tsu_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
-                break;
-            }
-            case ProfilingEntry::MetadataCategory::FirmwareMceStripeSetup:
-            {
-                o << "\t\t\t"
-                  << R"("firmware_mce_stripe_setup_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
-                break;
-            }
-            case ProfilingEntry::MetadataCategory::FirmwarePleStripeSetup:
-            {
-                o << "\t\t\t"
-                  << R"("firmware_ple_stripe_setup_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
-                break;
-            }
-            case ProfilingEntry::MetadataCategory::FirmwareLabel:
-            {
-                o << "\t\t\t"
-                  << R"("firmware_label_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
-                break;
-            }
-            case ProfilingEntry::MetadataCategory::FirmwareDmaSetup:
-            {
-                o << "\t\t\t"
-                  << R"("firmware_dma_setup_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
-                break;
-            }
-            case ProfilingEntry::MetadataCategory::FirmwareGetCompleteCommand:
-            {
-                o << "\t\t\t"
-                  << R"("firmware_get_complete_command_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
-                break;
-            }
-            case ProfilingEntry::MetadataCategory::FirmwareScheduleNextCommand:
-            {
-                o << "\t\t\t"
-                  << R"("firmware_schedule_next_command_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
-                break;
-            }
-            case ProfilingEntry::MetadataCategory::FirmwareWfeChecking:
-            {
-                o << "\t\t\t"
-                  << R"("firmware_wfe_checking_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
-                break;
-            }
-            case ProfilingEntry::MetadataCategory::FirmwareTimeSync:
-            {
-                o << "\t\t\t"
-                  << R"("firmware_time_sync_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
-                break;
-            }
-            case ProfilingEntry::MetadataCategory::FirmwareAgent:
-            {
-                o << "\t\t\t"
-                  << R"("firmware_agent_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
-                break;
-            }
-            case ProfilingEntry::MetadataCategory::FirmwareAgentStripe:
-            {
-                o << "\t\t\t"
-                  << R"("firmware_agent_stripe_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
-                break;
-            }
-            case ProfilingEntry::MetadataCategory::InferenceLifetime:
-            {
-                o << "\t\t\t"
-                  << R"("inference_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
-                break;
-            }
-            case ProfilingEntry::MetadataCategory::BufferLifetime:
-            {
-                o << "\t\t\t"
-                  << R"("buffer_value": )" << std::to_string(entry.m_MetadataValue) << "\n";
-                break;
-            }
-            case ProfilingEntry::MetadataCategory::CounterValue:
-            {
-                o << "\t\t\t"
-                  << R"("counter_value": )" << std::to_string(entry.GetCounterValue()) << "\n";
-                break;
-            }
-            default:
-            {
-                // Some Metadata categories don't have metadata
-            }
-        }
-        o << "\t\t}\n";
-        o << "\t}";
-    };
     for (size_t i = 0; i < profilingData.size(); ++i)
     {
         const ProfilingEntry& entry = profilingData[i];
-        DumpEntry(entry);
+        DumpProfilingEntry(entry, outStream);
         if (i != profilingData.size() - 1)
         {
             outStream << ",\n";
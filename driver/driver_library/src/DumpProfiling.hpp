@@ -7,6 +7,7 @@
 
 #include "../include/ethosn_driver_library/Profiling.hpp"
 
+#include <istream>
 #include <ostream>
 #include <vector>
 
@@ -17,8 +18,35 @@ namespace driver_library
 namespace profiling
 {
 
-void DumpAllProfilingData(std::ostream& outStream);
+/// Samples every pollable counter and has the profiling entries appended to g_DumpFile by a background thread,
+/// in g_DumpFormat. The entries are still returned by ReportNewProfilingData() too.
+///
+/// A binary trace is a TraceHeader followed by a TraceRecord for each entry, in the byte order of the host which
+/// wrote it.
+void StreamProfilingData();
+
+/// Converts a binary trace written for g_DumpFile to the JSON format written by DumpProfilingData().
+bool ConvertProfilingTrace(std::istream& trace, std::ostream& outStream);
+
 void DumpProfilingData(const std::vector<ProfilingEntry>& profilingData, std::ostream& outStream);
+/// Writes one element of the JSON array written by DumpProfilingData().
+void DumpProfilingEntry(const ProfilingEntry& entry, std::ostream& outStream);
+
+struct TraceHeader
+{
+    char m_Magic[8];
+    uint32_t m_Version;
+    uint32_t m_RecordSize;
+};
+
+struct TraceRecord
+{
+    int64_t m_Timestamp;
+    uint64_t m_Id;
+    uint64_t m_MetadataValue;
+    uint32_t m_Type;
+    uint32_t m_MetadataCategory;
+};
 
 }    // namespace profiling
 }    // namespace driver_library
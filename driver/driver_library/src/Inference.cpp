@@ -9,7 +9,6 @@
 #include "ProfilingInternal.hpp"
 
 #include <cstdint>
-#include <fstream>
 #if defined(__unix__)
 #include <unistd.h>
 #endif
@@ -38,8 +37,14 @@ public:
         return m_fileDescriptor;
     }
 
+    profiling::LifetimeEvent& GetLifetimeEvent()
+    {
+        return m_LifetimeEvent;
+    }
+
 private:
     int m_fileDescriptor;
+    profiling::LifetimeEvent m_LifetimeEvent;
 };
 
 Inference::Inference(int fileDescriptor)
@@ -47,7 +52,7 @@ Inference::Inference(int fileDescriptor)
 {
     if (profiling::g_CurrentConfiguration.m_EnableProfiling)
     {
-        RecordLifetimeEvent(this, profiling::g_InferenceToLifetimeEventId,
+        RecordLifetimeEvent(inferenceImpl->GetLifetimeEvent(), profiling::g_NumLiveInferences,
                             profiling::ProfilingEntry::Type::TimelineEventStart,
                             profiling::ProfilingEntry::MetadataCategory::InferenceLifetime);
     }
@@ -57,19 +62,18 @@ Inference::~Inference()
 {
     if (profiling::g_CurrentConfiguration.m_EnableProfiling)
     {
-        RecordLifetimeEvent(this, profiling::g_InferenceToLifetimeEventId,
+        RecordLifetimeEvent(inferenceImpl->GetLifetimeEvent(), profiling::g_NumLiveInferences,
                             profiling::ProfilingEntry::Type::TimelineEventEnd,
                             profiling::ProfilingEntry::MetadataCategory::InferenceLifetime);
 
         // Include profiling entries from the firmware if any.
         profiling::AppendKernelDriverEntries();
-        // Dumping profiling data at inference destruction is convenient because
+        // Streaming profiling data at inference destruction is convenient because
         // this is called frequently enough such that there is a good amount of data dumped
         // but not frequently enough to cause performance regressions.
         if (profiling::g_DumpFile.size() > 0)
         {
-            std::ofstream file(profiling::g_DumpFile.c_str(), std::ios_base::out | std::ofstream::binary);
-            profiling::DumpAllProfilingData(file);
+            profiling::StreamProfilingData();
         }
     }
 }
@@ -6,6 +6,8 @@
 #pragma once
 
 #include "../include/ethosn_driver_library/Buffer.hpp"
+#include "../include/ethosn_driver_library/Device.hpp"
+#include "ProfilingInternal.hpp"
 #include "Utils.hpp"
 
 #include <uapi/ethosn.h>
@@ -31,7 +33,7 @@ namespace driver_library
 class Buffer::BufferImpl
 {
 public:
-    BufferImpl(uint32_t size, DataFormat format)
+    BufferImpl(uint32_t size, DataFormat format, const Device& device = Device::GetDefault())
         : m_Data(nullptr)
         , m_Size(size)
         , m_Format(format)
@@ -41,40 +43,81 @@ public:
             MB_RDWR,
         };
 
-        int ethosnFd = open(ETHOSN_STRINGIZE_VALUE_OF(DEVICE_NODE), O_RDONLY);
-        if (ethosnFd < 0)
-        {
-            throw std::runtime_error(std::string("Unable to open ") +
-                                     std::string(ETHOSN_STRINGIZE_VALUE_OF(DEVICE_NODE)) + std::string(": ") +
-                                     strerror(errno));
-        }
-
-        m_BufferFd = ioctl(ethosnFd, ETHOSN_IOCTL_CREATE_BUFFER, &outputBufReq);
-        int err    = errno;
-        close(ethosnFd);
+        m_BufferFd = ioctl(device.GetDeviceHandle(), ETHOSN_IOCTL_CREATE_BUFFER, &outputBufReq);
         if (m_BufferFd < 0)
         {
-            throw std::runtime_error(std::string("Failed to create buffer: ") + strerror(err));
+            throw std::runtime_error(std::string("Failed to create buffer: ") + strerror(errno));
         }
 
         m_Data = reinterpret_cast<uint8_t*>(mmap(nullptr, size, PROT_WRITE, MAP_SHARED, m_BufferFd, 0));
         if (m_Data == MAP_FAILED)
         {
-            err = errno;
+            int err = errno;
             close(m_BufferFd);
             throw std::runtime_error(std::string("Failed to map memory: ") + strerror(err));
         }
+        m_OwnsMapping = true;
     }
 
-    BufferImpl(uint8_t* src, uint32_t size, DataFormat format)
-        : BufferImpl(size, format)
+    BufferImpl(uint8_t* src, uint32_t size, DataFormat format, const Device& device = Device::GetDefault())
+        : BufferImpl(size, format, device)
     {
         std::copy_n(src, size, m_Data);
     }
 
+    BufferImpl(MemorySource source,
+               uint64_t handle,
+               uint32_t size,
+               DataFormat format,
+               const Device& device = Device::GetDefault())
+        : m_Data(nullptr)
+        , m_Size(size)
+        , m_Format(format)
+    {
+        // The kernel imports whole pages. A dma-buf is itself a whole number of pages, which the kernel checks, but
+        // rounding up user memory would pin and map bytes past the end of the caller's allocation.
+        const uint32_t pageSize = static_cast<uint32_t>(sysconf(_SC_PAGESIZE));
+        if (source == MemorySource::UserPointer && size % pageSize != 0)
+        {
+            throw std::invalid_argument("Imported user memory must be a whole number of pages");
+        }
+
+        ethosn_buffer_import_req importReq = {};
+        importReq.handle                   = handle;
+        importReq.type =
+            (source == MemorySource::DmaBuf) ? ETHOSN_BUFFER_IMPORT_DMA_BUF : ETHOSN_BUFFER_IMPORT_USER_PTR;
+        importReq.size  = static_cast<uint32_t>(RoundUpToNearestMultiple(size, pageSize));
+        importReq.flags = MB_RDWR;
+
+        m_BufferFd = ioctl(device.GetDeviceHandle(), ETHOSN_IOCTL_IMPORT_BUFFER, &importReq);
+        if (m_BufferFd < 0)
+        {
+            throw std::runtime_error(std::string("Failed to import buffer: ") + strerror(errno));
+        }
+
+        if (source == MemorySource::UserPointer)
+        {
+            // The memory is already mapped in this process.
+            m_Data = reinterpret_cast<uint8_t*>(static_cast<uintptr_t>(handle));
+            return;
+        }
+
+        m_Data = reinterpret_cast<uint8_t*>(mmap(nullptr, size, PROT_WRITE, MAP_SHARED, m_BufferFd, 0));
+        if (m_Data == MAP_FAILED)
+        {
+            int err = errno;
+            close(m_BufferFd);
+            throw std::runtime_error(std::string("Failed to map memory: ") + strerror(err));
+        }
+        m_OwnsMapping = true;
+    }
+
     ~BufferImpl()
     {
-        munmap(m_Data, m_Size);
+        if (m_OwnsMapping)
+        {
+            munmap(m_Data, m_Size);
+        }
         close(m_BufferFd);
     }
 
@@ -98,11 +141,19 @@ public:
         return m_Data;
     }
 
+    profiling::LifetimeEvent& GetLifetimeEvent()
+    {
+        return m_LifetimeEvent;
+    }
+
 private:
     int m_BufferFd;
     uint8_t* m_Data;
+    /// False for imported user memory, which is mapped by its owner.
+    bool m_OwnsMapping = false;
     uint32_t m_Size;
     DataFormat m_Format;
+    profiling::LifetimeEvent m_LifetimeEvent;
 };
 
 }    // namespace driver_library
@@ -0,0 +1,109 @@
+//
+// Copyright © 2020 Arm Limited. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "../include/ethosn_driver_library/Device.hpp"
+
+#include "Utils.hpp"
+
+#include <uapi/ethosn.h>
+
+#include <cstring>
+#include <fcntl.h>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <sys/ioctl.h>
+#if defined(__unix__)
+#include <unistd.h>
+#endif
+
+namespace ethosn
+{
+namespace driver_library
+{
+
+class Device::DeviceImpl
+{
+public:
+    DeviceImpl(const char* deviceNode)
+        : m_DeviceFd(open(deviceNode, O_RDONLY | O_CLOEXEC))
+    {
+        if (m_DeviceFd < 0)
+        {
+            throw std::runtime_error(std::string("Unable to open ") + std::string(deviceNode) + std::string(": ") +
+                                     strerror(errno));
+        }
+    }
+
+    ~DeviceImpl()
+    {
+        close(m_DeviceFd);
+    }
+
+    const std::vector<char>& GetFirmwareAndHardwareCapabilities()
+    {
+        // If the query throws, the flag is left unset and the next call retries it.
+        std::call_once(m_CapsQueried, [this]() { m_Caps = QueryFirmwareAndHardwareCapabilities(); });
+        return m_Caps;
+    }
+
+    int GetDeviceHandle() const
+    {
+        return m_DeviceFd;
+    }
+
+private:
+    std::vector<char> QueryFirmwareAndHardwareCapabilities() const
+    {
+        // Query how big the capabilities data is.
+        int capsSize = ioctl(m_DeviceFd, ETHOSN_IOCTL_FW_HW_CAPABILITIES, NULL);
+        if (capsSize <= 0)
+        {
+            throw std::runtime_error(std::string("Failed to retrieve the size of firmware capabilities, errno = ") +
+                                     strerror(errno));
+        }
+
+        // Allocate a buffer of this size
+        std::vector<char> caps(capsSize);
+
+        // Get the kernel to fill it in
+        int ret = ioctl(m_DeviceFd, ETHOSN_IOCTL_FW_HW_CAPABILITIES, caps.data());
+        if (ret != 0)
+        {
+            throw std::runtime_error(
+                std::string("Failed to retrieve firmware and hardware information data, errno = ") + strerror(errno));
+        }
+
+        return caps;
+    }
+
+    int m_DeviceFd;
+    std::once_flag m_CapsQueried;
+    std::vector<char> m_Caps;
+};
+
+Device::Device(const char* deviceNode)
+    : m_DeviceImpl(std::make_shared<DeviceImpl>(deviceNode))
+{}
+
+const Device& Device::GetDefault()
+{
+    // If opening the device node throws, the next call tries again.
+    static const Device defaultDevice(ETHOSN_STRINGIZE_VALUE_OF(DEVICE_NODE));
+    return defaultDevice;
+}
+
+const std::vector<char>& Device::GetFirmwareAndHardwareCapabilities() const
+{
+    return m_DeviceImpl->GetFirmwareAndHardwareCapabilities();
+}
+
+int Device::GetDeviceHandle() const
+{
+    return m_DeviceImpl->GetDeviceHandle();
+}
+
+}    // namespace driver_library
+}    // namespace ethosn
@@ -35,6 +35,12 @@ static_assert(ETHOSN_INFERENCE_RUNNING == static_cast<int>(InferenceResult::Runn
 static_assert(ETHOSN_INFERENCE_COMPLETED == static_cast<int>(InferenceResult::Completed),
               "ethosn.h != InferenceResult");
 static_assert(ETHOSN_INFERENCE_ERROR == static_cast<int>(InferenceResult::Error), "ethosn.h != InferenceResult");
+static_assert(ETHOSN_INFERENCE_PRIORITY_LOW == static_cast<int>(InferencePriority::Low),
+              "ethosn.h != InferencePriority");
+static_assert(ETHOSN_INFERENCE_PRIORITY_MEDIUM == static_cast<int>(InferencePriority::Medium),
+              "ethosn.h != InferencePriority");
+static_assert(ETHOSN_INFERENCE_PRIORITY_HIGH == static_cast<int>(InferencePriority::High),
+              "ethosn.h != InferencePriority");
 
 namespace
 {
@@ -61,39 +67,28 @@ namespace driver_library
 
 std::vector<char> GetFirmwareAndHardwareCapabilities()
 {
-    int fd = open(ETHOSN_STRINGIZE_VALUE_OF(DEVICE_NODE), O_RDONLY);
-    if (fd < 0)
-    {
-        throw std::runtime_error(std::string("Unable to open ") + std::string(ETHOSN_STRINGIZE_VALUE_OF(DEVICE_NODE)) +
-                                 std::string(": ") + strerror(errno));
-    }
+    return Device::GetDefault().GetFirmwareAndHardwareCapabilities();
+}
 
-    // Query how big the capabilities data is.
-    int capsSize = ioctl(fd, ETHOSN_IOCTL_FW_HW_CAPABILITIES, NULL);
-    if (capsSize <= 0)
+std::vector<char> GetFirmwareAndHardwareCapabilities(const Device& device)
+{
+    return device.GetFirmwareAndHardwareCapabilities();
+}
+
+KmodNetworkImpl::KmodNetworkImpl(support_library::CompiledNetwork& compiledNetwork, const Device& device)
+    : NetworkImpl(compiledNetwork)
+    , m_DebugCmmSections(0)
+{
+    const char* const debugEnv = std::getenv("ETHOSN_DRIVER_LIBRARY_DEBUG");
+    if (debugEnv && (strcmp(debugEnv, "1") == 0 || strstr(debugEnv, "cmm") != nullptr))
     {
-        throw std::runtime_error(std::string("Failed to retrieve the size of firmware capabilities, errno = ") +
-                                 strerror(errno));
+        m_DebugCmmSections = Cmm_All;
     }
-
-    // Allocate a buffer of this size
-    std::vector<char> caps(capsSize);
-
-    // Get the kernel to fill it in
-    int ret = ioctl(fd, ETHOSN_IOCTL_FW_HW_CAPABILITIES, caps.data());
-    if (ret != 0)
+    else if (debugEnv && strstr(debugEnv, "cmdstream") != nullptr)
     {
-        throw std::runtime_error(std::string("Failed to retrieve firmware and hardware information data, errno = ") +
-                                 strerror(errno));
+        m_DebugCmmSections = Cmm_Inference | Cmm_ConstantControlUnit;
     }
 
-    close(fd);
-    return caps;
-}
-
-KmodNetworkImpl::KmodNetworkImpl(support_library::CompiledNetwork& compiledNetwork)
-    : NetworkImpl(compiledNetwork)
-{
     std::vector<ethosn_buffer_info> constantCuInfos =
         ToKmodBufInfos(compiledNetwork.GetConstantControlUnitDataBufferInfos());
     std::vector<ethosn_buffer_info> constantDmaInfos = ToKmodBufInfos(compiledNetwork.GetConstantDmaDataBufferInfos());
@@ -106,8 +101,8 @@ KmodNetworkImpl::KmodNetworkImpl(support_library::CompiledNetwork& compiledNetwo
 
     netReq.dma_buffers.num  = static_cast<uint32_t>(constantDmaInfos.size());
     netReq.dma_buffers.info = constantDmaInfos.data();
-    netReq.dma_data.size    = static_cast<uint32_t>(compiledNetwork.GetConstantDmaData().size());
-    netReq.dma_data.data    = compiledNetwork.GetConstantDmaData().data();
+    netReq.dma_data.size    = static_cast<uint32_t>(compiledNetwork.GetConstantDmaDataView().size());
+    netReq.dma_data.data    = compiledNetwork.GetConstantDmaDataView().data();
 
     netReq.intermediate_buffers.num  = static_cast<uint32_t>(intermediateInfos.size());
     netReq.intermediate_buffers.info = intermediateInfos.data();
@@ -122,24 +117,13 @@ KmodNetworkImpl::KmodNetworkImpl(support_library::CompiledNetwork& compiledNetwo
 
     netReq.cu_buffers.num  = static_cast<uint32_t>(constantCuInfos.size());
     netReq.cu_buffers.info = constantCuInfos.data();
-    netReq.cu_data.size    = static_cast<uint32_t>(compiledNetwork.GetConstantControlUnitData().size());
-    netReq.cu_data.data    = compiledNetwork.GetConstantControlUnitData().data();
-
-    int ethosnFd = open(ETHOSN_STRINGIZE_VALUE_OF(DEVICE_NODE), O_RDONLY);
-    if (ethosnFd < 0)
-    {
-        throw std::runtime_error(std::string("Unable to open ") + std::string(ETHOSN_STRINGIZE_VALUE_OF(DEVICE_NODE)) +
-                                 std::string(": ") + strerror(errno));
-    }
-    m_NetworkFd = ioctl(ethosnFd, ETHOSN_IOCTL_REGISTER_NETWORK, &netReq);
-    int err     = errno;
-    close(ethosnFd);
+    netReq.cu_data.size    = static_cast<uint32_t>(compiledNetwork.GetConstantControlUnitDataView().size());
+    netReq.cu_data.data    = compiledNetwork.GetConstantControlUnitDataView().data();
 
-    // Check file descriptor after closing ethosn fd, as not to leak data.
-    // Need to cache errno, as to not be overwritten by `close`
+    m_NetworkFd = ioctl(device.GetDeviceHandle(), ETHOSN_IOCTL_REGISTER_NETWORK, &netReq);
     if (m_NetworkFd < 0)
     {
-        throw std::runtime_error(std::string("Unable to create network: ") + strerror(err));
+        throw std::runtime_error(std::string("Unable to create network: ") + strerror(errno));
     }
 }
 
@@ -160,17 +144,7 @@ Inference* KmodNetworkImpl::ScheduleInference(Buffer* const inputBuffers[],
                                               Buffer* const outputBuffers[],
                                               uint32_t numOutputBuffers) const
 {
-    const char* const debugEnv = std::getenv("ETHOSN_DRIVER_LIBRARY_DEBUG");
-    if (debugEnv && (strcmp(debugEnv, "1") == 0 || strstr(debugEnv, "cmm") != nullptr))
-    {
-        DumpCmm(inputBuffers, numInputBuffers, (std::string("CombinedMemoryMap_") + m_DebugName + ".hex").c_str(),
-                Cmm_All);
-    }
-    else if (debugEnv && strstr(debugEnv, "cmdstream") != nullptr)
-    {
-        DumpCmm(inputBuffers, numInputBuffers, (std::string("CombinedMemoryMap_") + m_DebugName + ".hex").c_str(),
-                Cmm_Inference | Cmm_ConstantControlUnit);
-    }
+    DumpCmmIfRequested(inputBuffers, numInputBuffers);
 
     ethosn_inference_req ifrReq = {};
     std::vector<int> inputFds(numInputBuffers, -1);
@@ -202,6 +176,142 @@ Inference* KmodNetworkImpl::ScheduleInference(Buffer* const inputBuffers[],
     return new Inference(inference_fd);
 }
 
+std::vector<std::unique_ptr<Inference>> KmodNetworkImpl::ScheduleInferences(const BufferSet bufferSets[],
+                                                                            uint32_t numBufferSets) const
+{
+    if (numBufferSets == 0 || numBufferSets > ETHOSN_MAX_BATCH)
+    {
+        throw std::invalid_argument("A batch must have between 1 and " + std::to_string(ETHOSN_MAX_BATCH) +
+                                    " inferences");
+    }
+
+    std::vector<ethosn_inference_req> ifrReqs(numBufferSets);
+    // All the buffer fds of the batch, inputs then outputs for each inference
+    std::vector<int> bufferFds;
+
+    for (uint32_t i = 0; i < numBufferSets; ++i)
+    {
+        const BufferSet& bufferSet = bufferSets[i];
+        DumpCmmIfRequested(bufferSet.m_InputBuffers, bufferSet.m_NumInputBuffers);
+
+        for (uint32_t j = 0; j < bufferSet.m_NumInputBuffers; ++j)
+        {
+            bufferFds.push_back(bufferSet.m_InputBuffers[j]->GetBufferHandle());
+        }
+        for (uint32_t j = 0; j < bufferSet.m_NumOutputBuffers; ++j)
+        {
+            bufferFds.push_back(bufferSet.m_OutputBuffers[j]->GetBufferHandle());
+        }
+        ifrReqs[i].num_inputs  = bufferSet.m_NumInputBuffers;
+        ifrReqs[i].num_outputs = bufferSet.m_NumOutputBuffers;
+    }
+
+    // Point the requests into bufferFds only once it has stopped growing
+    const int* nextFd = bufferFds.data();
+    for (ethosn_inference_req& ifrReq : ifrReqs)
+    {
+        ifrReq.input_fds = nextFd;
+        nextFd += ifrReq.num_inputs;
+        ifrReq.output_fds = nextFd;
+        nextFd += ifrReq.num_outputs;
+    }
+
+    std::vector<int> inferenceFds(numBufferSets, -1);
+
+    ethosn_inference_batch_req batchReq = {};
+    batchReq.num_inferences             = numBufferSets;
+    batchReq.inferences                 = ifrReqs.data();
+    batchReq.inference_fds              = inferenceFds.data();
+
+    if (ioctl(m_NetworkFd, ETHOSN_IOCTL_SCHEDULE_INFERENCES, &batchReq) < 0)
+    {
+        throw std::runtime_error(std::string("Failed to create inferences: ") + strerror(errno));
+    }
+
+    std::vector<std::unique_ptr<Inference>> inferences;
+    inferences.reserve(numBufferSets);
+    for (int inferenceFd : inferenceFds)
+    {
+        inferences.push_back(std::make_unique<Inference>(inferenceFd));
+    }
+    return inferences;
+}
+
+BindingSet* KmodNetworkImpl::CreateBindingSet(const Network& network,
+                                              Buffer* const inputBuffers[],
+                                              uint32_t numInputBuffers,
+                                              Buffer* const outputBuffers[],
+                                              uint32_t numOutputBuffers) const
+{
+    ethosn_inference_req bindingReq = {};
+    std::vector<int> inputFds(numInputBuffers, -1);
+    std::vector<int> outputFds(numOutputBuffers, -1);
+
+    for (size_t i = 0; i < numInputBuffers; ++i)
+    {
+        inputFds[i] = inputBuffers[i]->GetBufferHandle();
+    }
+
+    for (size_t i = 0; i < numOutputBuffers; ++i)
+    {
+        outputFds[i] = outputBuffers[i]->GetBufferHandle();
+    }
+
+    bindingReq.num_inputs = numInputBuffers;
+    bindingReq.input_fds  = inputFds.data();
+
+    bindingReq.num_outputs = numOutputBuffers;
+    bindingReq.output_fds  = outputFds.data();
+
+    int bindingSetFd = ioctl(m_NetworkFd, ETHOSN_IOCTL_CREATE_BINDING_SET, &bindingReq);
+    if (bindingSetFd < 0)
+    {
+        throw std::runtime_error(std::string("Failed to create binding set: ") + strerror(errno));
+    }
+
+    return new BindingSet(network, inputBuffers, numInputBuffers, outputBuffers, numOutputBuffers, bindingSetFd);
+}
+
+Inference* KmodNetworkImpl::ScheduleInference(const BindingSet& bindingSet) const
+{
+    const std::vector<Buffer*>& inputBuffers = bindingSet.GetInputBuffers();
+    DumpCmmIfRequested(inputBuffers.data(), static_cast<uint32_t>(inputBuffers.size()));
+
+    int inference_fd = ioctl(bindingSet.GetFileDescriptor(), ETHOSN_IOCTL_SCHEDULE_BINDING_SET);
+    if (inference_fd < 0)
+    {
+        throw std::runtime_error(std::string("Failed to create inference: ") + strerror(errno));
+    }
+
+    return new Inference(inference_fd);
+}
+
+void KmodNetworkImpl::SetPriority(InferencePriority priority)
+{
+    uint32_t ethosnPriority = static_cast<uint32_t>(priority);
+    if (ioctl(m_NetworkFd, ETHOSN_IOCTL_SET_SCHEDULING_PRIORITY, &ethosnPriority) < 0)
+    {
+        throw std::runtime_error(std::string("Failed to set scheduling priority: ") + strerror(errno));
+    }
+}
+
+void KmodNetworkImpl::SetSchedulingWeight(uint32_t weight)
+{
+    if (ioctl(m_NetworkFd, ETHOSN_IOCTL_SET_SCHEDULING_WEIGHT, &weight) < 0)
+    {
+        throw std::runtime_error(std::string("Failed to set scheduling weight: ") + strerror(errno));
+    }
+}
+
+void KmodNetworkImpl::DumpCmmIfRequested(Buffer* const inputBuffers[], uint32_t numInputBuffers) const
+{
+    if (m_DebugCmmSections != 0)
+    {
+        DumpCmm(inputBuffers, numInputBuffers, (std::string("CombinedMemoryMap_") + m_DebugName + ".hex").c_str(),
+                m_DebugCmmSections);
+    }
+}
+
 void KmodNetworkImpl::DumpIntermediateBuffers()
 {
     std::cout << "Dumping intermediate buffers..." << std::endl;
@@ -245,7 +355,7 @@ void KmodNetworkImpl::DumpIntermediateBuffers()
 
         // Parse the command stream to find the DUMP_DRAM commands
         support_library::BufferInfo cmdStreamInfo = m_CompiledNetwork.GetConstantControlUnitDataBufferInfos()[0];
-        const uint8_t* rawCmdStreamData           = m_CompiledNetwork.GetConstantControlUnitData().data();
+        const uint8_t* rawCmdStreamData           = m_CompiledNetwork.GetConstantControlUnitDataView().data();
         command_stream::CommandStream cmdStream(rawCmdStreamData + cmdStreamInfo.m_Offset,
                                                 rawCmdStreamData + cmdStreamInfo.m_Offset + cmdStreamInfo.m_Size);
         for (auto it = cmdStream.begin(); it != cmdStream.end(); ++it)
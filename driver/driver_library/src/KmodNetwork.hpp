@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "../include/ethosn_driver_library/Device.hpp"
 #include "NetworkImpl.hpp"
 
 namespace ethosn
@@ -15,7 +16,7 @@ namespace driver_library
 class KmodNetworkImpl : public NetworkImpl
 {
 public:
-    KmodNetworkImpl(support_library::CompiledNetwork& compiledNetwork);
+    KmodNetworkImpl(support_library::CompiledNetwork& compiledNetwork, const Device& device = Device::GetDefault());
 
     ~KmodNetworkImpl() override;
 
@@ -24,10 +25,30 @@ public:
                                  Buffer* const outputBuffers[],
                                  uint32_t numOutputBuffers) const override;
 
+    std::vector<std::unique_ptr<Inference>> ScheduleInferences(const BufferSet bufferSets[],
+                                                               uint32_t numBufferSets) const override;
+
+    BindingSet* CreateBindingSet(const Network& network,
+                                 Buffer* const inputBuffers[],
+                                 uint32_t numInputBuffers,
+                                 Buffer* const outputBuffers[],
+                                 uint32_t numOutputBuffers) const override;
+
+    Inference* ScheduleInference(const BindingSet& bindingSet) const override;
+
+    void SetPriority(InferencePriority priority) override;
+    void SetSchedulingWeight(uint32_t weight) override;
+
 private:
     void DumpIntermediateBuffers();
 
+    /// Dumps the combined memory map if requested by ETHOSN_DRIVER_LIBRARY_DEBUG.
+    void DumpCmmIfRequested(Buffer* const inputBuffers[], uint32_t numInputBuffers) const;
+
     int m_NetworkFd;
+    /// The sections of the combined memory map to dump before each inference, read once from
+    /// ETHOSN_DRIVER_LIBRARY_DEBUG rather than for every inference.
+    uint8_t m_DebugCmmSections;
 };
 
 }    // namespace driver_library
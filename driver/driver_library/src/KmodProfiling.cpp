@@ -6,6 +6,7 @@
 // This file implements some of internal profiling functions by forwarding requests to the kernel module.
 // These functions are declared in ProfilingInternal.hpp.
 
+#include "../include/ethosn_driver_library/Device.hpp"
 #include "ProfilingInternal.hpp"
 #include "Utils.hpp"
 
@@ -54,12 +55,7 @@ bool ConfigureKernelDriver(Configuration config)
         std::cerr << "Warning more than 6 hardware counters specified, only the first 6 will be used.\n";
         return false;
     }
-    int ethosnFd = open(ETHOSN_STRINGIZE_VALUE_OF(DEVICE_NODE), O_RDONLY);
-    if (ethosnFd < 0)
-    {
-        throw std::runtime_error(std::string("Unable to open ") + std::string(ETHOSN_STRINGIZE_VALUE_OF(DEVICE_NODE)) +
-                                 std::string(": ") + strerror(errno));
-    }
+    int ethosnFd = Device::GetDefault().GetDeviceHandle();
 
     ethosn_profiling_config kernelConfig;
     kernelConfig.enable_profiling     = config.m_EnableProfiling;
@@ -71,7 +67,6 @@ bool ConfigureKernelDriver(Configuration config)
     }
     int result          = ioctl(ethosnFd, ETHOSN_IOCTL_CONFIGURE_PROFILING, &kernelConfig);
     g_ClockFrequencyMhz = ioctl(ethosnFd, ETHOSN_IOCTL_GET_CLOCK_FREQUENCY);
-    close(ethosnFd);
 
     if (result != 0)
     {
@@ -92,7 +87,7 @@ bool ConfigureKernelDriver(Configuration config)
     // Re-open if profiling is now enabled
     if (kernelConfig.enable_profiling)
     {
-        g_FirmwareBufferFd = open(ETHOSN_STRINGIZE_VALUE_OF(FIRMWARE_PROFILING_NODE), O_RDONLY);
+        g_FirmwareBufferFd = open(ETHOSN_STRINGIZE_VALUE_OF(FIRMWARE_PROFILING_NODE), O_RDONLY | O_CLOEXEC);
     }
     else
     {
@@ -104,12 +99,7 @@ bool ConfigureKernelDriver(Configuration config)
 
 uint64_t GetKernelDriverCounterValue(PollCounterName counter)
 {
-    int ethosnFd = open(ETHOSN_STRINGIZE_VALUE_OF(DEVICE_NODE), O_RDONLY);
-    if (ethosnFd < 0)
-    {
-        throw std::runtime_error(std::string("Unable to open ") + std::string(ETHOSN_STRINGIZE_VALUE_OF(DEVICE_NODE)) +
-                                 std::string(": ") + strerror(errno));
-    }
+    int ethosnFd = Device::GetDefault().GetDeviceHandle();
 
     ethosn_poll_counter_name kernelCounterName;
     switch (counter)
@@ -126,8 +116,6 @@ uint64_t GetKernelDriverCounterValue(PollCounterName counter)
 
     int result = ioctl(ethosnFd, ETHOSN_IOCTL_GET_COUNTER_VALUE, &kernelCounterName);
 
-    close(ethosnFd);
-
     if (result < 0)
     {
         throw std::runtime_error(std::string("Unable to retrieve counter value. errno: ") + strerror(errno));
@@ -276,7 +264,7 @@ bool AppendKernelDriverEntries()
         entry.m_Timestamp = std::chrono::time_point<std::chrono::high_resolution_clock>(std::chrono::nanoseconds(
             (1000 / g_ClockFrequencyMhz) * entry.m_Timestamp.time_since_epoch().count() + g_ProfilingDelta));
 
-        g_ProfilingEntries.push_back(entry);
+        g_ProfilingEntries.Push(entry);
     }
 
     return true;
@@ -12,6 +12,8 @@
 #include "KmodNetwork.hpp"
 #endif
 
+#include <ethosn_utils/Macros.hpp>
+
 namespace ethosn
 {
 namespace driver_library
@@ -49,6 +51,22 @@ Network::Network(support_library::CompiledNetwork& compiledNetwork)
       )
 {}
 
+Network::Network(support_library::CompiledNetwork& compiledNetwork, const Device& device)
+    : m_NetworkImpl(
+#if defined(TARGET_MODEL)
+          std::make_unique<ModelNetworkImpl>(compiledNetwork)
+#elif defined(TARGET_KMOD)
+          std::make_unique<KmodNetworkImpl>(compiledNetwork, device)
+#elif defined(TARGET_DUMPONLY)
+          std::make_unique<NetworkImpl>(compiledNetwork)
+#else
+#error "Unknown target backend."
+#endif
+      )
+{
+    ETHOSN_UNUSED(device);
+}
+
 Network::~Network() = default;
 
 Inference* Network::ScheduleInference(Buffer* const inputBuffers[],
@@ -59,10 +77,44 @@ Inference* Network::ScheduleInference(Buffer* const inputBuffers[],
     return m_NetworkImpl->ScheduleInference(inputBuffers, numInputBuffers, outputBuffers, numOutputBuffers);
 }
 
+std::vector<std::unique_ptr<Inference>> Network::ScheduleInferences(const BufferSet bufferSets[],
+                                                                    uint32_t numBufferSets) const
+{
+    return m_NetworkImpl->ScheduleInferences(bufferSets, numBufferSets);
+}
+
+BindingSet* Network::CreateBindingSet(Buffer* const inputBuffers[],
+                                      uint32_t numInputBuffers,
+                                      Buffer* const outputBuffers[],
+                                      uint32_t numOutputBuffers) const
+{
+    return m_NetworkImpl->CreateBindingSet(*this, inputBuffers, numInputBuffers, outputBuffers, numOutputBuffers);
+}
+
+Inference* Network::ScheduleInference(const BindingSet& bindingSet) const
+{
+    // The kernel schedules a binding set on the network it was created for, whichever network it is passed to
+    if (&bindingSet.GetNetwork() != this)
+    {
+        throw std::invalid_argument("The binding set was created by a different network");
+    }
+    return m_NetworkImpl->ScheduleInference(bindingSet);
+}
+
 void Network::SetDebugName(const char* name)
 {
     m_NetworkImpl->SetDebugName(name);
 }
 
+void Network::SetPriority(InferencePriority priority)
+{
+    m_NetworkImpl->SetPriority(priority);
+}
+
+void Network::SetSchedulingWeight(uint32_t weight)
+{
+    m_NetworkImpl->SetSchedulingWeight(weight);
+}
+
 }    // namespace driver_library
 }    // namespace ethosn
@@ -141,11 +141,48 @@ Inference* NetworkImpl::ScheduleInference(Buffer* const inputBuffers[],
     return new Inference(fileno(tempFile));
 }
 
+std::vector<std::unique_ptr<Inference>> NetworkImpl::ScheduleInferences(const BufferSet bufferSets[],
+                                                                        uint32_t numBufferSets) const
+{
+    std::vector<std::unique_ptr<Inference>> inferences;
+    inferences.reserve(numBufferSets);
+    for (uint32_t i = 0; i < numBufferSets; ++i)
+    {
+        const BufferSet& bufferSet = bufferSets[i];
+        inferences.emplace_back(ScheduleInference(bufferSet.m_InputBuffers, bufferSet.m_NumInputBuffers,
+                                                  bufferSet.m_OutputBuffers, bufferSet.m_NumOutputBuffers));
+    }
+    return inferences;
+}
+
+BindingSet* NetworkImpl::CreateBindingSet(const Network& network,
+                                          Buffer* const inputBuffers[],
+                                          uint32_t numInputBuffers,
+                                          Buffer* const outputBuffers[],
+                                          uint32_t numOutputBuffers) const
+{
+    return new BindingSet(network, inputBuffers, numInputBuffers, outputBuffers, numOutputBuffers, -1);
+}
+
+Inference* NetworkImpl::ScheduleInference(const BindingSet& bindingSet) const
+{
+    const std::vector<Buffer*>& inputBuffers  = bindingSet.GetInputBuffers();
+    const std::vector<Buffer*>& outputBuffers = bindingSet.GetOutputBuffers();
+    return ScheduleInference(inputBuffers.data(), static_cast<uint32_t>(inputBuffers.size()), outputBuffers.data(),
+                             static_cast<uint32_t>(outputBuffers.size()));
+}
+
 void NetworkImpl::SetDebugName(const char* name)
 {
     m_DebugName = name;
 }
 
+void NetworkImpl::SetPriority(InferencePriority)
+{}
+
+void NetworkImpl::SetSchedulingWeight(uint32_t)
+{}
+
 void NetworkImpl::DumpCmm(Buffer* const inputBuffers[],
                           uint32_t numInputBuffers,
                           const char* cmmFilename,
@@ -170,7 +207,7 @@ void NetworkImpl::DumpCmm(Buffer* const inputBuffers[],
     // Other buffer types need allocations in the functional model's address space.
     uint64_t constantDmaDataBaseAddress = ethosn::driver_library::RoundUpToNearestMultiple(baseAddress, 64);
     uint64_t inputBuffersBaseAddress    = ethosn::driver_library::RoundUpToNearestMultiple(
-        constantDmaDataBaseAddress + m_CompiledNetwork.GetConstantDmaData().size(), 64);
+        constantDmaDataBaseAddress + m_CompiledNetwork.GetConstantDmaDataView().size(), 64);
     uint64_t outputBuffersBaseAddress = ethosn::driver_library::RoundUpToNearestMultiple(
         inputBuffersBaseAddress + GetLastAddressedMemory(m_CompiledNetwork.GetInputBufferInfos()), 64);
     uint64_t intermediateDataBaseAddress = ethosn::driver_library::RoundUpToNearestMultiple(
@@ -189,12 +226,13 @@ void NetworkImpl::DumpCmm(Buffer* const inputBuffers[],
     // Add "memory map"
     if (sections & Cmm_ConstantDma)
     {
-        AddToMemoryMap(cmm, static_cast<uint32_t>(constantDmaDataBaseAddress), m_CompiledNetwork.GetConstantDmaData());
+        AddToMemoryMap(cmm, static_cast<uint32_t>(constantDmaDataBaseAddress),
+                       m_CompiledNetwork.GetConstantDmaDataView());
     }
     if (sections & Cmm_ConstantControlUnit)
     {
         AddToMemoryMap(cmm, static_cast<uint32_t>(cmmConstantControlUnitDataBaseAddress),
-                       m_CompiledNetwork.GetConstantControlUnitData());
+                       m_CompiledNetwork.GetConstantControlUnitDataView());
     }
 
     // Write the inference data, which includes the binding table
@@ -5,8 +5,10 @@
 
 #pragma once
 
+#include "../include/ethosn_driver_library/BindingSet.hpp"
 #include "../include/ethosn_driver_library/Buffer.hpp"
 #include "../include/ethosn_driver_library/Inference.hpp"
+#include "../include/ethosn_driver_library/Network.hpp"
 
 #include <ethosn_support_library/Support.hpp>
 
@@ -33,8 +35,26 @@ public:
                                          Buffer* const outputBuffers[],
                                          uint32_t numOutputBuffers) const;
 
+    /// This simple base implementation schedules each inference of the batch in turn.
+    virtual std::vector<std::unique_ptr<Inference>> ScheduleInferences(const BufferSet bufferSets[],
+                                                                       uint32_t numBufferSets) const;
+
+    /// This simple base implementation only records the buffers, which are passed to ScheduleInference above
+    /// for each inference. network is the Network which owns this implementation.
+    virtual BindingSet* CreateBindingSet(const Network& network,
+                                         Buffer* const inputBuffers[],
+                                         uint32_t numInputBuffers,
+                                         Buffer* const outputBuffers[],
+                                         uint32_t numOutputBuffers) const;
+
+    virtual Inference* ScheduleInference(const BindingSet& bindingSet) const;
+
     void SetDebugName(const char* name);
 
+    /// This simple base implementation ignores the priority and the weight, as there is no scheduler to pass them to.
+    virtual void SetPriority(InferencePriority priority);
+    virtual void SetSchedulingWeight(uint32_t weight);
+
 protected:
     enum CmmSection : uint8_t
     {
@@ -0,0 +1,49 @@
+//
+// Copyright © 2020 Arm Limited. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+// This file implements Device for the model and other backends that do not have access to a kernel module, and so
+// have no device node to open. Handles can still be created and passed to the functions and constructors which take
+// one, which ignore it, but the device itself can't be queried.
+
+#include "../include/ethosn_driver_library/Device.hpp"
+#include "../include/ethosn_driver_library/Network.hpp"
+
+#include <stdexcept>
+
+namespace ethosn
+{
+namespace driver_library
+{
+
+class Device::DeviceImpl
+{};
+
+Device::Device(const char*)
+    : m_DeviceImpl(std::make_shared<DeviceImpl>())
+{}
+
+const Device& Device::GetDefault()
+{
+    static const Device defaultDevice("");
+    return defaultDevice;
+}
+
+const std::vector<char>& Device::GetFirmwareAndHardwareCapabilities() const
+{
+    throw std::runtime_error("Querying a device is only supported by the kernel module backend");
+}
+
+int Device::GetDeviceHandle() const
+{
+    throw std::runtime_error("Querying a device is only supported by the kernel module backend");
+}
+
+std::vector<char> GetFirmwareAndHardwareCapabilities(const Device& device)
+{
+    return device.GetFirmwareAndHardwareCapabilities();
+}
+
+}    // namespace driver_library
+}    // namespace ethosn
@@ -7,6 +7,8 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <sstream>
@@ -19,10 +21,321 @@ namespace driver_library
 namespace profiling
 {
 
-uint64_t GetNextTimeLineEventId()
+ProfilingEntryRingBuffer::ProfilingEntryRingBuffer(size_t capacity)
+    : m_Cells(std::make_unique<Cell[]>(capacity))
+    , m_Mask(capacity - 1)
+    , m_PushPos(0)
+    , m_PopPos(0)
+    , m_NumDropped(0)
 {
-    g_NextTimelineEventId = std::max(g_DriverLibraryEventIdBase, g_NextTimelineEventId + 1);
-    return g_NextTimelineEventId;
+    assert(capacity != 0 && (capacity & m_Mask) == 0);
+    for (size_t i = 0; i < capacity; ++i)
+    {
+        m_Cells[i].m_Sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool ProfilingEntryRingBuffer::Push(const ProfilingEntry& entry)
+{
+    size_t pos = m_PushPos.load(std::memory_order_relaxed);
+    while (true)
+    {
+        Cell& cell          = m_Cells[pos & m_Mask];
+        size_t sequence     = cell.m_Sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence - pos);
+        if (diff == 0)
+        {
+            // The cell is free in this lap. Claim it, unless another producer got there first.
+            if (m_PushPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                cell.m_Entry = entry;
+                cell.m_Sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0)
+        {
+            // The cell still holds the entry from the previous lap, so the buffer is full
+            m_NumDropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        else
+        {
+            pos = m_PushPos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool ProfilingEntryRingBuffer::Pop(ProfilingEntry& entry)
+{
+    size_t pos = m_PopPos.load(std::memory_order_relaxed);
+    while (true)
+    {
+        Cell& cell          = m_Cells[pos & m_Mask];
+        size_t sequence     = cell.m_Sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+        if (diff == 0)
+        {
+            // The cell has been written in this lap. Claim it, unless another consumer got there first.
+            if (m_PopPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                entry = cell.m_Entry;
+                // Free the cell for the next lap
+                cell.m_Sequence.store(pos + m_Mask + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0)
+        {
+            return false;
+        }
+        else
+        {
+            pos = m_PopPos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void ProfilingEntryRingBuffer::PopAll(std::vector<ProfilingEntry>& entries)
+{
+    ProfilingEntry entry;
+    while (Pop(entry))
+    {
+        entries.push_back(entry);
+    }
+}
+
+void ProfilingEntryRingBuffer::Clear()
+{
+    ProfilingEntry entry;
+    while (Pop(entry))
+    {
+    }
+}
+
+size_t ProfilingEntryRingBuffer::GetSize() const
+{
+    size_t pushPos = m_PushPos.load(std::memory_order_relaxed);
+    size_t popPos  = m_PopPos.load(std::memory_order_relaxed);
+    return pushPos > popPos ? pushPos - popPos : 0;
+}
+
+size_t ProfilingEntryRingBuffer::GetCapacity() const
+{
+    return m_Mask + 1;
+}
+
+uint64_t ProfilingEntryRingBuffer::GetNumDropped() const
+{
+    return m_NumDropped.load(std::memory_order_relaxed);
+}
+
+ProfilingEntries::ThreadBuffer::ThreadBuffer(bool dumped)
+    : m_Retired(false)
+{
+    m_Entries[static_cast<size_t>(Consumer::Report)] =
+        std::make_unique<ProfilingEntryRingBuffer>(g_ProfilingEntriesPerThread);
+    if (dumped)
+    {
+        m_Entries[static_cast<size_t>(Consumer::Dump)] =
+            std::make_unique<ProfilingEntryRingBuffer>(g_ProfilingEntriesPerThread);
+    }
+}
+
+ProfilingEntryRingBuffer* ProfilingEntries::ThreadBuffer::GetEntries(Consumer consumer)
+{
+    return m_Entries[static_cast<size_t>(consumer)].get();
+}
+
+bool ProfilingEntries::ThreadBuffer::IsEmpty()
+{
+    for (const std::unique_ptr<ProfilingEntryRingBuffer>& entries : m_Entries)
+    {
+        if (entries && entries->GetSize() != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+ProfilingEntries::ProfilingEntries()
+    : m_DumpEnabled(false)
+    , m_NumRetiredBuffers(0)
+    , m_NumDroppedByRemovedBuffers()
+{}
+
+ProfilingEntries::~ProfilingEntries() = default;
+
+void ProfilingEntries::EnableDump()
+{
+    m_DumpEnabled.store(true, std::memory_order_relaxed);
+}
+
+ProfilingEntries::ThreadBuffer& ProfilingEntries::GetThreadBuffer()
+{
+    // Registers the buffer of the thread on its first entry and retires it when the thread exits
+    struct Registration
+    {
+        Registration(ProfilingEntries& entries)
+            : m_Entries(entries)
+            , m_Buffer(std::make_shared<ThreadBuffer>(entries.m_DumpEnabled.load(std::memory_order_relaxed)))
+        {
+            std::lock_guard<std::mutex> lock(entries.m_Mutex);
+            entries.m_ThreadBuffers.push_back(m_Buffer);
+        }
+
+        ~Registration()
+        {
+            m_Entries.RetireThreadBuffer(m_Buffer);
+        }
+
+        ProfilingEntries& m_Entries;
+        std::shared_ptr<ThreadBuffer> m_Buffer;
+    };
+    thread_local Registration registration(*this);
+
+    return *registration.m_Buffer;
+}
+
+void ProfilingEntries::RetireThreadBuffer(const std::shared_ptr<ThreadBuffer>& buffer)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    buffer->m_Retired.store(true, std::memory_order_release);
+    ++m_NumRetiredBuffers;
+
+    // Don't keep the buffer if there is nothing left in it to pop
+    if (buffer->IsEmpty())
+    {
+        auto it = std::find(m_ThreadBuffers.begin(), m_ThreadBuffers.end(), buffer);
+        assert(it != m_ThreadBuffers.end());
+        RemoveThreadBuffer(it);
+    }
+    else if (m_NumRetiredBuffers > g_MaxRetiredThreadBuffers)
+    {
+        // The buffers are in the order their threads first pushed an entry, which approximates the oldest
+        auto oldest = std::find_if(m_ThreadBuffers.begin(), m_ThreadBuffers.end(),
+                                   [](const std::shared_ptr<ThreadBuffer>& b) { return b->m_Retired.load(); });
+        assert(oldest != m_ThreadBuffers.end());
+        RemoveThreadBuffer(oldest);
+    }
+}
+
+ProfilingEntries::ThreadBufferIt ProfilingEntries::RemoveThreadBuffer(ThreadBufferIt it)
+{
+    ThreadBuffer& buffer = **it;
+    for (size_t i = 0; i < static_cast<size_t>(Consumer::NumValues); ++i)
+    {
+        if (buffer.m_Entries[i])
+        {
+            m_NumDroppedByRemovedBuffers[i] += buffer.m_Entries[i]->GetNumDropped() + buffer.m_Entries[i]->GetSize();
+        }
+    }
+    if (buffer.m_Retired.load(std::memory_order_relaxed))
+    {
+        --m_NumRetiredBuffers;
+    }
+    return m_ThreadBuffers.erase(it);
+}
+
+bool ProfilingEntries::Push(const ProfilingEntry& entry)
+{
+    ThreadBuffer& buffer = GetThreadBuffer();
+    bool pushed          = true;
+    for (const std::unique_ptr<ProfilingEntryRingBuffer>& entries : buffer.m_Entries)
+    {
+        if (entries)
+        {
+            pushed = entries->Push(entry) && pushed;
+        }
+    }
+    return pushed;
+}
+
+void ProfilingEntries::PopAll(Consumer consumer, std::vector<ProfilingEntry>& entries)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (auto it = m_ThreadBuffers.begin(); it != m_ThreadBuffers.end();)
+    {
+        ThreadBuffer& buffer = **it;
+        // Check before popping, so that no entry pushed before the thread retired is missed
+        bool retired = buffer.m_Retired.load(std::memory_order_acquire);
+        if (ProfilingEntryRingBuffer* consumerEntries = buffer.GetEntries(consumer))
+        {
+            consumerEntries->PopAll(entries);
+        }
+        // The buffer is kept until every consumer has popped the entries of the thread
+        if (retired && buffer.IsEmpty())
+        {
+            it = RemoveThreadBuffer(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void ProfilingEntries::Clear()
+{
+    std::vector<ProfilingEntry> entries;
+    PopAll(Consumer::Report, entries);
+    PopAll(Consumer::Dump, entries);
+}
+
+bool ProfilingEntries::IsThreadBufferHalfFull(Consumer consumer)
+{
+    const ProfilingEntryRingBuffer* entries = GetThreadBuffer().GetEntries(consumer);
+    return entries != nullptr && entries->GetSize() >= entries->GetCapacity() / 2;
+}
+
+uint64_t ProfilingEntries::GetNumDropped(Consumer consumer)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    uint64_t numDropped = m_NumDroppedByRemovedBuffers[static_cast<size_t>(consumer)];
+    for (const std::shared_ptr<ThreadBuffer>& buffer : m_ThreadBuffers)
+    {
+        if (const ProfilingEntryRingBuffer* entries = buffer->GetEntries(consumer))
+        {
+            numDropped += entries->GetNumDropped();
+        }
+    }
+    return numDropped;
+}
+
+uint64_t AllocateTimelineEventId()
+{
+    return g_NextTimelineEventId.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RecordLifetimeEvent(LifetimeEvent& event,
+                         std::atomic<uint64_t>& numLive,
+                         ProfilingEntry::Type type,
+                         ProfilingEntry::MetadataCategory category)
+{
+    ProfilingEntry entry;
+    entry.m_Timestamp = std::chrono::high_resolution_clock::now();
+    entry.m_Type      = type;
+    if (type == ProfilingEntry::Type::TimelineEventStart)
+    {
+        event.m_Id      = AllocateTimelineEventId();
+        event.m_Session = g_ProfilingSession.load(std::memory_order_relaxed);
+        ++numLive;
+    }
+    else
+    {
+        assert(type == ProfilingEntry::Type::TimelineEventEnd);
+        if (event.m_Id == 0 || event.m_Session != g_ProfilingSession.load(std::memory_order_relaxed))
+        {
+            // If the profiling was enabled after creating this object then no event should be registered.
+            return;
+        }
+        --numLive;
+    }
+    entry.m_Id               = event.m_Id;
+    entry.m_MetadataCategory = category;
+    entry.m_MetadataValue    = 0;
+    g_ProfilingEntries.Push(entry);
 }
 
 bool ApplyConfiguration(Configuration config)
@@ -31,9 +344,10 @@ bool ApplyConfiguration(Configuration config)
 
     if (hasKernelConfigureSucceeded && g_CurrentConfiguration.m_EnableProfiling && !config.m_EnableProfiling)
     {
-        g_ProfilingEntries.clear();
-        g_BufferToLifetimeEventId.clear();
-        g_InferenceToLifetimeEventId.clear();
+        g_ProfilingEntries.Clear();
+        ++g_ProfilingSession;
+        g_NumLiveBuffers      = 0;
+        g_NumLiveInferences   = 0;
         g_NextTimelineEventId = g_DriverLibraryEventIdBase;
     }
 
@@ -72,6 +386,21 @@ Configuration GetConfigFromString(const char* str)
         {
             g_DumpFile = optionValue;
         }
+        else if (optionName == "dumpFormat")
+        {
+            if (optionValue == "json")
+            {
+                g_DumpFormat = DumpFormat::Json;
+            }
+            else if (optionValue == "binary")
+            {
+                g_DumpFormat = DumpFormat::Binary;
+            }
+            else
+            {
+                std::cerr << "Unknown dumpFormat " << optionValue << ", it must be json or binary\n";
+            }
+        }
         else if (optionName == "firmwareBufferSize")
         {
             config.m_FirmwareBufferSize = static_cast<uint32_t>(std::stoul(optionValue));
@@ -167,6 +496,11 @@ Configuration GetDefaultConfiguration()
         return Configuration();
     }
     auto config = GetConfigFromString(profilingConfigEnv);
+    if (!g_DumpFile.empty())
+    {
+        // Before anything is profiled, so that the dump has every entry
+        g_ProfilingEntries.EnableDump();
+    }
 
     if (!ApplyConfiguration(config))
     {
@@ -175,14 +509,17 @@ Configuration GetDefaultConfiguration()
     return config;
 }
 
+// Defined before g_CurrentConfiguration, which may reset them when initialized
+ProfilingEntries g_ProfilingEntries;
+std::atomic<uint64_t> g_NextTimelineEventId(g_DriverLibraryEventIdBase);
+std::atomic<uint64_t> g_ProfilingSession(0);
+std::atomic<uint64_t> g_NumLiveBuffers(0);
+std::atomic<uint64_t> g_NumLiveInferences(0);
+
 std::string g_DumpFile               = "";
+DumpFormat g_DumpFormat              = DumpFormat::Json;
 Configuration g_CurrentConfiguration = GetDefaultConfiguration();
 
-std::vector<ProfilingEntry> g_ProfilingEntries              = {};
-std::map<Buffer*, uint64_t> g_BufferToLifetimeEventId       = {};
-std::map<Inference*, uint64_t> g_InferenceToLifetimeEventId = {};
-uint64_t g_NextTimelineEventId                              = g_DriverLibraryEventIdBase;
-
 bool Configure(Configuration config)
 {
     bool isConfigurationApplied = ApplyConfiguration(config);
@@ -195,9 +532,8 @@ bool Configure(Configuration config)
 
 std::vector<ProfilingEntry> ReportNewProfilingData()
 {
-    std::vector<ProfilingEntry> res(std::move(g_ProfilingEntries));
-
-    g_ProfilingEntries.clear();
+    std::vector<ProfilingEntry> res;
+    g_ProfilingEntries.PopAll(ProfilingEntries::Consumer::Report, res);
     return res;
 }
 
@@ -211,9 +547,9 @@ uint64_t GetCounterValue(PollCounterName counter)
     switch (counter)
     {
         case PollCounterName::DriverLibraryNumLiveBuffers:
-            return g_BufferToLifetimeEventId.size();
+            return g_NumLiveBuffers;
         case PollCounterName::DriverLibraryNumLiveInferences:
-            return g_InferenceToLifetimeEventId.size();
+            return g_NumLiveInferences;
         case PollCounterName::KernelDriverNumMailboxMessagesSent:    // Deliberate fallthrough
         case PollCounterName::KernelDriverNumMailboxMessagesReceived:
             return GetKernelDriverCounterValue(counter);
@@ -8,7 +8,9 @@
 
 #include <uapi/ethosn_shared.h>
 
-#include <map>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -17,9 +19,6 @@ namespace ethosn
 namespace driver_library
 {
 
-class Buffer;
-class Inference;
-
 namespace profiling
 {
 
@@ -41,56 +40,167 @@ inline uint64_t CreateCounterValue(uint64_t counterValue)
 
 Configuration GetConfigFromString(const char* str);
 
+/// A fixed-size queue of profiling entries, which any number of threads may push to and pop from without locking.
+/// Entries pushed while the queue is full are dropped, so that the memory used by profiling stays bounded however
+/// long it is left on.
+/// Each cell holds a sequence number which tells whether the cell is ready to be written or read in the current lap
+/// of the buffer, as in Dmitry Vyukov's bounded MPMC queue.
+class ProfilingEntryRingBuffer
+{
+public:
+    /// The capacity must be a power of two.
+    explicit ProfilingEntryRingBuffer(size_t capacity);
+
+    /// Returns false if the entry was dropped because the buffer is full.
+    bool Push(const ProfilingEntry& entry);
+    /// Returns false if the buffer is empty.
+    bool Pop(ProfilingEntry& entry);
+    /// Pops the entries in the buffer, appending them to entries.
+    void PopAll(std::vector<ProfilingEntry>& entries);
+    void Clear();
+
+    /// The number of entries in the buffer, which may be out of date as soon as it is returned.
+    size_t GetSize() const;
+    size_t GetCapacity() const;
+    /// The number of entries dropped since the buffer was created.
+    uint64_t GetNumDropped() const;
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> m_Sequence;
+        ProfilingEntry m_Entry;
+    };
+
+    std::unique_ptr<Cell[]> m_Cells;
+    size_t m_Mask;
+    // Keep the positions on separate cache lines, as producers and consumers update them independently
+    alignas(64) std::atomic<size_t> m_PushPos;
+    alignas(64) std::atomic<size_t> m_PopPos;
+    std::atomic<uint64_t> m_NumDropped;
+};
+
+/// The profiling entries recorded by every thread. Each thread pushes to a ring buffer of its own, so that recording
+/// an entry never contends with other threads, and the buffers are merged when the entries are popped.
+/// Every entry is kept for each consumer, so that dumping the entries to g_DumpFile doesn't take them from
+/// ReportNewProfilingData() or the other way round.
+/// Threads which exit leave their buffer behind until it has been emptied, unless it is already empty. At most
+/// g_MaxRetiredThreadBuffers are left behind, after which the entries of the oldest are dropped.
+/// There is a single instance, g_ProfilingEntries, as the buffer of each thread is found through a thread_local.
+class ProfilingEntries
+{
+public:
+    enum class Consumer
+    {
+        /// ReportNewProfilingData()
+        Report,
+        /// The writer of g_DumpFile, which only gets entries once EnableDump() has been called.
+        Dump,
+        NumValues,
+    };
+
+    ProfilingEntries();
+    ~ProfilingEntries();
+
+    /// Keeps a copy of the entries for Consumer::Dump. This must be called before any entries are pushed, as the
+    /// buffers of threads which have already pushed an entry don't keep a copy.
+    void EnableDump();
+
+    /// Returns false if the entry was dropped because the buffer of the calling thread is full.
+    bool Push(const ProfilingEntry& entry);
+    /// Pops the entries of every thread for the consumer, appending them to entries. The entries of each thread stay
+    /// in the order they were pushed in.
+    void PopAll(Consumer consumer, std::vector<ProfilingEntry>& entries);
+    /// Pops the entries for every consumer.
+    void Clear();
+
+    /// Whether the buffer of the calling thread for the consumer is at least half full.
+    bool IsThreadBufferHalfFull(Consumer consumer);
+    /// The number of entries the consumer has missed because they were dropped, since profiling started.
+    uint64_t GetNumDropped(Consumer consumer);
+
+private:
+    struct ThreadBuffer
+    {
+        explicit ThreadBuffer(bool dumped);
+
+        /// Null if the consumer doesn't get the entries of this thread.
+        ProfilingEntryRingBuffer* GetEntries(Consumer consumer);
+        bool IsEmpty();
+
+        std::unique_ptr<ProfilingEntryRingBuffer> m_Entries[static_cast<size_t>(Consumer::NumValues)];
+        /// Set when the thread exits, after which it pushes no more entries.
+        std::atomic<bool> m_Retired;
+    };
+
+    using ThreadBufferIt = std::vector<std::shared_ptr<ThreadBuffer>>::iterator;
+
+    ThreadBuffer& GetThreadBuffer();
+    /// Called when the thread of the buffer exits.
+    void RetireThreadBuffer(const std::shared_ptr<ThreadBuffer>& buffer);
+    /// Must be called with m_Mutex held. Any entries left in the buffer are counted as dropped.
+    ThreadBufferIt RemoveThreadBuffer(ThreadBufferIt it);
+
+    std::atomic<bool> m_DumpEnabled;
+
+    /// Protects the members below, but not the contents of the buffers.
+    std::mutex m_Mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> m_ThreadBuffers;
+    /// The number of buffers in m_ThreadBuffers whose thread has exited.
+    size_t m_NumRetiredBuffers;
+    /// The number of entries dropped by the buffers of threads which have since been removed, for each consumer.
+    uint64_t m_NumDroppedByRemovedBuffers[static_cast<size_t>(Consumer::NumValues)];
+};
+
+/// The number of entries the buffer of each thread can hold before further entries are dropped.
+const size_t g_ProfilingEntriesPerThread = 4096;
+/// The number of buffers of exited threads which are kept until their entries are popped, so that the memory they
+/// hold stays bounded if the entries are never popped.
+const size_t g_MaxRetiredThreadBuffers = 64;
+
+/// The timeline event of the lifetime of a Buffer or Inference, which is stored in its impl.
+struct LifetimeEvent
+{
+    /// 0 if the start of the lifetime was not recorded, because profiling was disabled at the time.
+    uint64_t m_Id = 0;
+    /// The value of g_ProfilingSession when the start of the lifetime was recorded.
+    uint64_t m_Session = 0;
+};
+
 extern Configuration g_CurrentConfiguration;
-extern std::vector<ProfilingEntry> g_ProfilingEntries;
-extern uint64_t g_NextTimelineEventId;
+extern ProfilingEntries g_ProfilingEntries;
+extern std::atomic<uint64_t> g_NextTimelineEventId;
+/// Incremented whenever profiling is disabled, so that the lifetimes which started before then are not ended.
+extern std::atomic<uint64_t> g_ProfilingSession;
 
-extern std::map<Buffer*, uint64_t> g_BufferToLifetimeEventId;
-extern std::map<Inference*, uint64_t> g_InferenceToLifetimeEventId;
+extern std::atomic<uint64_t> g_NumLiveBuffers;
+extern std::atomic<uint64_t> g_NumLiveInferences;
 
-/// If set, automatically dump profiling entries and counters to this file after each inference.
+/// If set, profiling entries and counters are streamed to this file in g_DumpFormat as inferences complete.
 /// Set by the environment variable parsed in GetDefaultConfiguration().
 extern std::string g_DumpFile;
 
+enum class DumpFormat
+{
+    /// The JSON array written by DumpProfilingData(), which is kept complete as entries are appended to it.
+    Json,
+    /// The binary trace format of DumpProfiling.hpp, which is cheaper to write. It can be converted to JSON offline,
+    /// with ConvertProfilingTraceToJson() or the ethosn_convert_profiling_trace tool.
+    Binary,
+};
+
+/// The format of g_DumpFile. Set by the dumpFormat option of the environment variable parsed in
+/// GetDefaultConfiguration(), either "json" (the default) or "binary".
+extern DumpFormat g_DumpFormat;
+
 /// ProfilingInternal functions
 /// @{
-uint64_t GetNextTimeLineEventId();
-template <typename T>
-void RecordLifetimeEvent(T* object,
-                         std::map<T*, uint64_t>& objectToLifetimeEventId,
+uint64_t AllocateTimelineEventId();
+/// Records the start or end of the lifetime of an object, counting the live objects in numLive.
+void RecordLifetimeEvent(LifetimeEvent& event,
+                         std::atomic<uint64_t>& numLive,
                          profiling::ProfilingEntry::Type type,
-                         profiling::ProfilingEntry::MetadataCategory category)
-{
-    using namespace std::chrono;
-    using namespace profiling;
-    time_point<high_resolution_clock> timestamp = high_resolution_clock::now();
-    ProfilingEntry entry;
-    entry.m_Timestamp = timestamp;
-    entry.m_Type      = type;
-    uint64_t id;
-    if (type == ProfilingEntry::Type::TimelineEventStart)
-    {
-        id                              = g_NextTimelineEventId;
-        objectToLifetimeEventId[object] = id;
-        GetNextTimeLineEventId();
-    }
-    else
-    {
-        assert(type == ProfilingEntry::Type::TimelineEventEnd);
-        auto it = objectToLifetimeEventId.find(object);
-        if (it == objectToLifetimeEventId.end())
-        {
-            // If the profiling was enabled after creating this object then no event should be registered.
-            return;
-        }
-        id = it->second;
-        objectToLifetimeEventId.erase(it);
-    }
-    entry.m_Id               = id;
-    entry.m_MetadataCategory = category;
-    entry.m_MetadataValue    = 0;
-    g_ProfilingEntries.push_back(entry);
-}
+                         profiling::ProfilingEntry::MetadataCategory category);
 /// @}
 
 /// Implemented by the backend (model, kernel module etc.)
@@ -0,0 +1,26 @@
+//
+// Copyright © 2020 Arm Limited. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "../include/ethosn_driver_library/Profiling.hpp"
+
+#include <iostream>
+
+// Converts a binary profiling trace, which is dumped when the ETHOSN_DRIVER_LIBRARY_PROFILING_CONFIG environment
+// variable has the options dumpFile=<trace file> dumpFormat=binary, to the JSON format which is dumped by default.
+int main(int argc, char* argv[])
+{
+    if (argc != 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <trace file> <JSON file>\n";
+        return 1;
+    }
+
+    if (!ethosn::driver_library::profiling::ConvertProfilingTraceToJson(argv[1], argv[2]))
+    {
+        std::cerr << "Failed to convert " << argv[1] << " to " << argv[2] << "\n";
+        return 1;
+    }
+    return 0;
+}
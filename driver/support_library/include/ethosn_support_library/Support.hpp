@@ -101,6 +101,20 @@ struct CompilationOptions
     bool m_StrictPrecision =
         false;    // Set this to true to create a more precise but slower compiled network. At the moment this will disable the concat optimization.
 
+    /// Number of threads used to encode the weights of each layer. The output is identical regardless of this value.
+    /// 1 (the default) encodes on the calling thread only. 0 means use as many threads as there are hardware threads.
+    uint32_t m_NumWeightEncoderThreads = 1;
+
+    /// Number of threads used to find which plans are compatible with each other when cascading.
+    /// The output is identical regardless of this value.
+    /// 1 (the default) uses the calling thread only. 0 means use as many threads as there are hardware threads.
+    uint32_t m_NumCascadingThreads = 1;
+
+    /// If not empty, encoded weights are cached in files in this directory and reused by later compilations,
+    /// including those in other processes, which encode identical weights for the same hardware.
+    /// The directory is created if it does not exist.
+    std::string m_WeightEncoderCacheDir;
+
     /// If enabled, files containing details of the compilation process will be dumped to m_DebugDir.
     /// These can be helpful for debugging compilation issues.
     DebugInfo m_DebugInfo;
@@ -971,6 +985,62 @@ inline std::ostream& operator<<(std::ostream& os, const OutputBufferInfo& value)
     return os;
 }
 
+/// Read-only view of a contiguous block of bytes owned by another object (e.g. a CompiledNetwork).
+/// The view is only valid for as long as the object that provided it.
+class DataView
+{
+public:
+    DataView()
+        : m_Data(nullptr)
+        , m_Size(0)
+    {}
+
+    DataView(const uint8_t* data, size_t size)
+        : m_Data(data)
+        , m_Size(size)
+    {}
+
+    DataView(const std::vector<uint8_t>& data)
+        : m_Data(data.data())
+        , m_Size(data.size())
+    {}
+
+    const uint8_t* data() const
+    {
+        return m_Data;
+    }
+
+    size_t size() const
+    {
+        return m_Size;
+    }
+
+    bool empty() const
+    {
+        return m_Size == 0;
+    }
+
+    const uint8_t* begin() const
+    {
+        return m_Data;
+    }
+
+    const uint8_t* end() const
+    {
+        return m_Data + m_Size;
+    }
+
+    const uint8_t& operator[](size_t idx) const
+    {
+        assert(idx < m_Size);
+        return m_Data[idx];
+    }
+
+private:
+    const uint8_t* m_Data;
+    size_t m_Size;
+};
+
 /// The result of compiling a network using Compile(...).
 class CompiledNetwork
 {
@@ -998,6 +1068,12 @@ public:
     /// All the constant data to be DMA'd by the firmware, e.g. weights
     virtual const std::vector<uint8_t>& GetConstantDmaData() const = 0;
 
+    /// Views of the same data as GetConstantControlUnitData() and GetConstantDmaData().
+    /// When the CompiledNetwork was deserialized from a file these refer directly to the memory-mapped file,
+    /// whereas the std::vector accessors above require a copy of the data, so these should be preferred.
+    virtual DataView GetConstantControlUnitDataView() const = 0;
+    virtual DataView GetConstantDmaDataView() const = 0;
+
     /// Details of the individual buffers contained in the data returned by GetConstantControlUnitData().
     virtual const std::vector<BufferInfo>& GetConstantControlUnitDataBufferInfos() const = 0;
     /// Details of the individual buffers contained in the data returned by GetConstantDmaData().
@@ -1074,6 +1150,12 @@ const Version GetLibraryVersion();
 // Call the Compiler to process the network and get the outputs that need to be passed through Arm NN to the driver lib
 std::vector<std::unique_ptr<CompiledNetwork>> Compile(const Network& network, const CompilationOptions& options);
 
+// Creates a key which identifies the result of compiling the given network with the given options, for use in caches
+// of compiled networks. Two networks and sets of options which have equal keys compile to identical CompiledNetworks.
+// The key is the 32-byte SHA-256 digest of the library version, the capabilities, every operation of the network
+// along with its parameters and constant data, and the options which affect the compiled networks.
+std::vector<uint8_t> GetCompilationKey(const Network& network, const CompilationOptions& options);
+
 // Call the Compiler to estimate the performance of the network
 NetworkPerformanceData EstimatePerformance(const Network& network,
                                            const CompilationOptions& compilationOptions,
@@ -1105,8 +1187,20 @@ std::vector<char> GetFwAndHwCapabilities(EthosNVariant variant, uint32_t sramSiz
 // Deserialize a serialized CompiledNetwork from the specified input stream
 // If the versions used for serialization and deserialization are different
 //      an exception of type VersionMismatchException will be thrown.
+// If the stream ends early or fails an exception of type std::invalid_argument will be thrown.
 std::unique_ptr<CompiledNetwork> DeserializeCompiledNetwork(std::istream&);
 
+// Deserialize a serialized CompiledNetwork from the file at the specified path, or from the specified
+// file descriptor (which is not closed and does not need to be kept open). A file descriptor is read from its
+// current offset to the end of the file, and its offset is left unchanged.
+// The file is memory-mapped where supported and the constant data of the returned CompiledNetwork is not copied
+// (see CompiledNetwork::GetConstantDmaDataView()). The file must not be modified while the CompiledNetwork exists.
+// An exception of type std::invalid_argument will be thrown if the file cannot be read or is truncated and
+// an exception of type VersionMismatchException if the versions used for serialization and deserialization
+// are different.
+std::unique_ptr<CompiledNetwork> DeserializeCompiledNetwork(const char* path);
+std::unique_ptr<CompiledNetwork> DeserializeCompiledNetwork(int fd);
+
 /// Creates a new Network
 ///
 /// @param caps: An opaque block of data containing the capabilities of the hardware and the firmware.
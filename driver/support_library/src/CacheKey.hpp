@@ -0,0 +1,87 @@
+//
+// Copyright © 2020 Arm Limited. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include "../include/ethosn_support_library/Support.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace ethosn
+{
+namespace support_library
+{
+
+/// Helpers for building the keys of caches, which are byte strings containing everything a cached result
+/// depends on. Keys can be large as they include constant data, so caches identify their entries by the
+/// digest of the key instead.
+namespace cache_key
+{
+
+/// The size in bytes of the digests returned by Digest().
+constexpr size_t g_DigestSize = 32;
+
+template <typename T>
+void Append(std::vector<uint8_t>& dst, const T* src, size_t count)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Only plain data can be appended to a cache key");
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(src);
+    dst.insert(dst.end(), bytes, bytes + count * sizeof(T));
+}
+
+template <typename T>
+void Append(std::vector<uint8_t>& dst, const T& src)
+{
+    Append(dst, &src, 1);
+}
+
+inline void Append(std::vector<uint8_t>& dst, const QuantizationInfo& quantInfo)
+{
+    Append(dst, quantInfo.GetZeroPoint());
+    const QuantizationScales& scales = quantInfo.GetScales();
+    Append(dst, static_cast<uint64_t>(scales.size()));
+    for (float scale : scales)
+    {
+        Append(dst, scale);
+    }
+    const QuantizationInfo::QuantizationDim dim = quantInfo.GetQuantizationDim();
+    Append(dst, dim.has_value());
+    Append(dst, dim.has_value() ? dim.value() : 0U);
+}
+
+inline void Append(std::vector<uint8_t>& dst, const TensorInfo& tensorInfo)
+{
+    Append(dst, tensorInfo.m_Dimensions);
+    Append(dst, tensorInfo.m_DataType);
+    Append(dst, tensorInfo.m_DataFormat);
+    Append(dst, tensorInfo.m_QuantizationInfo);
+}
+
+inline void Append(std::vector<uint8_t>& dst, const Padding& padding)
+{
+    Append(dst, padding.m_Top);
+    Append(dst, padding.m_Bottom);
+    Append(dst, padding.m_Left);
+    Append(dst, padding.m_Right);
+}
+
+inline void Append(std::vector<uint8_t>& dst, const ConvolutionInfo& convInfo)
+{
+    Append(dst, convInfo.m_Padding);
+    Append(dst, convInfo.m_Stride.m_X);
+    Append(dst, convInfo.m_Stride.m_Y);
+    Append(dst, convInfo.m_OutputQuantizationInfo);
+}
+
+/// Returns the SHA-256 digest of a key.
+std::vector<uint8_t> Digest(const std::vector<uint8_t>& key);
+
+}    // namespace cache_key
+
+}    // namespace support_library
+}    // namespace ethosn
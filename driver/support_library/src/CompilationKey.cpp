@@ -0,0 +1,285 @@
+//
+// Copyright © 2020 Arm Limited. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "../include/ethosn_support_library/Support.hpp"
+
+#include "CacheKey.hpp"
+#include "ConcreteOperations.hpp"
+#include "Network.hpp"
+
+namespace ethosn
+{
+namespace support_library
+{
+
+using cache_key::Append;
+
+namespace
+{
+
+/// Must be incremented whenever a change is made to the contents of the key which is not already covered by
+/// the library version.
+constexpr uint32_t g_CompilationKeyVersion = 1;
+
+/// Identifies the type of each operation in the key.
+enum class OperationTag : uint8_t
+{
+    Input,
+    Output,
+    Constant,
+    Convolution,
+    DepthwiseConvolution,
+    TransposeConvolution,
+    Concatenation,
+    Split,
+    Addition,
+    FullyConnected,
+    Relu,
+    LeakyRelu,
+    Requantize,
+    Softmax,
+    Sigmoid,
+    Pooling,
+    Reshape,
+    DepthToSpace,
+    SpaceToDepth,
+    Transpose,
+    Resize,
+    EstimateOnly,
+};
+
+/// Appends every operation of a network to a key, in the order they appear in the network.
+/// Each operation is written as its type, its id, the producers of its inputs, its outputs and its parameters
+/// (including the data of constants), so that two networks have the same key only if they are identical.
+class NetworkKeyWriter : public INetworkVisitor
+{
+public:
+    explicit NetworkKeyWriter(std::vector<uint8_t>& key)
+        : m_Key(key)
+    {}
+
+    void Visit(Input& input) final
+    {
+        AppendOperation(OperationTag::Input, input);
+    }
+
+    void Visit(Output& output) final
+    {
+        AppendOperation(OperationTag::Output, output);
+    }
+
+    void Visit(Constant& constant) final
+    {
+        AppendOperation(OperationTag::Constant, constant);
+        const std::vector<uint8_t>& data = constant.GetDataVector();
+        Append(m_Key, static_cast<uint64_t>(data.size()));
+        Append(m_Key, data.data(), data.size());
+    }
+
+    void Visit(Convolution& convolution) final
+    {
+        AppendOperation(OperationTag::Convolution, convolution);
+        Append(m_Key, convolution.GetWeights().GetId());
+        Append(m_Key, convolution.GetBias().GetId());
+        Append(m_Key, convolution.GetConvolutionInfo());
+    }
+
+    void Visit(DepthwiseConvolution& depthwiseConvolution) final
+    {
+        AppendOperation(OperationTag::DepthwiseConvolution, depthwiseConvolution);
+        Append(m_Key, depthwiseConvolution.GetWeights().GetId());
+        Append(m_Key, depthwiseConvolution.GetBias().GetId());
+        Append(m_Key, depthwiseConvolution.GetConvolutionInfo());
+    }
+
+    void Visit(TransposeConvolution& transposeConvolution) final
+    {
+        AppendOperation(OperationTag::TransposeConvolution, transposeConvolution);
+        Append(m_Key, transposeConvolution.GetWeights().GetId());
+        Append(m_Key, transposeConvolution.GetBias().GetId());
+        Append(m_Key, transposeConvolution.GetConvolutionInfo());
+    }
+
+    void Visit(Concatenation& concatenation) final
+    {
+        AppendOperation(OperationTag::Concatenation, concatenation);
+        Append(m_Key, concatenation.GetConcatenationInfo().m_Axis);
+        Append(m_Key, concatenation.GetConcatenationInfo().m_OutputQuantizationInfo);
+    }
+
+    void Visit(Split& split) final
+    {
+        AppendOperation(OperationTag::Split, split);
+        const SplitInfo& splitInfo = split.GetSplitInfo();
+        Append(m_Key, splitInfo.m_Axis);
+        Append(m_Key, static_cast<uint64_t>(splitInfo.m_Sizes.size()));
+        Append(m_Key, splitInfo.m_Sizes.data(), splitInfo.m_Sizes.size());
+    }
+
+    void Visit(Addition& addition) final
+    {
+        AppendOperation(OperationTag::Addition, addition);
+    }
+
+    void Visit(FullyConnected& fullyConnected) final
+    {
+        AppendOperation(OperationTag::FullyConnected, fullyConnected);
+        Append(m_Key, fullyConnected.GetWeights().GetId());
+        Append(m_Key, fullyConnected.GetBias().GetId());
+        Append(m_Key, fullyConnected.GetFullyConnectedInfo().m_OutputQuantizationInfo);
+    }
+
+    void Visit(Relu& relu) final
+    {
+        AppendOperation(OperationTag::Relu, relu);
+        Append(m_Key, relu.GetReluInfo().m_LowerBound);
+        Append(m_Key, relu.GetReluInfo().m_UpperBound);
+    }
+
+    void Visit(LeakyRelu& leakyRelu) final
+    {
+        AppendOperation(OperationTag::LeakyRelu, leakyRelu);
+        Append(m_Key, leakyRelu.GetLeakyReluInfo().m_Alpha);
+        Append(m_Key, leakyRelu.GetLeakyReluInfo().m_OutputQuantizationInfo);
+    }
+
+    void Visit(Requantize& requantize) final
+    {
+        AppendOperation(OperationTag::Requantize, requantize);
+        Append(m_Key, requantize.GetRequantizeInfo().m_OutputQuantizationInfo);
+    }
+
+    void Visit(Softmax& softmax) final
+    {
+        AppendOperation(OperationTag::Softmax, softmax);
+    }
+
+    void Visit(Sigmoid& sigmoid) final
+    {
+        AppendOperation(OperationTag::Sigmoid, sigmoid);
+    }
+
+    void Visit(Pooling& pooling) final
+    {
+        AppendOperation(OperationTag::Pooling, pooling);
+        const PoolingInfo& poolingInfo = pooling.GetPoolingInfo();
+        Append(m_Key, poolingInfo.m_PoolingSizeX);
+        Append(m_Key, poolingInfo.m_PoolingSizeY);
+        Append(m_Key, poolingInfo.m_PoolingStrideX);
+        Append(m_Key, poolingInfo.m_PoolingStrideY);
+        Append(m_Key, poolingInfo.m_Padding);
+        Append(m_Key, poolingInfo.m_PoolingType);
+    }
+
+    void Visit(Reshape& reshape) final
+    {
+        AppendOperation(OperationTag::Reshape, reshape);
+        Append(m_Key, reshape.GetReshapeInfo());
+    }
+
+    void Visit(DepthToSpace& depthToSpace) final
+    {
+        AppendOperation(OperationTag::DepthToSpace, depthToSpace);
+        Append(m_Key, depthToSpace.GetDepthToSpaceInfo().m_BlockSize);
+    }
+
+    void Visit(SpaceToDepth& spaceToDepth) final
+    {
+        AppendOperation(OperationTag::SpaceToDepth, spaceToDepth);
+        Append(m_Key, spaceToDepth.GetSpaceToDepthInfo().m_BlockSize);
+    }
+
+    void Visit(Transpose& transpose) final
+    {
+        AppendOperation(OperationTag::Transpose, transpose);
+        Append(m_Key, transpose.GetTransposeInfo().m_Permutation);
+    }
+
+    void Visit(Resize& resize) final
+    {
+        AppendOperation(OperationTag::Resize, resize);
+        const ResizeInfo& resizeInfo = resize.GetResizeInfo();
+        Append(m_Key, resizeInfo.m_Algo);
+        Append(m_Key, resizeInfo.m_NewHeight);
+        Append(m_Key, resizeInfo.m_NewWidth);
+        Append(m_Key, resizeInfo.m_OutputQuantizationInfo);
+    }
+
+    void Visit(EstimateOnly& estimateOnly) final
+    {
+        // The output infos are the only parameters
+        AppendOperation(OperationTag::EstimateOnly, estimateOnly);
+    }
+
+private:
+    void AppendOperation(OperationTag tag, const Operation& operation)
+    {
+        Append(m_Key, tag);
+        Append(m_Key, operation.GetId());
+
+        const std::vector<const Operand*> inputs = operation.GetInputs();
+        Append(m_Key, static_cast<uint32_t>(inputs.size()));
+        for (const Operand* input : inputs)
+        {
+            Append(m_Key, input->GetProducer().GetId());
+            Append(m_Key, input->GetProducerOutputIndex());
+        }
+
+        const std::vector<Operand>& outputs = operation.GetOutputs();
+        Append(m_Key, static_cast<uint32_t>(outputs.size()));
+        for (const Operand& output : outputs)
+        {
+            Append(m_Key, output.GetTensorInfo());
+        }
+    }
+
+    std::vector<uint8_t>& m_Key;
+};
+
+}    // namespace
+
+std::vector<uint8_t> GetCompilationKey(const Network& network, const CompilationOptions& options)
+{
+    std::vector<uint8_t> key;
+
+    Append(key, g_CompilationKeyVersion);
+    const Version version = GetLibraryVersion();
+    Append(key, version.Major);
+    Append(key, version.Minor);
+    Append(key, version.Patch);
+
+    const std::vector<char>& capabilities = network.GetCapabilities();
+    Append(key, static_cast<uint64_t>(capabilities.size()));
+    Append(key, capabilities.data(), capabilities.size());
+    Append(key, network.IsEstimationMode());
+
+    // Only the options which affect the compiled networks. The number of threads, the weight encoder cache and
+    // the debug files do not, but dumping RAM adds commands to the command stream.
+    Append(key, options.m_Strategy0);
+    Append(key, options.m_Strategy1);
+    Append(key, options.m_Strategy3);
+    Append(key, options.m_Strategy4);
+    Append(key, options.m_Strategy6);
+    Append(key, options.m_Strategy7);
+    Append(key, options.m_BlockConfig16x16);
+    Append(key, options.m_BlockConfig32x8);
+    Append(key, options.m_BlockConfig8x32);
+    Append(key, options.m_BlockConfig16x8);
+    Append(key, options.m_BlockConfig8x16);
+    Append(key, options.m_BlockConfig8x8);
+    Append(key, options.m_EnableIntermediateCompression);
+    Append(key, options.m_DisableWinograd);
+    Append(key, options.m_StrictPrecision);
+    Append(key, options.m_CompilerAlgorithm);
+    Append(key, options.m_DebugInfo.m_DumpRam);
+    Append(key, options.m_DebugInfo.m_InitialSramDump);
+
+    network.Accept(NetworkKeyWriter(key));
+
+    return cache_key::Digest(key);
+}
+
+}    // namespace support_library
+}    // namespace ethosn
@@ -9,6 +9,7 @@
 #include "IEstimationStrategy.hpp"
 #include "Optimization.hpp"
 #include "SramAllocator.hpp"
+#include "ThreadPool.hpp"
 #include "cascading/Cascading.hpp"
 #include "nonCascading/ConversionPass.hpp"
 #include "nonCascading/McePlePass.hpp"
@@ -16,9 +17,12 @@
 #include "nonCascading/PlePass.hpp"
 #include "nonCascading/Section.hpp"
 
+#include <ethosn_utils/Filesystem.hpp>
+
 #include <fstream>
 #include <numeric>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 namespace ethosn
@@ -124,8 +128,12 @@ Compiler::Compiler(const Network& network,
     , m_Capabilities(fwAndHwCapabilities)
     , m_CompilationOptions(compilationOptions)
     , m_EnableCascading(false)
+    , m_WeightEncoderThreadPool(WeightEncoderOptions::CreateThreadPool(compilationOptions))
+    , m_WeightEncoderOptions(compilationOptions, m_WeightEncoderThreadPool.get())
     , m_EstimationOptions(estimationOptions)
     , m_PerfEstimate(false)
+    , m_GraphOptimizer(CreateGraphOptimizer())
+    , m_PassCreationNextNodeIdx(0)
 {
     SetDebuggingContext(DebuggingContext(&compilationOptions.m_DebugInfo));
 }
@@ -253,7 +261,8 @@ NetworkPerformanceData Compiler::PrivateEstimatePerformance()
     }
     else
     {
-        Cascading cascadingEstimate(m_EstimationOptions, m_CompilationOptions, m_Capabilities);
+        Cascading cascadingEstimate(m_EstimationOptions, m_CompilationOptions, m_Capabilities,
+                                    m_WeightEncoderOptions);
         m_PerformanceStream = cascadingEstimate.Estimate(m_Graph);
     }
 
@@ -269,7 +278,15 @@ void Compiler::Convert()
 
 void Compiler::Optimize()
 {
-    OptimizeGraph(m_Graph);
+    m_GraphOptimizer.Optimize(m_Graph);
+
+    const DebuggingContext& debuggingContext = GetConstDebuggingContext();
+    if (debuggingContext.m_DebugInfo->m_DumpDebugFiles >= CompilationOptions::DebugLevel::Medium)
+    {
+        std::ofstream stream(debuggingContext.GetAbsolutePathOutputFileName(
+            m_EnableCascading ? "Cascaded_OptimizationStats.txt" : "NonCascaded_OptimizationStats.txt"));
+        m_GraphOptimizer.PrintRuleStats(stream);
+    }
 }
 
 void Compiler::Prepare()
@@ -282,11 +299,22 @@ void Compiler::Prepare()
     // repeatedly modify the graph thinking it will help, but it does not.
     // Note that this limit is set based on the size of the *initial* graph (the graph may grow in size).
     const uint32_t maxIterations = static_cast<uint32_t>(m_Graph.GetNodes().size()) * 10;
+
+    // Start from scratch, as nothing is known about the graph yet.
+    m_Passes.clear();
+    m_PassCreationSteps.clear();
+    m_PassCreationOrder.clear();
+    m_PassCreationSramAllocator = SramAllocator(m_Capabilities.GetTotalSramSize() / m_Capabilities.GetNumberOfSrams());
+    // Keep track of the nodes changed by each iteration so that only the passes affected by them are re-created.
+    ModifiedNodesRecorder modifiedNodes(m_Graph);
     while (true)
     {
         DumpGraph(std::string("GraphPrepareIteration") + std::to_string(numIterations) + "_Pre");
 
         Optimize();
+        InvalidatePasses(modifiedNodes.m_ModifiedNodes);
+        modifiedNodes.m_ModifiedNodes.clear();
+        modifiedNodes.m_RemovedNodes.clear();
         CreatePasses();
 
         DumpGraph(std::string("GraphPrepareIteration") + std::to_string(numIterations) + "_Post");
@@ -356,13 +384,6 @@ void Compiler::Prepare()
 
             throw NotSupportedException(errorMsg.c_str());
         }
-
-        // Clear passes for next attempt
-        m_Passes.clear();
-        for (auto& n : m_Graph.GetNodes())
-        {
-            n->Reset();
-        }
     }
 }
 
@@ -379,28 +400,116 @@ bool Compiler::IsPrepared()
     return true;
 }
 
+void Compiler::InvalidatePasses(const std::unordered_set<Node*>& modifiedNodes)
+{
+    std::vector<Node*> sortedNodes = m_Graph.GetNodesSorted();
+
+    // Find the first node which is not the same as when the passes were created, either because it has been
+    // modified or because the order of the nodes has changed.
+    size_t firstChangedNodeIdx = 0;
+    while (firstChangedNodeIdx < sortedNodes.size() && firstChangedNodeIdx < m_PassCreationOrder.size())
+    {
+        Node* n = sortedNodes[firstChangedNodeIdx];
+        if (m_PassCreationOrder[firstChangedNodeIdx] != std::make_pair(n->GetId(), n->GetPreparationHintsVersion()) ||
+            modifiedNodes.count(n) > 0)
+        {
+            break;
+        }
+        ++firstChangedNodeIdx;
+    }
+
+    // Passes are created greedily in order, so everything from the first step which could have depended on
+    // a changed node onwards needs to be re-created. Fix graph hints are not reset between iterations and later
+    // steps may overwrite the hints set by earlier ones, so everything from the first step which set any hints is
+    // re-created too. This leaves the passes and hints as they would be if every pass was re-created.
+    auto firstInvalidStep =
+        std::find_if(m_PassCreationSteps.begin(), m_PassCreationSteps.end(), [&](const PassCreationStep& step) {
+            return step.m_LastDependentNodeIdx >= firstChangedNodeIdx || step.m_SetFixGraphHints;
+        });
+    size_t numValidPasses = m_Passes.size();
+    if (firstInvalidStep != m_PassCreationSteps.end())
+    {
+        m_PassCreationNextNodeIdx   = firstInvalidStep->m_NodeIdx;
+        m_PassCreationSramAllocator = firstInvalidStep->m_SramAllocator;
+        numValidPasses              = firstInvalidStep->m_NumPasses;
+        m_PassCreationSteps.erase(firstInvalidStep, m_PassCreationSteps.end());
+    }
+    else
+    {
+        m_PassCreationNextNodeIdx = firstChangedNodeIdx;
+    }
+
+    // Nodes before this point all belong to steps that are still valid. After it, only the nodes included in
+    // the remaining passes are still valid.
+    for (size_t i = m_PassCreationNextNodeIdx; i < sortedNodes.size(); ++i)
+    {
+        Pass* pass = sortedNodes[i]->GetPass();
+        if (pass == nullptr || pass->GetId() >= numValidPasses)
+        {
+            sortedNodes[i]->Reset();
+        }
+    }
+    m_Passes.resize(numValidPasses);
+}
+
 void Compiler::CreatePasses()
 {
     std::vector<IStrategy*> strategies = utils::GetRawPointers(m_AllowedStrategies);
     std::vector<Node*> sortedNodes     = m_Graph.GetNodesSorted();
-    SramAllocator sramAllocator(m_Capabilities.GetTotalSramSize() / m_Capabilities.GetNumberOfSrams());
+    SramAllocator& sramAllocator       = m_PassCreationSramAllocator;
+
+    std::unordered_map<Node*, size_t> nodeIdxs;
+    for (size_t i = 0; i < sortedNodes.size(); ++i)
+    {
+        nodeIdxs[sortedNodes[i]] = i;
+    }
+
+    // Creating a pass may set the fix graph hints of any node it depends on, so detect that from the total of the
+    // hints versions of all the nodes.
+    auto getFixGraphHintsVersion = [&sortedNodes]() {
+        return std::accumulate(sortedNodes.begin(), sortedNodes.end(), uint64_t{ 0 },
+                               [](uint64_t sum, Node* n) { return sum + n->GetFixGraphHintsVersion(); });
+    };
+    uint64_t fixGraphHintsVersion = getFixGraphHintsVersion();
 
     // forward estimate flag is passed on to the function CreateGreedily to allow FCAF for
     // strategies 6, 7 and arbitrary tensor shape. This happens if the forward-looking
     // SPA is configured.
     bool forwardEst = m_PerfEstimate && !m_EstimationOptions.m_Current;
 
-    for (Node* n : sortedNodes)
+    for (size_t nodeIdx = m_PassCreationNextNodeIdx; nodeIdx < sortedNodes.size(); ++nodeIdx)
     {
+        Node* n = sortedNodes[nodeIdx];
         if (n->GetPass() == nullptr)
         {
+            // Besides the nodes before this one, a pass starting here can only depend on the nodes that could be
+            // included in it and on their outputs.
+            size_t lastDependentNodeIdx = nodeIdx;
+            for (Node* current = n; current != nullptr; current = GetNextLinearNodeForInclusionInPass<Node>(current))
+            {
+                for (Edge* output : current->GetOutputs())
+                {
+                    lastDependentNodeIdx = std::max(lastDependentNodeIdx, nodeIdxs.at(output->GetDestination()));
+                }
+            }
+            // PrepareAfterPassAssignment frees an input once all the nodes consuming it have been attempted.
+            for (Edge* input : n->GetInputs())
+            {
+                for (Edge* sibling : input->GetSource()->GetOutputs())
+                {
+                    lastDependentNodeIdx = std::max(lastDependentNodeIdx, nodeIdxs.at(sibling->GetDestination()));
+                }
+            }
+            m_PassCreationSteps.push_back({ nodeIdx, lastDependentNodeIdx, m_Passes.size(), sramAllocator, false });
+
             const size_t passId = m_Passes.size();
             std::unique_ptr<Pass> p;
             if (!p)
             {
                 p = McePlePass::CreateGreedily(m_Capabilities, passId, strategies, m_AllowedBlockConfigs,
                                                m_CompilationOptions.m_EnableIntermediateCompression,
-                                               !m_CompilationOptions.m_DisableWinograd, n, sramAllocator, forwardEst);
+                                               !m_CompilationOptions.m_DisableWinograd,
+                                               m_WeightEncoderOptions, n, sramAllocator, forwardEst);
             }
             if (!p)
             {
@@ -416,8 +525,19 @@ void Compiler::CreatePasses()
                 m_Passes.push_back(std::move(p));
             }
             n->PrepareAfterPassAssignment(sramAllocator);
+
+            const uint64_t newFixGraphHintsVersion       = getFixGraphHintsVersion();
+            m_PassCreationSteps.back().m_SetFixGraphHints = newFixGraphHintsVersion != fixGraphHintsVersion;
+            fixGraphHintsVersion                          = newFixGraphHintsVersion;
         }
     }
+    m_PassCreationNextNodeIdx = sortedNodes.size();
+
+    m_PassCreationOrder.clear();
+    for (Node* n : sortedNodes)
+    {
+        m_PassCreationOrder.emplace_back(n->GetId(), n->GetPreparationHintsVersion());
+    }
 }
 
 void Compiler::CreateSections()
@@ -558,6 +678,29 @@ uint32_t CompiledNetworkImpl::GetIntermediateDataSize() const
     return GetLastBufferAddress(*maxBuffer);
 }
 
+const std::vector<uint8_t>& CompiledNetworkImpl::GetConstantDmaData() const
+{
+    if (m_MappedFile)
+    {
+        std::call_once(m_ConstantDmaDataCopied, [this]() {
+            m_ConstantDmaData.assign(m_MappedConstantDmaData.begin(), m_MappedConstantDmaData.end());
+        });
+    }
+    return m_ConstantDmaData;
+}
+
+const std::vector<uint8_t>& CompiledNetworkImpl::GetConstantControlUnitData() const
+{
+    if (m_MappedFile)
+    {
+        std::call_once(m_ConstantControlUnitDataCopied, [this]() {
+            m_ConstantControlUnitData.assign(m_MappedConstantControlUnitData.begin(),
+                                             m_MappedConstantControlUnitData.end());
+        });
+    }
+    return m_ConstantControlUnitData;
+}
+
 template <typename T>
 void CompiledNetworkImpl::Serialize(std::ostream& out, const std::vector<T>& data) const
 {
@@ -565,10 +708,7 @@ void CompiledNetworkImpl::Serialize(std::ostream& out, const std::vector<T>& dat
 
     size_t size = data.size();
     out.write(reinterpret_cast<char*>(&size), sizeof(uint32_t));
-    for (size_t i = 0; i < size; ++i)
-    {
-        out.write(reinterpret_cast<const char*>(&data[i]), sizeof(T));
-    }
+    out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(size * sizeof(T)));
 }
 
 void CompiledNetworkImpl::Serialize(std::ostream& out) const
@@ -581,8 +721,8 @@ void CompiledNetworkImpl::Serialize(std::ostream& out) const
     out.write(version.c_str(), size);
 
     // Serialize the vectors
-    Serialize(out, m_ConstantDmaData);
-    Serialize(out, m_ConstantControlUnitData);
+    Serialize(out, GetConstantDmaData());
+    Serialize(out, GetConstantControlUnitData());
     Serialize(out, m_InputBufferInfos);
     Serialize(out, m_OutputBufferInfos);
     Serialize(out, m_ConstantControlUnitDataBufferInfos);
@@ -595,27 +735,28 @@ void CompiledNetworkImpl::Deserialize(std::istream& in, std::vector<T>& data)
 {
     static_assert(std::is_trivially_copyable<T>::value, "Type must be trivially copyable");
 
-    auto size = Read<uint32_t>(in);
+    const uint32_t size = Read<uint32_t>(in);
 
-    for (uint32_t i = 0; i < size; ++i)
+    // The size has not been validated, so read the data in chunks rather than allocating it all up front. A corrupt
+    // or truncated stream then fails having allocated at most one chunk more than the stream actually contained.
+    constexpr size_t chunkSize = std::max<size_t>((1U << 20) / sizeof(T), 1);
+    data.clear();
+    while (data.size() < size)
     {
-        T item = T();
-        char data_buffer[sizeof(T)];
-        in.read(data_buffer, sizeof(T));
-        std::memcpy(&item, data_buffer, sizeof(T));
-        data.emplace_back(item);
+        const size_t offset = data.size();
+        const size_t count  = std::min<size_t>(size - offset, chunkSize);
+        data.resize(offset + count);
+        in.read(reinterpret_cast<char*>(data.data() + offset), static_cast<std::streamsize>(count * sizeof(T)));
+        if (!in)
+        {
+            throw std::invalid_argument("Serialized Compiled Network is truncated");
+        }
     }
 }
 
-void CompiledNetworkImpl::Deserialize(std::istream& in)
+void CompiledNetworkImpl::CheckVersion(const std::string& versionString)
 {
-    // Check that input stream was serialized with the same version of the support library
-    auto size = Read<uint32_t>(in);
-    assert(size < 100);
-
-    char versionString[100];
-    in.read(versionString, size);
-    Version version(versionString);
+    Version version(versionString.c_str());
     Version libraryVersion = GetLibraryVersion();
 
     if (libraryVersion.Major != version.Major || libraryVersion.Minor < version.Minor)
@@ -626,6 +767,24 @@ void CompiledNetworkImpl::Deserialize(std::istream& in)
 
         throw VersionMismatchException(str.str().c_str());
     }
+}
+
+void CompiledNetworkImpl::Deserialize(std::istream& in)
+{
+    // Check that input stream was serialized with the same version of the support library
+    auto size = Read<uint32_t>(in);
+    if (size >= 100)
+    {
+        throw std::invalid_argument("Serialized Compiled Network has an invalid header");
+    }
+
+    char versionString[100];
+    in.read(versionString, size);
+    if (!in)
+    {
+        throw std::invalid_argument("Serialized Compiled Network is truncated");
+    }
+    CheckVersion(std::string(versionString, size));
 
     // Deserialize vectors
     Deserialize(in, m_ConstantDmaData);
@@ -637,11 +796,98 @@ void CompiledNetworkImpl::Deserialize(std::istream& in)
     Deserialize(in, m_IntermediateDataBufferInfos);
 }
 
+namespace
+{
+
+/// Reads the output of CompiledNetworkImpl::Serialize() from memory.
+class MemoryReader
+{
+public:
+    MemoryReader(const uint8_t* data, size_t size)
+        : m_Data(data)
+        , m_Size(size)
+        , m_Pos(0)
+    {}
+
+    /// Returns a view of the next numBytes bytes and advances past them.
+    DataView ReadBytes(size_t numBytes)
+    {
+        if (numBytes > m_Size - m_Pos)
+        {
+            throw std::invalid_argument("Serialized Compiled Network is truncated");
+        }
+        DataView result(m_Data + m_Pos, numBytes);
+        m_Pos += numBytes;
+        return result;
+    }
+
+    template <typename T>
+    T Read()
+    {
+        T result;
+        std::memcpy(&result, ReadBytes(sizeof(T)).data(), sizeof(T));
+        return result;
+    }
+
+    /// Returns a view of the bytes of a vector written by CompiledNetworkImpl::Serialize().
+    template <typename T>
+    DataView ReadVectorBytes()
+    {
+        const uint32_t size = Read<uint32_t>();
+        return ReadBytes(static_cast<size_t>(size) * sizeof(T));
+    }
+
+    template <typename T>
+    void ReadVector(std::vector<T>& data)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Type must be trivially copyable");
+
+        const DataView bytes = ReadVectorBytes<T>();
+        data.resize(bytes.size() / sizeof(T));
+        std::memcpy(data.data(), bytes.data(), bytes.size());
+    }
+
+private:
+    const uint8_t* m_Data;
+    size_t m_Size;
+    size_t m_Pos;
+};
+
+}    // namespace
+
+void CompiledNetworkImpl::Deserialize(std::shared_ptr<const ethosn::utils::MappedFile> file)
+{
+    MemoryReader reader(file->GetData(), file->GetSize());
+
+    // Check that the file was serialized with the same version of the support library
+    const DataView versionString = reader.ReadVectorBytes<char>();
+    if (versionString.size() >= 100)
+    {
+        throw std::invalid_argument("Serialized Compiled Network has an invalid header");
+    }
+    CheckVersion(std::string(versionString.begin(), versionString.end()));
+
+    // The constant data is left in the file. The buffer infos are small so are copied.
+    m_MappedConstantDmaData         = reader.ReadVectorBytes<uint8_t>();
+    m_MappedConstantControlUnitData = reader.ReadVectorBytes<uint8_t>();
+    reader.ReadVector(m_InputBufferInfos);
+    reader.ReadVector(m_OutputBufferInfos);
+    reader.ReadVector(m_ConstantControlUnitDataBufferInfos);
+    reader.ReadVector(m_ConstantDmaDataBufferInfos);
+    reader.ReadVector(m_IntermediateDataBufferInfos);
+
+    m_MappedFile = std::move(file);
+}
+
 template <typename T>
 T CompiledNetworkImpl::Read(std::istream& in)
 {
     T data;
     in.read(reinterpret_cast<char*>(&data), sizeof(data));
+    if (!in)
+    {
+        throw std::invalid_argument("Serialized Compiled Network is truncated");
+    }
     return data;
 }
 
@@ -7,7 +7,10 @@
 
 #include "DebuggingContext.hpp"
 #include "Graph.hpp"
+#include "Optimization.hpp"
+#include "SramAllocator.hpp"
 #include "Utils.hpp"
+#include "WeightEncoder.hpp"
 #include "nonCascading/BufferManager.hpp"
 
 #include <ethosn_command_stream/CommandStreamBuffer.hpp>
@@ -15,9 +18,16 @@
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <mutex>
+#include <unordered_set>
 
 namespace ethosn
 {
+namespace utils
+{
+class MappedFile;
+}
+
 namespace support_library
 {
 
@@ -56,6 +66,7 @@ private:
     /// @{
     void Prepare();
     void Optimize();
+    void InvalidatePasses(const std::unordered_set<Node*>& modifiedNodes);
     void CreatePasses();
     bool IsPrepared();
     void CreateSections();
@@ -81,6 +92,10 @@ private:
     HardwareCapabilities m_Capabilities;
     const CompilationOptions& m_CompilationOptions;
     bool m_EnableCascading;
+    /// Shared by every weight encoder created while compiling, so that threads are only started once per
+    /// compilation rather than once per encoder.
+    std::unique_ptr<ThreadPool> m_WeightEncoderThreadPool;
+    WeightEncoderOptions m_WeightEncoderOptions;
     /// @}
 
     /// Performance estimation
@@ -92,10 +107,34 @@ private:
 
     /// Intermediate data/results
     /// @{
+    /// Kept for the lifetime of the Compiler so that statistics are accumulated over every call to Optimize().
+    GraphOptimizer m_GraphOptimizer;
     /// The internal graph of nodes. Modified as we progress through compilation.
     Graph m_Graph;
     /// The list of Passes we have built up so far.
     std::vector<std::unique_ptr<Pass>> m_Passes;
+    /// State recorded by CreatePasses so that the next preparation iteration only needs to re-create the Passes
+    /// which may have been affected by the changes made to the graph. See InvalidatePasses.
+    /// @{
+    struct PassCreationStep
+    {
+        /// Index (in m_PassCreationOrder) of the node that a Pass was attempted to be created from.
+        size_t m_NodeIdx;
+        /// Index of the last node whose state could have affected the result of this step.
+        size_t m_LastDependentNodeIdx;
+        /// The number of Passes and the state of the SramAllocator before this step.
+        size_t m_NumPasses;
+        SramAllocator m_SramAllocator;
+        /// Set if this step set the fix graph hints of any node.
+        bool m_SetFixGraphHints;
+    };
+    std::vector<PassCreationStep> m_PassCreationSteps;
+    /// The id and preparation hints version of each node, in the order they were visited by CreatePasses.
+    std::vector<std::pair<NodeId, uint32_t>> m_PassCreationOrder;
+    /// Where CreatePasses should continue from, and the state of the SramAllocator at that point.
+    size_t m_PassCreationNextNodeIdx;
+    SramAllocator m_PassCreationSramAllocator;
+    /// @}
     /// The list of Sections we have built up so far.
     std::vector<std::unique_ptr<Section>> m_Sections;
     BufferManager m_BufferManager;
@@ -131,14 +170,18 @@ public:
                         const std::map<uint32_t, CompilerBufferInfo>& buffers,
                         const std::set<uint32_t>& operationIds);
 
-    virtual const std::vector<uint8_t>& GetConstantDmaData() const override
+    virtual const std::vector<uint8_t>& GetConstantDmaData() const override;
+
+    virtual const std::vector<uint8_t>& GetConstantControlUnitData() const override;
+
+    virtual DataView GetConstantDmaDataView() const override
     {
-        return m_ConstantDmaData;
+        return m_MappedFile ? m_MappedConstantDmaData : DataView(m_ConstantDmaData);
     }
 
-    virtual const std::vector<uint8_t>& GetConstantControlUnitData() const override
+    virtual DataView GetConstantControlUnitDataView() const override
     {
-        return m_ConstantControlUnitData;
+        return m_MappedFile ? m_MappedConstantControlUnitData : DataView(m_ConstantControlUnitData);
     }
 
     virtual const std::set<uint32_t>& GetOperationIds() const override
@@ -183,12 +226,31 @@ public:
 
     virtual void Deserialize(std::istream& in);
 
+    /// Deserializes from a file containing the output of Serialize(). The constant data is not copied out of
+    /// the file, which is kept alive for the lifetime of this object.
+    void Deserialize(std::shared_ptr<const ethosn::utils::MappedFile> file);
+
 private:
     template <typename T>
     T Read(std::istream& in);
 
-    std::vector<uint8_t> m_ConstantDmaData;
-    std::vector<uint8_t> m_ConstantControlUnitData;
+    static void CheckVersion(const std::string& versionString);
+
+    /// When deserialized from a file, these are only populated from the mapped data the first time
+    /// they are requested.
+    /// @{
+    mutable std::vector<uint8_t> m_ConstantDmaData;
+    mutable std::vector<uint8_t> m_ConstantControlUnitData;
+    mutable std::once_flag m_ConstantDmaDataCopied;
+    mutable std::once_flag m_ConstantControlUnitDataCopied;
+    /// @}
+
+    /// The file this was deserialized from (if any), which the mapped views point into.
+    /// @{
+    std::shared_ptr<const ethosn::utils::MappedFile> m_MappedFile;
+    DataView m_MappedConstantDmaData;
+    DataView m_MappedConstantControlUnitData;
+    /// @}
 
     std::vector<InputBufferInfo> m_InputBufferInfos;
     std::vector<OutputBufferInfo> m_OutputBufferInfos;
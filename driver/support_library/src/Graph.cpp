@@ -39,9 +39,11 @@ Node::Node(NodeId id,
     , m_OptimizationHint(OptimizationHint::DontCare)
     , m_LocationHint(LocationHint::PreferSram)
     , m_CompressionHint(CompressionHint::PreferCompressed)
+    , m_PreparationHintsVersion(0)
     , m_FixGraphConvertOutputTo(CompilerDataFormat::NONE)
     , m_FixGraphLocationHint(LocationHint::PreferSram)
     , m_FixGraphCompressionHint(CompressionHint::PreferCompressed)
+    , m_FixGraphHintsVersion(0)
     , m_Pass(nullptr)
     , m_Location(BufferLocation::None)
     , m_CompressionFormat(CompilerDataCompressedFormat::NONE)
@@ -394,6 +396,7 @@ ethosn::support_library::OptimizationHint Node::GetOptimizationHint() const
 void Node::SetOptimizationHint(OptimizationHint v)
 {
     m_OptimizationHint = v;
+    ++m_PreparationHintsVersion;
 }
 
 ethosn::support_library::LocationHint Node::GetLocationHint() const
@@ -404,6 +407,7 @@ ethosn::support_library::LocationHint Node::GetLocationHint() const
 void Node::SetLocationHint(LocationHint v)
 {
     m_LocationHint = v;
+    ++m_PreparationHintsVersion;
 }
 
 ethosn::support_library::CompressionHint Node::GetCompressionHint() const
@@ -414,6 +418,12 @@ ethosn::support_library::CompressionHint Node::GetCompressionHint() const
 void Node::SetCompressionHint(CompressionHint v)
 {
     m_CompressionHint = v;
+    ++m_PreparationHintsVersion;
+}
+
+uint32_t Node::GetPreparationHintsVersion() const
+{
+    return m_PreparationHintsVersion;
 }
 
 ethosn::support_library::CompilerDataFormat Node::GetFixGraphConvertOutputTo() const
@@ -424,6 +434,7 @@ ethosn::support_library::CompilerDataFormat Node::GetFixGraphConvertOutputTo() c
 void Node::SetFixGraphConvertOutputTo(CompilerDataFormat v)
 {
     m_FixGraphConvertOutputTo = v;
+    ++m_FixGraphHintsVersion;
 }
 
 ethosn::support_library::LocationHint Node::GetFixGraphLocationHint() const
@@ -434,6 +445,7 @@ ethosn::support_library::LocationHint Node::GetFixGraphLocationHint() const
 void Node::SetFixGraphLocationHint(LocationHint v)
 {
     m_FixGraphLocationHint = v;
+    ++m_FixGraphHintsVersion;
 }
 
 ethosn::support_library::CompressionHint Node::GetFixGraphCompressionHint() const
@@ -444,6 +456,12 @@ ethosn::support_library::CompressionHint Node::GetFixGraphCompressionHint() cons
 void Node::SetFixGraphCompressionHint(CompressionHint v)
 {
     m_FixGraphCompressionHint = v;
+    ++m_FixGraphHintsVersion;
+}
+
+uint32_t Node::GetFixGraphHintsVersion() const
+{
+    return m_FixGraphHintsVersion;
 }
 
 uint32_t Node::GetBufferId() const
@@ -602,25 +620,55 @@ const std::vector<std::unique_ptr<ethosn::support_library::Node>>& Graph::GetNod
 
 std::vector<Node*> Graph::GetNodesSorted() const
 {
-    std::vector<Node*> targets;
-    for (const auto& node : m_Nodes)
+    if (!m_SortedNodesValid)
     {
-        if (node.get()->GetOutputs().size() == 0)
+        SortNodes();
+        m_SortedNodesValid = true;
+    }
+    return m_SortedNodes;
+}
+
+void Graph::SortNodes() const
+{
+    // Depth-first search from each node which has no outputs, visiting the inputs of each node in order and
+    // adding each node once all of its inputs have been added (equivalent to utils::GraphTopologicalSort).
+    // The search uses an explicit stack and the visited state is stored in a flat array indexed by NodeId,
+    // as this is called frequently on large graphs.
+    m_SortedNodes.clear();
+    m_SortedNodes.reserve(m_Nodes.size());
+    std::vector<bool> visited(m_NextNodeId, false);
+    // Each entry is a node being visited and the index of the next of its inputs to visit.
+    std::vector<std::pair<Node*, size_t>> stack;
+
+    for (const std::unique_ptr<Node>& target : m_Nodes)
+    {
+        if (!target->GetOutputs().empty() || visited[target->GetId()])
         {
-            targets.push_back(node.get());
+            continue;
+        }
+        visited[target->GetId()] = true;
+        stack.emplace_back(target.get(), 0);
+        while (!stack.empty())
+        {
+            Node* node         = stack.back().first;
+            size_t& inputIndex = stack.back().second;
+            if (inputIndex < node->GetInputs().size())
+            {
+                Node* input = node->GetInputs()[inputIndex]->GetSource();
+                ++inputIndex;
+                if (!visited[input->GetId()])
+                {
+                    visited[input->GetId()] = true;
+                    stack.emplace_back(input, 0);
+                }
+            }
+            else
+            {
+                m_SortedNodes.push_back(node);
+                stack.pop_back();
+            }
         }
     }
-    std::vector<Node*> sorted;
-    utils::GraphTopologicalSort<Node*, std::vector<Node*>>(
-        targets,
-        [](Node* n) {
-            std::vector<Node*> result;
-            std::transform(n->GetInputs().begin(), n->GetInputs().end(), std::back_inserter(result),
-                           [](auto x) -> Node* { return x->GetSource(); });
-            return result;
-        },
-        sorted);
-    return sorted;
 }
 
 const std::vector<std::unique_ptr<Edge>>& Graph::GetEdges() const
@@ -631,6 +679,11 @@ const std::vector<std::unique_ptr<Edge>>& Graph::GetEdges() const
 void Graph::AddNode(std::unique_ptr<Node> node)
 {
     m_Nodes.push_back(std::move(node));
+    m_SortedNodesValid = false;
+    for (GraphObserver* observer : m_Observers)
+    {
+        observer->NodeAdded(m_Nodes.back().get());
+    }
 }
 
 void Graph::Connect(Node* source, Node* destination, int32_t insertionIdx)
@@ -648,6 +701,12 @@ void Graph::Connect(Node* source, Node* destination, int32_t insertionIdx)
     {
         destination->m_Inputs.insert(destination->m_Inputs.begin() + insertionIdx, e2);
     }
+    m_SortedNodesValid = false;
+
+    for (GraphObserver* observer : m_Observers)
+    {
+        observer->EdgeChanged(source, destination);
+    }
 }
 
 void Graph::RemoveNode(Node* node)
@@ -662,16 +721,23 @@ void Graph::RemoveNode(Node* node)
     {
         RemoveEdge(e);
     }
+    for (GraphObserver* observer : m_Observers)
+    {
+        observer->NodeRemoving(node);
+    }
     {
         auto it = std::find_if(m_Nodes.begin(), m_Nodes.end(),
                                [&](const std::unique_ptr<Node>& n) { return n.get() == node; });
         assert(it != m_Nodes.end());
         m_Nodes.erase(it);
     }
+    m_SortedNodesValid = false;
 }
 
 int32_t Graph::RemoveEdge(Edge* edge)
 {
+    Node* source      = edge->GetSource();
+    Node* destination = edge->GetDestination();
     {
         auto it = std::find(edge->GetSource()->m_Outputs.begin(), edge->GetSource()->m_Outputs.end(), edge);
         assert(it != edge->GetSource()->m_Outputs.end());
@@ -690,6 +756,11 @@ int32_t Graph::RemoveEdge(Edge* edge)
         assert(it != m_Edges.end());
         m_Edges.erase(it);
     }
+    m_SortedNodesValid = false;
+    for (GraphObserver* observer : m_Observers)
+    {
+        observer->EdgeChanged(source, destination);
+    }
     return index;
 }
 
@@ -754,6 +825,46 @@ void Graph::InsertNodeAfter(Node* position, Node* newNode)
     Connect(position, newNode);
 }
 
+void Graph::AddObserver(GraphObserver* observer)
+{
+    m_Observers.push_back(observer);
+}
+
+void Graph::RemoveObserver(GraphObserver* observer)
+{
+    auto it = std::find(m_Observers.begin(), m_Observers.end(), observer);
+    assert(it != m_Observers.end());
+    m_Observers.erase(it);
+}
+
+ModifiedNodesRecorder::ModifiedNodesRecorder(Graph& graph)
+    : m_Graph(graph)
+{
+    m_Graph.AddObserver(this);
+}
+
+ModifiedNodesRecorder::~ModifiedNodesRecorder()
+{
+    m_Graph.RemoveObserver(this);
+}
+
+void ModifiedNodesRecorder::NodeAdded(Node* node)
+{
+    m_ModifiedNodes.insert(node);
+}
+
+void ModifiedNodesRecorder::NodeRemoving(Node* node)
+{
+    m_ModifiedNodes.erase(node);
+    m_RemovedNodes.push_back(node);
+}
+
+void ModifiedNodesRecorder::EdgeChanged(Node* source, Node* destination)
+{
+    m_ModifiedNodes.insert(source);
+    m_ModifiedNodes.insert(destination);
+}
+
 NodeId Graph::GenerateNodeId()
 {
     return m_NextNodeId++;
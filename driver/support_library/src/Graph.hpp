@@ -11,6 +11,7 @@
 #include "nonCascading/BufferManager.hpp"
 
 #include <memory>
+#include <unordered_set>
 #include <vector>
 
 namespace ethosn
@@ -141,6 +142,10 @@ public:
 
     CompressionHint GetCompressionHint() const;
     void SetCompressionHint(CompressionHint v);
+
+    /// Incremented whenever any of the preparation hints (including those of derived nodes) are set, so that
+    /// the results of preparation which depend on them can be invalidated.
+    uint32_t GetPreparationHintsVersion() const;
     /// @}
 
     /// Fix graph hints
@@ -153,6 +158,9 @@ public:
 
     CompressionHint GetFixGraphCompressionHint() const;
     void SetFixGraphCompressionHint(CompressionHint v);
+
+    /// Incremented whenever any of the fix graph hints (including those of derived nodes) are set.
+    uint32_t GetFixGraphHintsVersion() const;
     /// @}
 
     /// Preparation results
@@ -238,11 +246,13 @@ protected:
     OptimizationHint m_OptimizationHint;
     LocationHint m_LocationHint;
     CompressionHint m_CompressionHint;
+    uint32_t m_PreparationHintsVersion;
 
     // Fix graph hints
     CompilerDataFormat m_FixGraphConvertOutputTo;
     LocationHint m_FixGraphLocationHint;
     CompressionHint m_FixGraphCompressionHint;
+    uint32_t m_FixGraphHintsVersion;
 
     // Set during preparation, but cleared after each iteration
     bool m_PreparationAttempted;
@@ -278,6 +288,21 @@ private:
     Node* m_Destination;
 };
 
+/// Interface for being notified of changes to the structure of a Graph. See Graph::AddObserver.
+class GraphObserver
+{
+public:
+    virtual ~GraphObserver()
+    {}
+
+    /// Called after a node has been added to the graph (at which point it will not have any connections).
+    virtual void NodeAdded(Node* node) = 0;
+    /// Called when a node is about to be removed from the graph (after it has been disconnected).
+    virtual void NodeRemoving(Node* node) = 0;
+    /// Called after an edge between the given nodes has been added or removed.
+    virtual void EdgeChanged(Node* source, Node* destination) = 0;
+};
+
 class Graph
 {
 public:
@@ -285,6 +310,9 @@ public:
         : m_Nodes()
         , m_Edges()
         , m_NextNodeId(0)
+        , m_Observers()
+        , m_SortedNodes()
+        , m_SortedNodesValid(false)
     {}
 
     Graph(const Network& network,
@@ -293,6 +321,8 @@ public:
           bool strictPrecision = false);
 
     const std::vector<std::unique_ptr<Node>>& GetNodes() const;
+    /// Gets all the nodes sorted such that all inputs to a node are before the node itself.
+    /// The order is cached and only recalculated after the graph has been modified.
     std::vector<Node*> GetNodesSorted() const;
 
     const std::vector<std::unique_ptr<Edge>>& GetEdges() const;
@@ -328,13 +358,46 @@ public:
 
     void DumpToDotFormat(std::ostream& stream) const;
 
+    /// Registers an observer to be notified of all subsequent changes to the structure of this graph,
+    /// until it is removed with RemoveObserver. The observer is not owned by the graph.
+    void AddObserver(GraphObserver* observer);
+    void RemoveObserver(GraphObserver* observer);
+
 private:
     void AddNode(std::unique_ptr<Node> node);
     NodeId GenerateNodeId();
+    void SortNodes() const;
 
     std::vector<std::unique_ptr<Node>> m_Nodes;
     std::vector<std::unique_ptr<Edge>> m_Edges;
     NodeId m_NextNodeId;
+    std::vector<GraphObserver*> m_Observers;
+
+    /// Cached result of GetNodesSorted(), which is invalidated whenever the graph is modified.
+    /// @{
+    mutable std::vector<Node*> m_SortedNodes;
+    mutable bool m_SortedNodesValid;
+    /// @}
+};
+
+/// Records which nodes are affected by changes to the structure of a graph, for as long as it exists.
+class ModifiedNodesRecorder : public GraphObserver
+{
+public:
+    ModifiedNodesRecorder(Graph& graph);
+    ~ModifiedNodesRecorder();
+
+    void NodeAdded(Node* node) override;
+    void NodeRemoving(Node* node) override;
+    void EdgeChanged(Node* source, Node* destination) override;
+
+    /// Nodes which are still in the graph and have been added or had their connections changed.
+    std::unordered_set<Node*> m_ModifiedNodes;
+    /// Nodes which have been removed from the graph. These pointers are no longer valid.
+    std::vector<Node*> m_RemovedNodes;
+
+private:
+    Graph& m_Graph;
 };
 
 template <typename TNode, typename... Args>
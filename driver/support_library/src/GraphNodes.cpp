@@ -264,6 +264,7 @@ CompilerMceAlgorithm MceOperationNode::GetEffectiveAlgorithm(HardwareCapabilitie
 void MceOperationNode::SetAlgorithmHint(AlgorithmHint a)
 {
     m_AlgorithmHint = a;
+    ++m_PreparationHintsVersion;
 }
 
 AlgorithmHint MceOperationNode::GetAlgorithmHint() const
@@ -274,6 +275,7 @@ AlgorithmHint MceOperationNode::GetAlgorithmHint() const
 void MceOperationNode::SetFixGraphAlgorithmHint(AlgorithmHint a)
 {
     m_FixGraphAlgorithmHint = a;
+    ++m_FixGraphHintsVersion;
 }
 
 AlgorithmHint MceOperationNode::GetFixGraphAlgorithmHint() const
@@ -7,46 +7,135 @@
 
 #include "GraphNodes.hpp"
 
+#include <algorithm>
+#include <ostream>
+#include <unordered_set>
+
 namespace ethosn
 {
 namespace support_library
 {
 
-void OptimizeGraph(Graph& graph)
+void GraphOptimizer::AddRule(const std::string& name, OptimizationFunc rule)
+{
+    m_Rules.push_back(std::move(rule));
+    m_RuleStats.emplace_back();
+    m_RuleStats.back().m_Name = name;
+}
+
+bool GraphOptimizer::ApplyRules(Graph& graph, Node* node)
+{
+    for (size_t i = 0; i < m_Rules.size(); ++i)
+    {
+        RuleStats& stats = m_RuleStats[i];
+        auto start       = std::chrono::steady_clock::now();
+        bool applied     = m_Rules[i](graph, node);
+        stats.m_Duration += std::chrono::steady_clock::now() - start;
+        ++stats.m_NumAttempts;
+        if (applied)
+        {
+            ++stats.m_NumApplied;
+            return true;
+        }
+    }
+    return false;
+}
+
+void GraphOptimizer::Optimize(Graph& graph)
 {
-    using OptimizationFunc                     = bool (*)(Graph&, Node*);
-    const OptimizationFunc optimizationFuncs[] = {
-        &MergeFormatConversionNodes,
-        &ReorderReinterpretAndRequantizeNodes,
-        &ReorderConcatAndRequantizeNodes,
-        &ReorderConcatAndCopyNodes,
-        &MergeCopyAndRequantizeNodes,
-        &MergeRequantizeNodes,
-        &MergeCopyNodes,
-        &MergeConcatNodes,
-        &RemoveUnconnectedNode,
-        &MergeConstantAndReinterpretNodes,
-        &MergeConstantAndFormatConversionNodes,
-        &ReplaceConstantAdditionWithDepthwise,
-    };
-
-    bool madeChange;
-    do
+    // Nodes which a rule may apply to. Initially this is all of them.
+    std::unordered_set<Node*> dirtyNodes;
+    for (const std::unique_ptr<Node>& node : graph.GetNodes())
+    {
+        dirtyNodes.insert(node.get());
+    }
+
+    ModifiedNodesRecorder recorder(graph);
+    std::vector<Node*> affectedNodes;
+    bool madeChange = true;
+    while (madeChange)
     {
         madeChange = false;
+        // Scan the graph in topological order from the start, as rescanning the whole graph would, but only try the
+        // rules on the nodes which are dirty. No rule can apply to the others. The order is only re-sorted after a
+        // change is made, and the nodes before the first dirty one are skipped without trying any rules.
         for (Node* node : graph.GetNodesSorted())
         {
-            for (const OptimizationFunc f : optimizationFuncs)
+            if (dirtyNodes.erase(node) == 0)
+            {
+                continue;
+            }
+            if (ApplyRules(graph, node))
+            {
+                madeChange = true;
+                break;
+            }
+        }
+        if (!madeChange)
+        {
+            break;
+        }
+
+        // Mark the modified nodes and those whose rules can depend on them as dirty. A rule can depend on the given
+        // node, its producers, its consumers and the other producers of its consumers.
+        for (Node* removedNode : recorder.m_RemovedNodes)
+        {
+            dirtyNodes.erase(removedNode);
+        }
+        affectedNodes.clear();
+        for (Node* modifiedNode : recorder.m_ModifiedNodes)
+        {
+            affectedNodes.push_back(modifiedNode);
+            for (Edge* input : modifiedNode->GetInputs())
+            {
+                affectedNodes.push_back(input->GetSource());
+            }
+            for (Edge* output : modifiedNode->GetOutputs())
             {
-                madeChange = f(graph, node);
-                if (madeChange)
+                Node* consumer = output->GetDestination();
+                affectedNodes.push_back(consumer);
+                for (Edge* sibling : consumer->GetInputs())
                 {
-                    goto nextIteration;
+                    affectedNodes.push_back(sibling->GetSource());
                 }
             }
         }
-    nextIteration:;
-    } while (madeChange);
+        recorder.m_ModifiedNodes.clear();
+        recorder.m_RemovedNodes.clear();
+        dirtyNodes.insert(affectedNodes.begin(), affectedNodes.end());
+    }
+}
+
+const std::vector<GraphOptimizer::RuleStats>& GraphOptimizer::GetRuleStats() const
+{
+    return m_RuleStats;
+}
+
+void GraphOptimizer::PrintRuleStats(std::ostream& os) const
+{
+    for (const RuleStats& stats : m_RuleStats)
+    {
+        os << stats.m_Name << ": applied " << stats.m_NumApplied << " of " << stats.m_NumAttempts << " times, "
+           << std::chrono::duration_cast<std::chrono::microseconds>(stats.m_Duration).count() << " us\n";
+    }
+}
+
+GraphOptimizer CreateGraphOptimizer()
+{
+    GraphOptimizer optimizer;
+    optimizer.AddRule("MergeFormatConversionNodes", &MergeFormatConversionNodes);
+    optimizer.AddRule("ReorderReinterpretAndRequantizeNodes", &ReorderReinterpretAndRequantizeNodes);
+    optimizer.AddRule("ReorderConcatAndRequantizeNodes", &ReorderConcatAndRequantizeNodes);
+    optimizer.AddRule("ReorderConcatAndCopyNodes", &ReorderConcatAndCopyNodes);
+    optimizer.AddRule("MergeCopyAndRequantizeNodes", &MergeCopyAndRequantizeNodes);
+    optimizer.AddRule("MergeRequantizeNodes", &MergeRequantizeNodes);
+    optimizer.AddRule("MergeCopyNodes", &MergeCopyNodes);
+    optimizer.AddRule("MergeConcatNodes", &MergeConcatNodes);
+    optimizer.AddRule("RemoveUnconnectedNode", &RemoveUnconnectedNode);
+    optimizer.AddRule("MergeConstantAndReinterpretNodes", &MergeConstantAndReinterpretNodes);
+    optimizer.AddRule("MergeConstantAndFormatConversionNodes", &MergeConstantAndFormatConversionNodes);
+    optimizer.AddRule("ReplaceConstantAdditionWithDepthwise", &ReplaceConstantAdditionWithDepthwise);
+    return optimizer;
 }
 
 bool MergeFormatConversionNodes(Graph& graph, Node* node)
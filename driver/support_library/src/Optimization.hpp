@@ -5,6 +5,13 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
 namespace ethosn
 {
 namespace support_library
@@ -13,7 +20,44 @@ namespace support_library
 class Node;
 class Graph;
 
-void OptimizeGraph(Graph& graph);
+/// A rewrite rule which checks if the graph around the given node matches some pattern and if so, modifies it
+/// and returns true. Rules may only depend on the given node, its neighbours and the inputs of the nodes it outputs to.
+using OptimizationFunc = std::function<bool(Graph&, Node*)>;
+
+/// Repeatedly applies a set of rewrite rules to a graph until none of them can be applied any more.
+/// After each change, the first node in topological order which a rule applies to is found and the first of the rules
+/// (in the order they were added) which applies to it is applied, as when rescanning the whole graph after each change.
+/// However, once the rules have been tried on a node they are only tried again if the graph is changed around it.
+class GraphOptimizer
+{
+public:
+    struct RuleStats
+    {
+        std::string m_Name;
+        /// The number of times the rule was tried.
+        uint32_t m_NumAttempts = 0;
+        /// The number of times the rule was applied (i.e. returned true).
+        uint32_t m_NumApplied = 0;
+        /// The total time spent in the rule, whether or not it was applied.
+        std::chrono::steady_clock::duration m_Duration = std::chrono::steady_clock::duration::zero();
+    };
+
+    void AddRule(const std::string& name, OptimizationFunc rule);
+
+    void Optimize(Graph& graph);
+
+    const std::vector<RuleStats>& GetRuleStats() const;
+    void PrintRuleStats(std::ostream& os) const;
+
+private:
+    bool ApplyRules(Graph& graph, Node* node);
+
+    std::vector<OptimizationFunc> m_Rules;
+    std::vector<RuleStats> m_RuleStats;
+};
+
+/// Creates a GraphOptimizer with all the rules below.
+GraphOptimizer CreateGraphOptimizer();
 
 bool MergeFormatConversionNodes(Graph& graph, Node* node);
 bool MergeRequantizeNodes(Graph& graph, Node* node);
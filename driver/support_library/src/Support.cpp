@@ -11,7 +11,9 @@
 #include "Network.hpp"
 #include "PerformanceData.hpp"
 
+#include <ethosn_utils/Filesystem.hpp>
 #include <ethosn_utils/Json.hpp>
+#include <ethosn_utils/Macros.hpp>
 
 #include <iomanip>
 #include <iostream>
@@ -372,6 +374,37 @@ std::unique_ptr<CompiledNetwork> DeserializeCompiledNetwork(std::istream& in)
     return compiledNetwork;
 }
 
+namespace
+{
+
+std::unique_ptr<CompiledNetwork> DeserializeCompiledNetwork(std::shared_ptr<const ethosn::utils::MappedFile> file)
+{
+    if (!file->IsValid())
+    {
+        throw std::invalid_argument("Unable to read serialized Compiled Network file");
+    }
+    std::unique_ptr<CompiledNetworkImpl> compiledNetwork = std::make_unique<CompiledNetworkImpl>();
+    compiledNetwork->Deserialize(std::move(file));
+    return compiledNetwork;
+}
+
+}    // namespace
+
+std::unique_ptr<CompiledNetwork> DeserializeCompiledNetwork(const char* path)
+{
+    return DeserializeCompiledNetwork(std::make_shared<const ethosn::utils::MappedFile>(path));
+}
+
+std::unique_ptr<CompiledNetwork> DeserializeCompiledNetwork(int fd)
+{
+#if defined(__unix__)
+    return DeserializeCompiledNetwork(std::make_shared<const ethosn::utils::MappedFile>(fd));
+#else
+    ETHOSN_UNUSED(fd);
+    throw std::invalid_argument("Deserializing from a file descriptor is not supported on this platform");
+#endif
+}
+
 const char* EthosNVariantAsString(EthosNVariant npuType)
 {
     switch (npuType)
@@ -0,0 +1,87 @@
+//
+// Copyright © 2020 Arm Limited. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace ethosn
+{
+namespace support_library
+{
+
+ThreadPool::ThreadPool(uint32_t numThreads)
+    : m_Stopping(false)
+{
+    const uint32_t actualNumThreads = GetNumThreads(numThreads);
+    m_Threads.reserve(actualNumThreads);
+    for (uint32_t i = 0; i < actualNumThreads; ++i)
+    {
+        m_Threads.emplace_back(&ThreadPool::WorkerMain, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stopping = true;
+    }
+    m_TaskAvailable.notify_all();
+    for (std::thread& t : m_Threads)
+    {
+        t.join();
+    }
+}
+
+uint32_t ThreadPool::GetNumThreads() const
+{
+    return static_cast<uint32_t>(m_Threads.size());
+}
+
+uint32_t ThreadPool::GetNumThreads(uint32_t numThreads)
+{
+    if (numThreads == 0)
+    {
+        // hardware_concurrency() is allowed to return 0 if the value is not known
+        numThreads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    return numThreads;
+}
+
+std::future<void> ThreadPool::AddTask(std::function<void()> task)
+{
+    std::packaged_task<void()> packagedTask(std::move(task));
+    std::future<void> result = packagedTask.get_future();
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Tasks.push(std::move(packagedTask));
+    }
+    m_TaskAvailable.notify_one();
+    return result;
+}
+
+void ThreadPool::WorkerMain()
+{
+    while (true)
+    {
+        std::packaged_task<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_TaskAvailable.wait(lock, [this]() { return m_Stopping || !m_Tasks.empty(); });
+            if (m_Tasks.empty())
+            {
+                // Only reached when stopping, as remaining tasks are always run first
+                return;
+            }
+            task = std::move(m_Tasks.front());
+            m_Tasks.pop();
+        }
+        task();
+    }
+}
+
+}    // namespace support_library
+}    // namespace ethosn
@@ -0,0 +1,55 @@
+//
+// Copyright © 2020 Arm Limited. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace ethosn
+{
+namespace support_library
+{
+
+/// A fixed size pool of worker threads which run tasks in the order they are added.
+/// The worker threads are joined when the pool is destroyed, after any queued tasks have run.
+class ThreadPool
+{
+public:
+    /// Creates a pool with the given number of worker threads.
+    /// A value of zero means use as many threads as there are hardware threads available.
+    explicit ThreadPool(uint32_t numThreads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    uint32_t GetNumThreads() const;
+
+    /// Queues a task to be run on one of the worker threads.
+    /// The returned future becomes ready once the task has run and rethrows any exception thrown by the task.
+    std::future<void> AddTask(std::function<void()> task);
+
+    /// Returns the number of threads a pool created with the given value would have.
+    static uint32_t GetNumThreads(uint32_t numThreads);
+
+private:
+    void WorkerMain();
+
+    std::vector<std::thread> m_Threads;
+    std::queue<std::packaged_task<void()>> m_Tasks;
+    std::mutex m_Mutex;
+    std::condition_variable m_TaskAvailable;
+    bool m_Stopping;
+};
+
+}    // namespace support_library
+}    // namespace ethosn
@@ -8,12 +8,15 @@
 #include "Compiler.hpp"
 #include "GraphNodes.hpp"
 #include "SubmapFilter.hpp"
+#include "ThreadPool.hpp"
 #include "Utils.hpp"
+#include "WeightEncoderDiskCache.hpp"
 #include "WeightEncoderV2.hpp"
 
 #include <algorithm>
 #include <deque>
 #include <exception>
+#include <future>
 #include <iterator>
 #include <map>
 #include <utility>
@@ -38,19 +41,31 @@ std::deque<Weight>
 
     return uncompressedWeights;
 }
+
+// Number of bits buffered by BitstreamWriter before they are flushed to the output vector.
+constexpr uint32_t g_AccumulatorBits = 64;
+
+// The DMA can only transfer blocks aligned to this many bytes.
+constexpr uint32_t g_DmaEngineAlignment = 16;
 }    // namespace
 
 // BitstreamWriter is a helper class that supports writing packed bitfields into a vector.
-
+//
+// Bits are packed LSB first into consecutive bytes. Rather than emitting one bit at a time, writes are accumulated
+// into a 64-bit word which is appended to the output vector as soon as it is full, so the common case of appending
+// a field is a couple of shifts and ORs.
 class BitstreamWriter
 {
 public:
-    BitstreamWriter();
+    // The expected number of bits is only a hint used to pre-allocate the output buffer.
+    // If sizeOnly is set then only the write position is tracked and TakeBitstream() always returns an empty vector.
+    explicit BitstreamWriter(size_t expectedNumBits = 0, bool sizeOnly = false);
 
     // Returns the current write position in the bitstream (in bits)
     size_t GetOffset();
 
     // Write an element to the stream. Offset specifies where to start writing in the stream.
+    // Bits already written at this position are ORed with the new ones.
     void Write(uint8_t elem, int numBits, size_t offset);
 
     // Write an element to end of the stream.
@@ -63,97 +78,171 @@ public:
     // Reserve space in the stream by writing 0 bits
     void Reserve(size_t numBits);
 
-    // Returns the stream as a uint8_t vector
-    const std::vector<uint8_t>& GetBitstream();
+    // Returns the stream as a uint8_t vector, including any final partial byte. The stream is moved out rather than
+    // copied, leaving the writer empty as if Clear() had been called.
+    std::vector<uint8_t> TakeBitstream() &&;
 
     // Clears the content of the stream and resets the write position
     void Clear();
 
 private:
+    // Appends the low numBits (<= 64) bits of value to the end of the stream.
+    void WriteBits(uint64_t value, uint32_t numBits);
+
+    // Complete words which have been flushed from the accumulator.
     std::vector<uint8_t> m_Bitstream;
+    // Bits following those in m_Bitstream which have not been flushed yet.
+    uint64_t m_Accumulator;
+    uint32_t m_AccumulatorSize;
     size_t m_EndPos;
+    bool m_SizeOnly;
 };
 
-BitstreamWriter::BitstreamWriter()
-    : m_EndPos(0)
-{}
+BitstreamWriter::BitstreamWriter(size_t expectedNumBits, bool sizeOnly)
+    : m_Accumulator(0)
+    , m_AccumulatorSize(0)
+    , m_EndPos(0)
+    , m_SizeOnly(sizeOnly)
+{
+    if (!m_SizeOnly)
+    {
+        // Round up to a whole number of words as that is the granularity at which the buffer grows
+        m_Bitstream.reserve(((expectedNumBits + g_AccumulatorBits - 1) / g_AccumulatorBits) *
+                            (g_AccumulatorBits / 8));
+    }
+}
 
 size_t BitstreamWriter::GetOffset()
 {
     return m_EndPos;
 }
 
-void BitstreamWriter::Write(uint8_t elem, int numBits, size_t offset)
+void BitstreamWriter::WriteBits(uint64_t value, uint32_t numBits)
 {
-    for (int i = 0; i < numBits; ++i)
+    assert(numBits <= g_AccumulatorBits);
+    if (numBits == 0 || m_SizeOnly)
+    {
+        m_EndPos += numBits;
+        return;
+    }
+    if (numBits < g_AccumulatorBits)
     {
-        size_t idx = offset / 8;
-        int bit    = offset % 8;
+        value &= (uint64_t{ 1 } << numBits) - 1;
+    }
 
-        if (idx >= m_Bitstream.size())
-        {
-            m_Bitstream.push_back((elem >> i) & 1);
-        }
-        else
+    m_Accumulator |= value << m_AccumulatorSize;
+    const uint32_t newSize = m_AccumulatorSize + numBits;
+
+    if (newSize >= g_AccumulatorBits)
+    {
+        // The accumulator is full: flush it as a whole word and keep the bits of value which did not fit.
+        const size_t pos = m_Bitstream.size();
+        m_Bitstream.resize(pos + (g_AccumulatorBits / 8));
+        for (uint32_t i = 0; i < g_AccumulatorBits / 8; ++i)
         {
-            m_Bitstream[idx] = static_cast<uint8_t>(m_Bitstream[idx] | (((elem >> i) & 1) << bit));
+            m_Bitstream[pos + i] = static_cast<uint8_t>(m_Accumulator >> (8 * i));
         }
+        m_Accumulator     = (m_AccumulatorSize == 0) ? 0 : (value >> (g_AccumulatorBits - m_AccumulatorSize));
+        m_AccumulatorSize = newSize - g_AccumulatorBits;
+    }
+    else
+    {
+        m_AccumulatorSize = newSize;
+    }
+
+    m_EndPos += numBits;
+}
+
+void BitstreamWriter::Write(uint8_t elem, int numBits, size_t offset)
+{
+    if (offset == m_EndPos)
+    {
+        Write(elem, numBits);
+        return;
+    }
 
-        ++offset;
+    // Writing at an arbitrary offset is only used to fill in space previously allocated with Reserve().
+    assert(offset + static_cast<size_t>(numBits) <= m_EndPos);
+    if (m_SizeOnly)
+    {
+        return;
     }
 
-    if (static_cast<size_t>(offset) > m_EndPos)
+    const size_t flushedBits = m_Bitstream.size() * 8;
+    for (int i = 0; i < numBits; ++i, ++offset)
     {
-        m_EndPos = offset;
+        const uint8_t bit = static_cast<uint8_t>((elem >> i) & 1);
+        if (offset < flushedBits)
+        {
+            m_Bitstream[offset / 8] = static_cast<uint8_t>(m_Bitstream[offset / 8] | (bit << (offset % 8)));
+        }
+        else
+        {
+            m_Accumulator |= static_cast<uint64_t>(bit) << (offset - flushedBits);
+        }
     }
 }
 
 void BitstreamWriter::Write(uint8_t elem, int numBits)
 {
-    Write(elem, numBits, m_EndPos);
+    assert(numBits >= 0);
+    WriteBits(elem, static_cast<uint32_t>(numBits));
 }
 
 template <class T>
 void BitstreamWriter::Write(const T* elem, int numBits)
 {
+    // The element is read from memory a byte at a time (as for a little endian integer) and only the bytes which
+    // hold the requested bits are accessed.
     const uint8_t* p = reinterpret_cast<const uint8_t*>(elem);
 
     while (numBits > 0)
     {
-        Write(*p, std::min(numBits, 8));
+        const uint32_t chunkBits  = std::min(static_cast<uint32_t>(numBits), g_AccumulatorBits);
+        const uint32_t chunkBytes = (chunkBits + 7) / 8;
 
-        numBits -= 8;
-        ++p;
+        uint64_t value = 0;
+        for (uint32_t i = 0; i < chunkBytes; ++i)
+        {
+            value |= static_cast<uint64_t>(p[i]) << (8 * i);
+        }
+        WriteBits(value, chunkBits);
+
+        numBits -= static_cast<int>(chunkBits);
+        p += chunkBytes;
     }
 }
 
 void BitstreamWriter::Reserve(size_t numBits)
 {
-    size_t i = 0;
-
-    while (i < numBits)
+    while (numBits > 0)
     {
-        size_t idx = (m_EndPos + i) / 8;
-        if (idx >= static_cast<size_t>(m_Bitstream.size()))
-        {
-            m_Bitstream.push_back(0);
-        }
-
-        i += 8 - ((m_EndPos + i) % 8);
+        const uint32_t chunkBits = static_cast<uint32_t>(std::min<size_t>(numBits, g_AccumulatorBits));
+        WriteBits(0, chunkBits);
+        numBits -= chunkBits;
     }
-
-    m_EndPos += numBits;
 }
 
-const std::vector<uint8_t>& BitstreamWriter::GetBitstream()
+std::vector<uint8_t> BitstreamWriter::TakeBitstream() &&
 {
-    return m_Bitstream;
+    // Flush the bytes that are still held in the accumulator, including a final partial byte.
+    const uint32_t tailSize = (m_AccumulatorSize + 7) / 8;
+    for (uint32_t i = 0; i < tailSize; ++i)
+    {
+        m_Bitstream.push_back(static_cast<uint8_t>(m_Accumulator >> (8 * i)));
+    }
+
+    std::vector<uint8_t> bitstream = std::move(m_Bitstream);
+    Clear();
+    return bitstream;
 }
 
 void BitstreamWriter::Clear()
 {
     m_Bitstream.clear();
-    m_EndPos = 0;
+    m_Accumulator     = 0;
+    m_AccumulatorSize = 0;
+    m_EndPos          = 0;
 }
 
 /**
@@ -277,8 +366,8 @@ void IndexCompressor::CompressWeight(uint8_t weight)
 
 void IndexCompressor::Flush()
 {
-    m_Result.insert(m_Result.end(), m_Bitstream.GetBitstream().begin(), m_Bitstream.GetBitstream().end());
-    m_Bitstream.Clear();
+    const std::vector<uint8_t> bitstream = std::move(m_Bitstream).TakeBitstream();
+    m_Result.insert(m_Result.end(), bitstream.begin(), bitstream.end());
 }
 
 /**
@@ -365,8 +454,8 @@ void ZeroCompressor::Flush()
         CompressWeight(static_cast<uint8_t>(m_ZeroPoint));
     }
 
-    m_Result.insert(m_Result.end(), m_Bitstream.GetBitstream().begin(), m_Bitstream.GetBitstream().end());
-    m_Bitstream.Clear();
+    const std::vector<uint8_t> bitstream = std::move(m_Bitstream).TakeBitstream();
+    m_Result.insert(m_Result.end(), bitstream.begin(), bitstream.end());
 }
 
 /**
@@ -392,13 +481,46 @@ static std::shared_ptr<WeightCompressor> CreateWeightCompressor(std::vector<uint
     return std::make_shared<DefaultCompressor>(result);
 }
 
+/**
+ * Calculates the number of bytes the compressor returned by CreateWeightCompressor would produce for the given
+ * weights, without compressing them.
+ */
+static size_t GetCompressedSize(const std::vector<uint8_t>& weights,
+                                uint32_t indexSize,
+                                const std::vector<uint8_t>& lut,
+                                bool lutReload,
+                                bool maskEnable,
+                                const uint8_t zeroPoint,
+                                int blockSize)
+{
+    if (!maskEnable && indexSize == 0)
+    {
+        return weights.size();
+    }
+
+    const size_t bitsPerElement = (indexSize != 0) ? indexSize + 2 : 8;
+    const size_t lutBits        = lutReload ? lut.size() * 8 : 0;
+
+    if (!maskEnable)
+    {
+        return (lutBits + weights.size() * bitsPerElement + 7) / 8;
+    }
+
+    // Each block of weights (padded to a whole number of blocks) has one mask bit per weight and
+    // only the weights which are not equal to the zero point are written.
+    const size_t blockBits  = static_cast<size_t>(blockSize);
+    const size_t numBlocks  = (weights.size() + blockBits - 1) / blockBits;
+    const size_t numNonZero = weights.size() - static_cast<size_t>(std::count(weights.begin(), weights.end(), zeroPoint));
+    return (lutBits + numBlocks * blockBits + numNonZero * bitsPerElement + 7) / 8;
+}
+
 /**
  * Weight encoder for architecture less or equal to v1.2
  */
 class WeightEncoderV1 : public WeightEncoder
 {
 public:
-    WeightEncoderV1(const HardwareCapabilities& capabilities);
+    WeightEncoderV1(const HardwareCapabilities& capabilities, const WeightEncoderOptions& options = {});
 
 protected:
     struct WeightCompressionParamsV1 : public WeightCompressionParams
@@ -412,6 +534,9 @@ protected:
     virtual std::vector<std::unique_ptr<WeightCompressionParams>>
         GenerateCompressionParams(uint32_t numOfmInParallel) override;
 
+    virtual uint32_t
+        GetCompressionParamsIdx(uint32_t ofmIdx, uint32_t numOfmInParallel, uint32_t stripeDepth) const override;
+
     virtual EncodedOfm EncodeOfm(const uint8_t* weightData,
                                  uint32_t ofmIdx,
                                  uint32_t numOfmInParallel,
@@ -427,7 +552,8 @@ protected:
                                  ethosn::command_stream::MceOperation operation,
                                  CompilerMceAlgorithm algorithm,
                                  const EncodingParams& params,
-                                 std::vector<std::unique_ptr<WeightCompressionParams>>& compressionParams) override;
+                                 std::vector<std::unique_ptr<WeightCompressionParams>>& compressionParams,
+                                 bool sizeOnly) override;
 
     virtual uint32_t GetOfmShiftOffset() const override;
 
@@ -446,8 +572,8 @@ protected:
                                     const TensorInfo& weightsTensorInfo) const;
 };
 
-WeightEncoderV1::WeightEncoderV1(const HardwareCapabilities& capabilities)
-    : WeightEncoder(capabilities)
+WeightEncoderV1::WeightEncoderV1(const HardwareCapabilities& capabilities, const WeightEncoderOptions& options)
+    : WeightEncoder(capabilities, options)
 {}
 
 template <class T>
@@ -463,8 +589,8 @@ void insert_back(std::vector<uint8_t>& dst, const T& src)
     insert_back(dst, &src, sizeof(src));
 }
 
-WeightEncoderV2::WeightEncoderV2(const HardwareCapabilities& capabilities)
-    : WeightEncoder(capabilities)
+WeightEncoderV2::WeightEncoderV2(const HardwareCapabilities& capabilities, const WeightEncoderOptions& options)
+    : WeightEncoder(capabilities, options)
     , m_Mode(WeightCompMode::AUTO)
 {}
 
@@ -484,6 +610,12 @@ std::vector<std::unique_ptr<WeightEncoder::WeightCompressionParams>>
     return params;
 }
 
+uint32_t
+    WeightEncoderV2::GetCompressionParamsIdx(uint32_t ofmIdx, uint32_t numOfmInParallel, uint32_t stripeDepth) const
+{
+    return (ofmIdx % stripeDepth) % numOfmInParallel;
+}
+
 WeightEncoder::EncodedOfm
     WeightEncoderV2::EncodeOfm(const uint8_t* weightData,
                                uint32_t ofmIdx,
@@ -500,9 +632,10 @@ WeightEncoder::EncodedOfm
                                ethosn::command_stream::MceOperation operation,
                                CompilerMceAlgorithm algorithm,
                                const EncodingParams& params,
-                               std::vector<std::unique_ptr<WeightCompressionParams>>& compressionParams)
+                               std::vector<std::unique_ptr<WeightCompressionParams>>& compressionParams,
+                               bool sizeOnly)
 {
-    uint32_t wdIdx = (ofmIdx % stripeDepth) % numOfmInParallel;
+    uint32_t wdIdx = GetCompressionParamsIdx(ofmIdx, numOfmInParallel, stripeDepth);
 
     // Grab a reference to previous compression parameters
     WeightCompressionParamsV2& prevCompParams = static_cast<WeightCompressionParamsV2&>(*compressionParams[wdIdx]);
@@ -535,7 +668,9 @@ WeightEncoder::EncodedOfm
 
     const bool ofmReload = GetOfmReload(compParams, prevCompParams, ofmIdx < numOfmInParallel);
 
-    BitstreamWriter writer;
+    // The uncompressed size of the weights is a good enough estimate of the size of the stream to avoid
+    // reallocating the buffer in the common case.
+    BitstreamWriter writer(weights.size() * 8, sizeOnly);
 
     std::deque<WeightSymbol> weightSymbols, zeroSymbols;
 
@@ -556,7 +691,8 @@ WeightEncoder::EncodedOfm
     // Remember current compression parameters
     prevCompParams = compParams;
 
-    return { std::move(writer.GetBitstream()), static_cast<uint32_t>(writer.GetOffset()) };
+    const uint32_t numBits = static_cast<uint32_t>(writer.GetOffset());
+    return { std::move(writer).TakeBitstream(), numBits };
 }
 
 uint32_t WeightEncoderV2::GetOfmShiftOffset() const
@@ -1476,20 +1612,27 @@ void WeightEncoderV2::WritePayloadHeader(BitstreamWriter& writer,
     }
 }
 
+std::unique_ptr<ThreadPool> WeightEncoderOptions::CreateThreadPool(const CompilationOptions& compilationOptions)
+{
+    const uint32_t numThreads = ThreadPool::GetNumThreads(compilationOptions.m_NumWeightEncoderThreads);
+    return numThreads > 1 ? std::make_unique<ThreadPool>(numThreads) : nullptr;
+}
+
 /*
  * Weight encoder base class
  */
-std::unique_ptr<WeightEncoder> WeightEncoder::CreateWeightEncoder(const HardwareCapabilities& capabilities)
+std::unique_ptr<WeightEncoder> WeightEncoder::CreateWeightEncoder(const HardwareCapabilities& capabilities,
+                                                                  const WeightEncoderOptions& options)
 {
     const uint32_t version = capabilities.GetWeightCompressionVersion();
 
     if (version == 0)
     {
-        return std::make_unique<WeightEncoderV1>(capabilities);
+        return std::make_unique<WeightEncoderV1>(capabilities, options);
     }
     else if (version == 1)
     {
-        return std::make_unique<WeightEncoderV2>(capabilities);
+        return std::make_unique<WeightEncoderV2>(capabilities, options);
     }
     else
     {
@@ -1498,10 +1641,14 @@ std::unique_ptr<WeightEncoder> WeightEncoder::CreateWeightEncoder(const Hardware
     }
 }
 
-WeightEncoder::WeightEncoder(const HardwareCapabilities& capabilities)
+WeightEncoder::WeightEncoder(const HardwareCapabilities& capabilities, const WeightEncoderOptions& options)
     : m_Capabilities(capabilities)
+    , m_ThreadPool(options.m_ThreadPool)
+    , m_DiskCache(options.m_CacheDir.empty() ? nullptr : std::make_unique<WeightEncoderDiskCache>(options.m_CacheDir))
 {}
 
+WeightEncoder::~WeightEncoder() = default;
+
 EncodedWeights WeightEncoder::Encode(const MceOperationNode& mceOperation,
                                      uint32_t stripeDepth,
                                      uint32_t stripeSize,
@@ -1549,6 +1696,29 @@ EncodedWeights WeightEncoder::Encode(const MceOperationNode& mceOperation,
     // clang-format on
 }
 
+EncodedWeightsSize WeightEncoder::CalculateEncodedSize(const MceOperationNode& mceOperation,
+                                                       uint32_t stripeDepth,
+                                                       uint32_t stripeSize,
+                                                       const QuantizationInfo& outputQuantizationInfo)
+{
+    // clang-format off
+    return CalculateEncodedSize(mceOperation.GetWeightsInfo(),
+                                static_cast<const uint8_t*>(mceOperation.GetWeightsData().data()),
+                                mceOperation.GetBiasInfo(),
+                                mceOperation.GetBiasData().data(),
+                                mceOperation.GetInputQuantizationInfo(0),
+                                outputQuantizationInfo,
+                                stripeDepth,
+                                mceOperation.GetStride().m_Y,
+                                mceOperation.GetStride().m_X,
+                                mceOperation.GetMceData().m_PadTop(),
+                                mceOperation.GetMceData().m_PadLeft(),
+                                stripeSize,
+                                mceOperation.GetMceData().m_Operation(),
+                                mceOperation.GetAlgorithm());
+    // clang-format on
+}
+
 EncodedWeights WeightEncoder::Encode(const TensorInfo& weightsTensorInfo,
                                      const uint8_t* weightsData,
                                      const TensorInfo& biasTensorInfo,
@@ -1563,6 +1733,45 @@ EncodedWeights WeightEncoder::Encode(const TensorInfo& weightsTensorInfo,
                                      uint32_t iterationSize,
                                      ethosn::command_stream::MceOperation operation,
                                      CompilerMceAlgorithm algorithm)
+{
+    if (!m_DiskCache)
+    {
+        return EncodeUncached(weightsTensorInfo, weightsData, biasTensorInfo, biasData, inputQuantizationInfo,
+                              outputQuantizationInfo, stripeDepth, strideY, strideX, paddingTop, paddingLeft,
+                              iterationSize, operation, algorithm);
+    }
+
+    const std::vector<uint8_t> key = WeightEncoderDiskCache::CreateKey(
+        m_Capabilities, weightsTensorInfo, weightsData, biasTensorInfo, biasData, inputQuantizationInfo,
+        outputQuantizationInfo, stripeDepth, strideY, strideX, paddingTop, paddingLeft, iterationSize, operation,
+        algorithm);
+
+    EncodedWeights result;
+    if (!m_DiskCache->Load(key, result))
+    {
+        result = EncodeUncached(weightsTensorInfo, weightsData, biasTensorInfo, biasData, inputQuantizationInfo,
+                                outputQuantizationInfo, stripeDepth, strideY, strideX, paddingTop, paddingLeft,
+                                iterationSize, operation, algorithm);
+        m_DiskCache->Store(key, result);
+    }
+    return result;
+}
+
+WeightEncoder::EncodedOfmStreams WeightEncoder::EncodeOfmStreams(const TensorInfo& weightsTensorInfo,
+                                                                   const uint8_t* weightsData,
+                                                                   const TensorInfo& biasTensorInfo,
+                                                                   const int32_t* biasData,
+                                                                   const QuantizationInfo& inputQuantizationInfo,
+                                                                   const QuantizationInfo& outputQuantizationInfo,
+                                                                   uint32_t stripeDepth,
+                                                                   uint32_t strideY,
+                                                                   uint32_t strideX,
+                                                                   uint32_t paddingTop,
+                                                                   uint32_t paddingLeft,
+                                                                   uint32_t iterationSize,
+                                                                   ethosn::command_stream::MceOperation operation,
+                                                                   CompilerMceAlgorithm algorithm,
+                                                                   bool sizeOnly)
 {
     ETHOSN_UNUSED(biasTensorInfo);
     assert(stripeDepth > 0);
@@ -1599,8 +1808,7 @@ EncodedWeights WeightEncoder::Encode(const TensorInfo& weightsTensorInfo,
     // Number of Ofm processed in parallel which is the minimum number of
     // weights streams that need to be loaded at the same time for all the
     // mce interfaces to start producing an Ofm each.
-    uint32_t numSrams       = m_Capabilities.GetNumberOfSrams();
-    uint32_t numOfmsPerSram = m_Capabilities.GetNumberOfOfm() / numSrams;
+    uint32_t numSrams = m_Capabilities.GetNumberOfSrams();
 
     // The number of OFMs that can be processed in parallel is limited to the stripe depth
     uint32_t numOfmInParallel =
@@ -1610,14 +1818,18 @@ EncodedWeights WeightEncoder::Encode(const TensorInfo& weightsTensorInfo,
         GenerateCompressionParams(numOfmInParallel);
 
     // Encode each OFM stream independently
-    std::vector<std::vector<uint8_t>> encodedStreams;
-    encodedStreams.reserve(numOfms * numIterationsOfm);
-    std::vector<uint32_t> encodedNumBits;
-    encodedNumBits.reserve(numOfms * numIterationsOfm);
+    const uint32_t numEncodedStreams = numOfms * numIterationsOfm;
+    EncodedOfmStreams result;
+    result.m_NumOfms          = numOfms;
+    result.m_NumIterationsOfm = numIterationsOfm;
+    result.m_NumOfmInParallel = numOfmInParallel;
+    std::vector<std::vector<uint8_t>>& encodedStreams = result.m_Streams;
+    std::vector<uint32_t>& encodedNumBits             = result.m_NumBits;
+    encodedStreams.resize(numEncodedStreams);
+    encodedNumBits.resize(numEncodedStreams);
     const auto numWeightScales = weightsTensorInfo.m_QuantizationInfo.GetScales().size();
 
-    for (uint32_t ofm = 0; ofm < (numOfms * numIterationsOfm); ++ofm)
-    {
+    auto encodeOfmStream = [&](uint32_t ofm) {
         // numIterationsOfm >= 1, fully connected
         //                   = 1, otherwise
         uint32_t iteration = ofm % numIterationsOfm;
@@ -1638,13 +1850,85 @@ EncodedWeights WeightEncoder::Encode(const TensorInfo& weightsTensorInfo,
 
         EncodedOfm encodedOfm = EncodeOfm(weightsData, ofmIdx, numOfmInParallel, numIterationsOfm, stripeDepth,
                                           iteration, weightsTensorInfo, strideY, strideX, paddingTop, paddingLeft,
-                                          iterationSize, operation, algorithm, params, compressionParams);
+                                          iterationSize, operation, algorithm, params, compressionParams, sizeOnly);
 
-        encodedStreams.push_back(std::move(encodedOfm.m_EncodedWeights));
-        encodedNumBits.push_back(encodedOfm.m_NumOfBits);
+        encodedStreams[ofm] = std::move(encodedOfm.m_EncodedWeights);
+        encodedNumBits[ofm] = encodedOfm.m_NumOfBits;
+    };
+
+    // The OFMs which share an entry in compressionParams must be encoded in order as each one depends on the
+    // compression parameters chosen for the previous one, but there are no other dependencies between OFMs.
+    // Each of these chains of OFMs can therefore be encoded in parallel, with each result written to its own
+    // slot so that the output is identical to encoding serially.
+    const uint32_t numChains = static_cast<uint32_t>(compressionParams.size());
+    if (m_ThreadPool != nullptr && numChains > 1 && numEncodedStreams > numChains)
+    {
+        std::vector<std::vector<uint32_t>> ofmsPerChain(numChains);
+        for (uint32_t ofm = 0; ofm < numEncodedStreams; ++ofm)
+        {
+            const uint32_t ofmIdx = ofm / numIterationsOfm;
+            ofmsPerChain[GetCompressionParamsIdx(ofmIdx, numOfmInParallel, stripeDepth)].push_back(ofm);
+        }
+
+        std::vector<std::future<void>> chainsDone;
+        chainsDone.reserve(numChains);
+        for (const std::vector<uint32_t>& chain : ofmsPerChain)
+        {
+            chainsDone.push_back(m_ThreadPool->AddTask([&encodeOfmStream, &chain]() {
+                for (uint32_t ofm : chain)
+                {
+                    encodeOfmStream(ofm);
+                }
+            }));
+        }
+
+        // Wait for all the chains before rethrowing any exception, as the tasks reference local variables
+        for (std::future<void>& f : chainsDone)
+        {
+            f.wait();
+        }
+        for (std::future<void>& f : chainsDone)
+        {
+            f.get();
+        }
     }
+    else
+    {
+        for (uint32_t ofm = 0; ofm < numEncodedStreams; ++ofm)
+        {
+            encodeOfmStream(ofm);
+        }
+    }
+
+    return result;
+}
 
-    constexpr uint32_t dmaEngineAlignment = 16;
+EncodedWeights WeightEncoder::EncodeUncached(const TensorInfo& weightsTensorInfo,
+                                             const uint8_t* weightsData,
+                                             const TensorInfo& biasTensorInfo,
+                                             const int32_t* biasData,
+                                             const QuantizationInfo& inputQuantizationInfo,
+                                             const QuantizationInfo& outputQuantizationInfo,
+                                             uint32_t stripeDepth,
+                                             uint32_t strideY,
+                                             uint32_t strideX,
+                                             uint32_t paddingTop,
+                                             uint32_t paddingLeft,
+                                             uint32_t iterationSize,
+                                             ethosn::command_stream::MceOperation operation,
+                                             CompilerMceAlgorithm algorithm)
+{
+    const EncodedOfmStreams ofmStreams =
+        EncodeOfmStreams(weightsTensorInfo, weightsData, biasTensorInfo, biasData, inputQuantizationInfo,
+                         outputQuantizationInfo, stripeDepth, strideY, strideX, paddingTop, paddingLeft, iterationSize,
+                         operation, algorithm, false);
+    const std::vector<std::vector<uint8_t>>& encodedStreams = ofmStreams.m_Streams;
+    const std::vector<uint32_t>& encodedNumBits             = ofmStreams.m_NumBits;
+    const uint32_t numOfms                                  = ofmStreams.m_NumOfms;
+    const uint32_t numIterationsOfm                         = ofmStreams.m_NumIterationsOfm;
+    const uint32_t numOfmInParallel                         = ofmStreams.m_NumOfmInParallel;
+    const uint32_t numSrams                                 = m_Capabilities.GetNumberOfSrams();
+    const uint32_t numOfmsPerSram                           = m_Capabilities.GetNumberOfOfm() / numSrams;
 
     // Merge the OFM streams together so that all the OFMs that will be processed in the same stripe
     // on the same OG are consecutive in the same stream. Here is a diagram showing how the OFM streams
@@ -1678,7 +1962,7 @@ EncodedWeights WeightEncoder::Encode(const TensorInfo& weightsTensorInfo,
         if (m_Capabilities.GetWeightCompressionVersion() == 0)
         {
             streamPerOgForThisStripe = MergeStreams(encodedOfmStreamsForThisStripe, numOfmInParallel * numIterationsOfm,
-                                                    1, 1, dmaEngineAlignment);
+                                                    1, 1, g_DmaEngineAlignment);
         }
         else
         {
@@ -1686,7 +1970,7 @@ EncodedWeights WeightEncoder::Encode(const TensorInfo& weightsTensorInfo,
                                                                      std::begin(encodedNumBits) + lastOfmInStripe);
             streamPerOgForThisStripe =
                 MergeStreamsOg(encodedOfmStreamsForThisStripe, encodedOfmStreamSizesForThisStripe,
-                               numOfmInParallel * numIterationsOfm, dmaEngineAlignment);
+                               numOfmInParallel * numIterationsOfm, g_DmaEngineAlignment);
         }
         streamPerStripeOg.insert(std::end(streamPerStripeOg), std::begin(streamPerOgForThisStripe),
                                  std::end(streamPerOgForThisStripe));
@@ -1708,9 +1992,9 @@ EncodedWeights WeightEncoder::Encode(const TensorInfo& weightsTensorInfo,
     // Therefore we pad each stream to 16 bytes.
     for (std::vector<uint8_t>& stream : streamPerStripeOg)
     {
-        if (stream.size() % dmaEngineAlignment != 0)
+        if (stream.size() % g_DmaEngineAlignment != 0)
         {
-            size_t numZeroesToAdd = dmaEngineAlignment - stream.size() % dmaEngineAlignment;
+            size_t numZeroesToAdd = g_DmaEngineAlignment - stream.size() % g_DmaEngineAlignment;
             std::fill_n(std::back_inserter(stream), numZeroesToAdd, 0);
         }
     }
@@ -1725,8 +2009,14 @@ EncodedWeights WeightEncoder::Encode(const TensorInfo& weightsTensorInfo,
 
     // Merge all the SRAM streams together by interleaving 16 bytes from each.
     // This is so the DMA will distribute the correct weight data to the correct SRAM.
-    encodedWeights.m_Data     = InterleaveStreams(mergedStreams, dmaEngineAlignment);
-    encodedWeights.m_Metadata = CalculateWeightsMetadata(streamPerStripeOg, numOfmInParallel);
+    encodedWeights.m_Data     = InterleaveStreams(mergedStreams, g_DmaEngineAlignment);
+    std::vector<uint32_t> streamPerStripeOgSizes;
+    streamPerStripeOgSizes.reserve(streamPerStripeOg.size());
+    for (const std::vector<uint8_t>& stream : streamPerStripeOg)
+    {
+        streamPerStripeOgSizes.push_back(static_cast<uint32_t>(stream.size()));
+    }
+    encodedWeights.m_Metadata = CalculateWeightsMetadata(streamPerStripeOgSizes, numOfmInParallel);
 
     encodedWeights.m_MaxSize = 0;
 
@@ -1738,6 +2028,88 @@ EncodedWeights WeightEncoder::Encode(const TensorInfo& weightsTensorInfo,
     return encodedWeights;
 }
 
+EncodedWeightsSize WeightEncoder::CalculateEncodedSize(const TensorInfo& weightsTensorInfo,
+                                                       const uint8_t* weightsData,
+                                                       const TensorInfo& biasTensorInfo,
+                                                       const int32_t* biasData,
+                                                       const QuantizationInfo& inputQuantizationInfo,
+                                                       const QuantizationInfo& outputQuantizationInfo,
+                                                       uint32_t stripeDepth,
+                                                       uint32_t strideY,
+                                                       uint32_t strideX,
+                                                       uint32_t paddingTop,
+                                                       uint32_t paddingLeft,
+                                                       uint32_t iterationSize,
+                                                       ethosn::command_stream::MceOperation operation,
+                                                       CompilerMceAlgorithm algorithm)
+{
+    const EncodedOfmStreams ofmStreams =
+        EncodeOfmStreams(weightsTensorInfo, weightsData, biasTensorInfo, biasData, inputQuantizationInfo,
+                         outputQuantizationInfo, stripeDepth, strideY, strideX, paddingTop, paddingLeft, iterationSize,
+                         operation, algorithm, true);
+    const std::vector<uint32_t>& encodedNumBits = ofmStreams.m_NumBits;
+    const uint32_t numOfms                      = ofmStreams.m_NumOfms;
+    const uint32_t numIterationsOfm             = ofmStreams.m_NumIterationsOfm;
+    const uint32_t numOfmInParallel             = ofmStreams.m_NumOfmInParallel;
+    const uint32_t numSrams                     = m_Capabilities.GetNumberOfSrams();
+
+    // This follows the same steps as EncodeUncached but only keeps track of the size of each stream.
+    // MergeStreams concatenates whole bytes whereas MergeStreamsOg concatenates bits.
+    const uint32_t numOgs = numOfmInParallel * numIterationsOfm;
+    std::vector<uint32_t> streamPerStripeOgSizes;
+    const uint32_t numStripes = utils::DivRoundUp(numOfms, stripeDepth);
+    for (uint32_t stripeIdx = 0; stripeIdx < numStripes; ++stripeIdx)
+    {
+        const uint32_t firstOfmInStripe = stripeDepth * stripeIdx * numIterationsOfm;
+        const uint32_t lastOfmInStripe  = std::min<uint32_t>(numOfms, stripeDepth * (stripeIdx + 1)) * numIterationsOfm;
+        std::vector<uint64_t> numBitsPerOg(numOgs, 0);
+        for (uint32_t ofm = firstOfmInStripe; ofm < lastOfmInStripe; ++ofm)
+        {
+            uint64_t& numBits = numBitsPerOg[(ofm - firstOfmInStripe) % numOgs];
+            if (m_Capabilities.GetWeightCompressionVersion() == 0)
+            {
+                numBits += utils::RoundUpToNearestMultiple(encodedNumBits[ofm], 8U);
+            }
+            else
+            {
+                numBits += encodedNumBits[ofm];
+            }
+        }
+        for (uint64_t numBits : numBitsPerOg)
+        {
+            streamPerStripeOgSizes.push_back(static_cast<uint32_t>((numBits + 7) / 8));
+        }
+    }
+
+    // All streams are padded to the same size, which is then aligned for the DMA
+    uint32_t streamLength = 0;
+    for (uint32_t size : streamPerStripeOgSizes)
+    {
+        streamLength = std::max(streamLength, size);
+    }
+    streamLength = utils::RoundUpToNearestMultiple(streamLength, g_DmaEngineAlignment);
+    std::fill(streamPerStripeOgSizes.begin(), streamPerStripeOgSizes.end(), streamLength);
+
+    // The streams are then merged per SRAM and interleaved, padding each merged stream to the longest one
+    std::vector<uint32_t> numStreamsPerSram(numSrams, 0);
+    for (uint32_t streamIdx = 0; streamIdx < streamPerStripeOgSizes.size(); ++streamIdx)
+    {
+        ++numStreamsPerSram[(streamIdx / numIterationsOfm) % numSrams];
+    }
+    const uint32_t maxNumStreamsPerSram = *std::max_element(numStreamsPerSram.begin(), numStreamsPerSram.end());
+
+    EncodedWeightsSize result;
+    result.m_Size     = maxNumStreamsPerSram * streamLength * numSrams;
+    result.m_Metadata = CalculateWeightsMetadata(streamPerStripeOgSizes, numOfmInParallel);
+    result.m_MaxSize  = 0;
+    for (const WeightsMetadata& metadata : result.m_Metadata)
+    {
+        result.m_MaxSize = std::max(metadata.m_Size, result.m_MaxSize);
+    }
+
+    return result;
+}
+
 /* Calculate the size if the weights are compressed with zero compression */
 static size_t CalcZeroCompressionSize(size_t nbrElements, size_t nbrZeros, size_t numSrams)
 {
@@ -1785,17 +2157,17 @@ static size_t CalcZeroLutCompressionSize(size_t nbrElements, size_t nbrZeros, si
 }
 
 std::vector<WeightsMetadata>
-    WeightEncoder::CalculateWeightsMetadata(const std::vector<std::vector<uint8_t>>& streamPerStripeOg,
+    WeightEncoder::CalculateWeightsMetadata(const std::vector<uint32_t>& streamPerStripeOgSizes,
                                             uint32_t numOgPerStripe) const
 {
     std::vector<WeightsMetadata> metadata;
     uint32_t runningSize = 0;
-    for (size_t i = 0; i < streamPerStripeOg.size(); i += numOgPerStripe)
+    for (size_t i = 0; i < streamPerStripeOgSizes.size(); i += numOgPerStripe)
     {
         uint32_t stripeSize = 0;
         for (size_t j = 0; j < numOgPerStripe; ++j)
         {
-            stripeSize += static_cast<uint32_t>(streamPerStripeOg[i + j].size());
+            stripeSize += streamPerStripeOgSizes[i + j];
         }
         metadata.push_back(WeightsMetadata{ runningSize, stripeSize });
         runningSize += stripeSize;
@@ -2289,6 +2661,11 @@ std::vector<std::unique_ptr<WeightEncoder::WeightCompressionParams>>
     return params;
 }
 
+uint32_t WeightEncoderV1::GetCompressionParamsIdx(uint32_t ofmIdx, uint32_t numOfmInParallel, uint32_t) const
+{
+    return ofmIdx % numOfmInParallel;
+}
+
 WeightEncoder::EncodedOfm
     WeightEncoderV1::EncodeOfm(const uint8_t* weightData,
                                uint32_t ofmIdx,
@@ -2305,12 +2682,14 @@ WeightEncoder::EncodedOfm
                                ethosn::command_stream::MceOperation operation,
                                CompilerMceAlgorithm algorithm,
                                const EncodingParams& params,
-                               std::vector<std::unique_ptr<WeightCompressionParams>>& compressionParameters)
+                               std::vector<std::unique_ptr<WeightCompressionParams>>& compressionParameters,
+                               bool sizeOnly)
 {
     // Lookup the compression parameters for the previous OFM associated with the same CE. This is used
     // to modify the compression of this current OFM.
     WeightCompressionParamsV1& previousOfmSameCeCompressionParams =
-        static_cast<WeightCompressionParamsV1&>(*compressionParameters[ofmIdx % numOfmInParallel]);
+        static_cast<WeightCompressionParamsV1&>(
+            *compressionParameters[GetCompressionParamsIdx(ofmIdx, numOfmInParallel, 0)]);
 
     // Get the raw (unencoded) weight stream. Note we must do this twice - once to get a stream suited
     // for zero mask compression and again to get one suited to no zero mask compression. Yuck!
@@ -2342,6 +2721,17 @@ WeightEncoder::EncodedOfm
     previousOfmSameCeCompressionParams   = compressionParams;
     std::vector<uint8_t>& encodedWeights = result.m_EncodedWeights;
 
+    if (sizeOnly)
+    {
+        const size_t numBytes =
+            sizeof(WeightHeader) + GetCompressedSize(rawWeights, compressionParams.m_IndexSize, compressionParams.m_Lut,
+                                                     compressionParams.m_LutReload, compressionParams.m_MaskEnable,
+                                                     static_cast<uint8_t>(params.m_FilterZeroPoint),
+                                                     m_Capabilities.GetNumberOfSrams());
+        result.m_NumOfBits = static_cast<uint32_t>(numBytes * 8);
+        return result;
+    }
+
     // Add the per-OFM header.
     encodedWeights.insert(encodedWeights.end(), sizeof(WeightHeader), 0);
     WeightHeader& header = reinterpret_cast<WeightHeader&>(encodedWeights.front());
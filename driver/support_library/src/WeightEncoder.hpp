@@ -10,6 +10,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace ethosn
@@ -23,6 +24,8 @@ constexpr uint32_t g_WeightsChannelVecProd = 1024U;
 class Constant;
 class HardwareCapabilities;
 class MceOperationNode;
+class ThreadPool;
+class WeightEncoderDiskCache;
 
 struct WeightsMetadata
 {
@@ -37,17 +40,48 @@ struct EncodedWeights
     std::vector<uint8_t> m_Data;
 };
 
+/// The size and layout of a set of encoded weights, without the encoded data itself.
+struct EncodedWeightsSize
+{
+    std::vector<WeightsMetadata> m_Metadata;
+    uint32_t m_MaxSize;
+    /// Total size in bytes of the encoded data.
+    uint32_t m_Size;
+};
+
+/// Options which control how weights are encoded. These never affect the encoded result.
+struct WeightEncoderOptions
+{
+    WeightEncoderOptions() = default;
+
+    WeightEncoderOptions(const CompilationOptions& compilationOptions, ThreadPool* threadPool)
+        : m_ThreadPool(threadPool)
+        , m_CacheDir(compilationOptions.m_WeightEncoderCacheDir)
+    {}
+
+    /// Creates the pool to share between all the weight encoders of a compilation, or returns null if
+    /// CompilationOptions::m_NumWeightEncoderThreads means weights should be encoded on the calling thread.
+    static std::unique_ptr<ThreadPool> CreateThreadPool(const CompilationOptions& compilationOptions);
+
+    /// Pool to encode OFMs in parallel with, which must outlive the encoders. Null to encode serially on the
+    /// calling thread.
+    ThreadPool* m_ThreadPool = nullptr;
+    /// See CompilationOptions::m_WeightEncoderCacheDir. Empty to disable the cache.
+    std::string m_CacheDir;
+};
+
 class WeightEncoder
 {
 public:
     /**
      * Factory function that selects which weight encoder to use based on the hardware capabilities.
      */
-    static std::unique_ptr<WeightEncoder> CreateWeightEncoder(const HardwareCapabilities& capabilities);
+    static std::unique_ptr<WeightEncoder> CreateWeightEncoder(const HardwareCapabilities& capabilities,
+                                                              const WeightEncoderOptions& options = {});
 
-    WeightEncoder(const HardwareCapabilities& capabilities);
+    WeightEncoder(const HardwareCapabilities& capabilities, const WeightEncoderOptions& options = {});
 
-    virtual ~WeightEncoder() = default;
+    virtual ~WeightEncoder();
 
     EncodedWeights Encode(const MceOperationNode& mceOperation,
                           uint32_t stripeDepth,
@@ -77,6 +111,29 @@ public:
                           ethosn::command_stream::MceOperation operation,
                           CompilerMceAlgorithm algorithm);
 
+    /// Calculates the size and metadata of the weights that Encode would produce for the same arguments,
+    /// without producing the encoded data. The result is identical to that of Encode but is much cheaper
+    /// to calculate, so this should be used when only the size is of interest (e.g. performance estimation).
+    EncodedWeightsSize CalculateEncodedSize(const MceOperationNode& mceOperation,
+                                            uint32_t stripeDepth,
+                                            uint32_t stripeSize,
+                                            const QuantizationInfo& outputQuantizationInfo);
+
+    EncodedWeightsSize CalculateEncodedSize(const TensorInfo& weightsTensorInfo,
+                                            const uint8_t* weightsData,
+                                            const TensorInfo& biasTensorInfo,
+                                            const int32_t* biasData,
+                                            const QuantizationInfo& inputQuantizationInfo,
+                                            const QuantizationInfo& outputQuantizationInfo,
+                                            uint32_t stripeDepth,
+                                            uint32_t strideY,
+                                            uint32_t strideX,
+                                            uint32_t paddingTop,
+                                            uint32_t paddingLeft,
+                                            uint32_t iterationSize,
+                                            ethosn::command_stream::MceOperation operation,
+                                            CompilerMceAlgorithm algorithm);
+
 protected:
     struct EncodingParams
     {
@@ -99,7 +156,7 @@ protected:
     };
 
     // Calculates the exact offset and size in DRAM of each weight stripe
-    std::vector<WeightsMetadata> CalculateWeightsMetadata(const std::vector<std::vector<uint8_t>>& streamPerStripeOg,
+    std::vector<WeightsMetadata> CalculateWeightsMetadata(const std::vector<uint32_t>& streamPerStripeOgSizes,
                                                           uint32_t numOgPerStripe) const;
 
     /// Gets the raw (unencoded) stream for all the weights required to calculate a single OFM.
@@ -120,7 +177,16 @@ protected:
     virtual std::vector<std::unique_ptr<WeightCompressionParams>>
         GenerateCompressionParams(uint32_t numOfmInParallel) = 0;
 
+    /// Gets the index into the vector returned by GenerateCompressionParams of the compression parameters
+    /// which are shared between the given OFM and the previous OFMs encoded with the same index.
+    /// OFMs with different indices are encoded independently of each other.
+    virtual uint32_t
+        GetCompressionParamsIdx(uint32_t ofmIdx, uint32_t numOfmInParallel, uint32_t stripeDepth) const = 0;
+
     /// Encodes all the weights required to calculate a single OFM.
+    /// OFMs which share compression parameters must be encoded in order, but OFMs with different
+    /// compression parameters may be encoded concurrently.
+    /// If sizeOnly is set, the encoded data is not produced and only the size (m_NumOfBits) is returned.
     virtual EncodedOfm EncodeOfm(const uint8_t* weightData,
                                  uint32_t ofmIdx,
                                  uint32_t numOfmInParallel,
@@ -136,7 +202,8 @@ protected:
                                  ethosn::command_stream::MceOperation operation,
                                  CompilerMceAlgorithm algorithm,
                                  const EncodingParams& params,
-                                 std::vector<std::unique_ptr<WeightCompressionParams>>& compressionParams) = 0;
+                                 std::vector<std::unique_ptr<WeightCompressionParams>>& compressionParams,
+                                 bool sizeOnly) = 0;
 
     /// Merges the given streams of data into 'numGroups' groups, using a round-robin allocation of streams to groups.
     /// All the streams in a group are then concatenated together.
@@ -192,6 +259,55 @@ protected:
 
     /// Hardware capabilities.
     const HardwareCapabilities& m_Capabilities;
+
+private:
+    /// The encoded streams of every OFM, along with the values used to merge them together.
+    struct EncodedOfmStreams
+    {
+        /// Encoded data of each OFM (and each iteration of it). Empty when only the sizes were calculated.
+        std::vector<std::vector<uint8_t>> m_Streams;
+        /// Size in bits of each stream in m_Streams.
+        std::vector<uint32_t> m_NumBits;
+        uint32_t m_NumOfms;
+        uint32_t m_NumIterationsOfm;
+        uint32_t m_NumOfmInParallel;
+    };
+
+    EncodedOfmStreams EncodeOfmStreams(const TensorInfo& weightsTensorInfo,
+                                       const uint8_t* weightsData,
+                                       const TensorInfo& biasTensorInfo,
+                                       const int32_t* biasData,
+                                       const QuantizationInfo& inputQuantizationInfo,
+                                       const QuantizationInfo& outputQuantizationInfo,
+                                       uint32_t stripeDepth,
+                                       uint32_t strideY,
+                                       uint32_t strideX,
+                                       uint32_t paddingTop,
+                                       uint32_t paddingLeft,
+                                       uint32_t iterationSize,
+                                       ethosn::command_stream::MceOperation operation,
+                                       CompilerMceAlgorithm algorithm,
+                                       bool sizeOnly);
+
+    EncodedWeights EncodeUncached(const TensorInfo& weightsTensorInfo,
+                                  const uint8_t* weightsData,
+                                  const TensorInfo& biasTensorInfo,
+                                  const int32_t* biasData,
+                                  const QuantizationInfo& inputQuantizationInfo,
+                                  const QuantizationInfo& outputQuantizationInfo,
+                                  uint32_t stripeDepth,
+                                  uint32_t strideY,
+                                  uint32_t strideX,
+                                  uint32_t paddingTop,
+                                  uint32_t paddingLeft,
+                                  uint32_t iterationSize,
+                                  ethosn::command_stream::MceOperation operation,
+                                  CompilerMceAlgorithm algorithm);
+
+    /// See WeightEncoderOptions::m_ThreadPool.
+    ThreadPool* m_ThreadPool;
+    /// Null if the on-disk cache of encoded weights is disabled.
+    std::unique_ptr<WeightEncoderDiskCache> m_DiskCache;
 };
 
 }    // namespace support_library
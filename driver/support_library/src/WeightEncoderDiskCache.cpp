@@ -0,0 +1,205 @@
+//
+// Copyright © 2020 Arm Limited. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "WeightEncoderDiskCache.hpp"
+
+#include "CacheKey.hpp"
+#include "Utils.hpp"
+
+#include <ethosn_utils/Filesystem.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <thread>
+
+namespace ethosn
+{
+namespace support_library
+{
+
+using cache_key::Append;
+
+namespace
+{
+
+/// Must be incremented whenever a change is made which affects the output of the weight encoder or the layout
+/// of the cache entries, so that entries written by older versions are ignored.
+constexpr uint32_t g_WeightEncoderDiskCacheVersion = 2;
+
+struct EntryHeader
+{
+    char m_Magic[4];
+    uint32_t m_Version;
+    uint64_t m_KeySize;
+    uint64_t m_DataSize;
+    uint32_t m_NumMetadata;
+    uint32_t m_MaxSize;
+};
+
+constexpr char g_EntryMagic[4] = { 'E', 'N', 'W', 'C' };
+
+}    // namespace
+
+WeightEncoderDiskCache::WeightEncoderDiskCache(std::string dir)
+    : m_Dir(std::move(dir))
+{
+    // This fails if the directory already exists, which is fine
+    ethosn::utils::MakeDirectory(m_Dir.c_str());
+}
+
+std::vector<uint8_t> WeightEncoderDiskCache::CreateKey(const HardwareCapabilities& capabilities,
+                                                       const TensorInfo& weightsTensorInfo,
+                                                       const uint8_t* weightsData,
+                                                       const TensorInfo& biasTensorInfo,
+                                                       const int32_t* biasData,
+                                                       const QuantizationInfo& inputQuantizationInfo,
+                                                       const QuantizationInfo& outputQuantizationInfo,
+                                                       uint32_t stripeDepth,
+                                                       uint32_t strideY,
+                                                       uint32_t strideX,
+                                                       uint32_t paddingTop,
+                                                       uint32_t paddingLeft,
+                                                       uint32_t iterationSize,
+                                                       ethosn::command_stream::MceOperation operation,
+                                                       CompilerMceAlgorithm algorithm)
+{
+    const std::vector<char> capabilitiesData = capabilities.GetData();
+    const uint32_t weightsSize               = utils::TotalSizeBytes(weightsTensorInfo);
+    const uint32_t numBiases                 = utils::GetNumElements(biasTensorInfo.m_Dimensions);
+
+    std::vector<uint8_t> key;
+    key.reserve(capabilitiesData.size() + weightsSize + numBiases * sizeof(int32_t) + 256);
+
+    Append(key, capabilitiesData.data(), capabilitiesData.size());
+    Append(key, weightsTensorInfo);
+    Append(key, biasTensorInfo);
+    Append(key, inputQuantizationInfo);
+    Append(key, outputQuantizationInfo);
+    Append(key, stripeDepth);
+    Append(key, strideY);
+    Append(key, strideX);
+    Append(key, paddingTop);
+    Append(key, paddingLeft);
+    Append(key, iterationSize);
+    Append(key, operation);
+    Append(key, algorithm);
+    Append(key, weightsData, weightsSize);
+    Append(key, biasData, numBiases);
+
+    return cache_key::Digest(key);
+}
+
+std::string WeightEncoderDiskCache::GetEntryPath(const std::vector<uint8_t>& key) const
+{
+    std::stringstream path;
+    path << m_Dir << "/" << std::hex << std::setfill('0');
+    for (uint8_t byte : key)
+    {
+        path << std::setw(2) << static_cast<uint32_t>(byte);
+    }
+    path << ".bin";
+    return path.str();
+}
+
+bool WeightEncoderDiskCache::Load(const std::vector<uint8_t>& key, EncodedWeights& encodedWeights) const
+{
+    ethosn::utils::MappedFile file(GetEntryPath(key).c_str());
+    if (!file.IsValid() || file.GetSize() < sizeof(EntryHeader))
+    {
+        return false;
+    }
+
+    EntryHeader header;
+    std::memcpy(&header, file.GetData(), sizeof(header));
+    if (std::memcmp(header.m_Magic, g_EntryMagic, sizeof(g_EntryMagic)) != 0 ||
+        header.m_Version != g_WeightEncoderDiskCacheVersion || header.m_KeySize != key.size())
+    {
+        return false;
+    }
+
+    // The sizes in the header are untrusted, so each is checked against the bytes left rather than summing them,
+    // which could overflow
+    size_t remaining = file.GetSize() - sizeof(EntryHeader);
+    if (header.m_KeySize > remaining)
+    {
+        return false;
+    }
+    remaining -= key.size();
+    if (header.m_NumMetadata > remaining / sizeof(WeightsMetadata))
+    {
+        return false;
+    }
+    const size_t metadataSize = header.m_NumMetadata * sizeof(WeightsMetadata);
+    remaining -= metadataSize;
+    if (header.m_DataSize != remaining)
+    {
+        return false;
+    }
+
+    const uint8_t* keyBegin = file.GetData() + sizeof(EntryHeader);
+    if (std::memcmp(keyBegin, key.data(), key.size()) != 0)
+    {
+        return false;
+    }
+
+    const uint8_t* metadataBegin = keyBegin + header.m_KeySize;
+    encodedWeights.m_Metadata.resize(header.m_NumMetadata);
+    if (metadataSize > 0)
+    {
+        std::memcpy(encodedWeights.m_Metadata.data(), metadataBegin, metadataSize);
+    }
+
+    const uint8_t* dataBegin = metadataBegin + metadataSize;
+    encodedWeights.m_Data.assign(dataBegin, dataBegin + header.m_DataSize);
+    encodedWeights.m_MaxSize = header.m_MaxSize;
+
+    return true;
+}
+
+void WeightEncoderDiskCache::Store(const std::vector<uint8_t>& key, const EncodedWeights& encodedWeights) const
+{
+    EntryHeader header;
+    std::memcpy(header.m_Magic, g_EntryMagic, sizeof(g_EntryMagic));
+    header.m_Version     = g_WeightEncoderDiskCacheVersion;
+    header.m_KeySize     = key.size();
+    header.m_DataSize    = encodedWeights.m_Data.size();
+    header.m_NumMetadata = static_cast<uint32_t>(encodedWeights.m_Metadata.size());
+    header.m_MaxSize     = encodedWeights.m_MaxSize;
+
+    // Write to a file which no other thread or process will be using, then move it into place in one step.
+    const std::string path = GetEntryPath(key);
+    std::stringstream tmpPath;
+    tmpPath << path << ".tmp" << std::hex << std::hash<std::thread::id>()(std::this_thread::get_id()) << "_"
+            << std::random_device()();
+
+    {
+        std::ofstream out(tmpPath.str(), std::ios::binary);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(key.data()), static_cast<std::streamsize>(key.size()));
+        out.write(reinterpret_cast<const char*>(encodedWeights.m_Metadata.data()),
+                  static_cast<std::streamsize>(encodedWeights.m_Metadata.size() * sizeof(WeightsMetadata)));
+        out.write(reinterpret_cast<const char*>(encodedWeights.m_Data.data()),
+                  static_cast<std::streamsize>(encodedWeights.m_Data.size()));
+        out.close();
+        if (!out.good())
+        {
+            std::remove(tmpPath.str().c_str());
+            return;
+        }
+    }
+
+    if (std::rename(tmpPath.str().c_str(), path.c_str()) != 0)
+    {
+        std::remove(tmpPath.str().c_str());
+    }
+}
+
+}    // namespace support_library
+}    // namespace ethosn
@@ -0,0 +1,62 @@
+//
+// Copyright © 2020 Arm Limited. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include "WeightEncoder.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ethosn
+{
+namespace support_library
+{
+
+/// A content-addressed cache of encoded weights stored as one file per entry in a directory on disk,
+/// so that the results of encoding are shared between compilations and between processes.
+///
+/// Each entry is named after its key and also stores it, which is compared when the entry is loaded so that a
+/// renamed or truncated file is never used.
+/// Entries are written to a temporary file which is then renamed, so concurrent readers and writers never see a
+/// partially written entry. All errors are treated as cache misses.
+class WeightEncoderDiskCache
+{
+public:
+    explicit WeightEncoderDiskCache(std::string dir);
+
+    /// Creates the key which identifies the result of encoding the given weights.
+    /// This is the digest of everything the encoded weights depend on.
+    static std::vector<uint8_t> CreateKey(const HardwareCapabilities& capabilities,
+                                          const TensorInfo& weightsTensorInfo,
+                                          const uint8_t* weightsData,
+                                          const TensorInfo& biasTensorInfo,
+                                          const int32_t* biasData,
+                                          const QuantizationInfo& inputQuantizationInfo,
+                                          const QuantizationInfo& outputQuantizationInfo,
+                                          uint32_t stripeDepth,
+                                          uint32_t strideY,
+                                          uint32_t strideX,
+                                          uint32_t paddingTop,
+                                          uint32_t paddingLeft,
+                                          uint32_t iterationSize,
+                                          ethosn::command_stream::MceOperation operation,
+                                          CompilerMceAlgorithm algorithm);
+
+    /// Looks up the entry with the given key. Returns false if there is no valid entry.
+    bool Load(const std::vector<uint8_t>& key, EncodedWeights& encodedWeights) const;
+
+    /// Adds or replaces the entry with the given key.
+    void Store(const std::vector<uint8_t>& key, const EncodedWeights& encodedWeights) const;
+
+private:
+    std::string GetEntryPath(const std::vector<uint8_t>& key) const;
+
+    std::string m_Dir;
+};
+
+}    // namespace support_library
+}    // namespace ethosn
@@ -102,7 +102,7 @@ public:
         bool m_InitialParameters;
     };
 
-    WeightEncoderV2(const HardwareCapabilities& capabilities);
+    WeightEncoderV2(const HardwareCapabilities& capabilities, const WeightEncoderOptions& options = {});
 
     WeightEncoderV2(const HardwareCapabilities& capabilities,
                     WeightCompMode mode,
@@ -131,11 +131,15 @@ protected:
                                  ethosn::command_stream::MceOperation operation,
                                  CompilerMceAlgorithm algorithm,
                                  const EncodingParams& params,
-                                 std::vector<std::unique_ptr<WeightCompressionParams>>& compressionParams) override;
+                                 std::vector<std::unique_ptr<WeightCompressionParams>>& compressionParams,
+                                 bool sizeOnly) override;
 
     virtual std::vector<std::unique_ptr<WeightCompressionParams>>
         GenerateCompressionParams(uint32_t numOfmInParallel) override;
 
+    virtual uint32_t
+        GetCompressionParamsIdx(uint32_t ofmIdx, uint32_t numOfmInParallel, uint32_t stripeDepth) const override;
+
     uint8_t WeightOffsetClamp(WeightSymbol offset) const
     {
         constexpr uint8_t maxWeightOffset = 31;
@@ -70,7 +70,8 @@ void SaveDebugFilesForEstimatedCombination(std::string folder,
 GraphOfParts CreateGraphOfParts(const Graph& graph,
                                 const EstimationOptions& estOpt,
                                 const CompilationOptions& compOpt,
-                                const HardwareCapabilities& capabilities)
+                                const HardwareCapabilities& capabilities,
+                                const WeightEncoderOptions& weightEncoderOptions)
 {
     GraphOfParts graphOfParts;
     Parts& parts = graphOfParts.m_Parts;
@@ -78,7 +79,7 @@ GraphOfParts CreateGraphOfParts(const Graph& graph,
     auto AddNodeToPart    = [](Node* node, Part& part) -> void { part.m_SubGraph.push_back(node); };
     auto AddNodeToNewPart = [&](Node* node) -> void {
         // Insert node into new part.
-        parts.push_back(std::make_unique<Part>(estOpt, compOpt, capabilities));
+        parts.push_back(std::make_unique<Part>(estOpt, compOpt, capabilities, weightEncoderOptions));
         AddNodeToPart(node, *(parts.back()));
     };
     auto FindPartFromSourceAndAddNode = [&](Node* ppOpNode) -> void {
@@ -160,9 +161,11 @@ void CreatePlans(Parts& parts)
 
 Cascading::Cascading(const EstimationOptions& estOpt,
                      const CompilationOptions& compOpt,
-                     const HardwareCapabilities& hwCap)
+                     const HardwareCapabilities& hwCap,
+                     const WeightEncoderOptions& weightEncoderOptions)
     : IEstimationStrategy(estOpt, compOpt, hwCap)
     , m_BestCombination(nullptr)
+    , m_WeightEncoderOptions(weightEncoderOptions)
 {
     // Constructor
 }
@@ -172,7 +175,8 @@ Cascading::~Cascading()
 
 NetworkPerformanceData Cascading::Estimate(Graph& graph)
 {
-    m_GraphOfParts = CreateGraphOfParts(graph, m_EstimationOptions, m_CompilationOptions, m_Capabilities);
+    m_GraphOfParts = CreateGraphOfParts(graph, m_EstimationOptions, m_CompilationOptions, m_Capabilities,
+                                        m_WeightEncoderOptions);
 
     m_DebuggingContext.SaveGraphToDot(CompilationOptions::DebugLevel::Medium, graph, &m_GraphOfParts,
                                       "Cascaded_GraphOfParts.dot", DetailLevel::Low);
@@ -250,8 +254,8 @@ void Cascading::EstimatePerformance()
         try
         {
             OpGraph combiOpGraph = GetOpGraphForCombination(combination, m_GraphOfParts);
-            EstimatedOpGraph curNetPerfData =
-                ethosn::support_library::EstimateOpGraph(combiOpGraph, m_Capabilities, GetEstimationOptions());
+            EstimatedOpGraph curNetPerfData = ethosn::support_library::EstimateOpGraph(
+                combiOpGraph, m_Capabilities, GetEstimationOptions(), &m_PassStatsCache);
 
             if (m_DebuggingContext.m_DebugInfo->m_DumpDebugFiles >= CompilationOptions::DebugLevel::Medium)
             {
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "Combiner.hpp"
+#include "Estimation.hpp"
 #include "IEstimationStrategy.hpp"
 #include "Part.hpp"
 
@@ -22,7 +23,10 @@ struct DebuggingContext;
 class Cascading : public IEstimationStrategy
 {
 public:
-    Cascading(const EstimationOptions& estOpt, const CompilationOptions& compOpt, const HardwareCapabilities& caps);
+    Cascading(const EstimationOptions& estOpt,
+              const CompilationOptions& compOpt,
+              const HardwareCapabilities& caps,
+              const WeightEncoderOptions& weightEncoderOptions);
     virtual ~Cascading();
 
     const GraphOfParts& GetGraphOfParts() const;
@@ -38,14 +42,19 @@ private:
     NetworkPerformanceData m_PerformanceStream;
     const Combination* m_BestCombination;
     Metadata m_Metadata;
+    /// Stats of the passes estimated for the Combinations of the Plans and Glues in m_Metadata.
+    /// Cleared whenever m_Metadata is re-created, as it refers to the Ops and Buffers in the Plans and Glues.
+    PassStatsCache m_PassStatsCache;
     Combinations m_ValidCombinations;
     GraphOfParts m_GraphOfParts;
+    const WeightEncoderOptions& m_WeightEncoderOptions;
 };
 
 GraphOfParts CreateGraphOfParts(const Graph& graph,
                                 const EstimationOptions& estOpt,
                                 const CompilationOptions& compOpt,
-                                const HardwareCapabilities& capabilities);
+                                const HardwareCapabilities& capabilities,
+                                const WeightEncoderOptions& weightEncoderOptions);
 
 }    // namespace support_library
 }    // namespace ethosn
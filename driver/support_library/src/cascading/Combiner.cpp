@@ -6,6 +6,7 @@
 #include "Combiner.hpp"
 
 #include "../SramAllocator.hpp"
+#include "../ThreadPool.hpp"
 #include "../Utils.hpp"
 #include "Cascading.hpp"
 #include "DebuggingContext.hpp"
@@ -17,6 +18,7 @@
 
 #include <array>
 #include <fstream>
+#include <future>
 #include <list>
 
 namespace ethosn
@@ -481,7 +483,43 @@ PlanCompatibilityResult
     return PlanCompatibilityResult{};
 }
 
-Metadata CreateMetadata(const GraphOfParts& parts, const HardwareCapabilities& hwCap)
+namespace
+{
+
+/// Finds all the plans of the destination part which are compatible with the given plan of the source part
+/// along the given edge, skipping the destination plans which are already known to be incompatible.
+CompatiblePlans FindCompatiblePlans(const Plan& fPl,
+                                    const Part& sPart,
+                                    const std::vector<PlanId>& incompPlansOfDstPart,
+                                    const Edge& dsEdge,
+                                    const bool reqDram,
+                                    const HardwareCapabilities& hwCap)
+{
+    CompatiblePlans cPls;
+    for (uint32_t s = 0; s < sPart.GetNumPlans(); ++s)
+    {
+        if (incompPlansOfDstPart.end() != std::find(incompPlansOfDstPart.begin(), incompPlansOfDstPart.end(), s))
+        {
+            // Skip this plan.
+            continue;
+        }
+        const Plan& sPl                   = sPart.GetPlan(s);
+        PlanCompatibilityResult plCompRes = ArePlansCompatible(fPl, sPl, dsEdge, hwCap);
+        if (plCompRes.m_IsCompatible)
+        {
+            if (reqDram && !IsOutputBufferInDram(fPl, dsEdge) && !plCompRes.m_RequiresGlue)
+            {
+                continue;
+            }
+            cPls.push_back(CompatiblePlan{ std::move(plCompRes.m_Glue), s });
+        }
+    }
+    return cPls;
+}
+
+}    // namespace
+
+Metadata CreateMetadata(const GraphOfParts& parts, const HardwareCapabilities& hwCap, const uint32_t numThreads)
 {
     const size_t numParts = parts.GetNumParts();
     assert(numParts > 1U);
@@ -492,7 +530,12 @@ Metadata CreateMetadata(const GraphOfParts& parts, const HardwareCapabilities& h
 
     MetadataOfPart mOfPa;
     CompatiblePlansOfPart comPlsOfPa;
-    CompatiblePlans cPls;
+
+    std::unique_ptr<ThreadPool> threadPool;
+    if (numThreads != 1)
+    {
+        threadPool = std::make_unique<ThreadPool>(numThreads);
+    }
 
     // This loop goes backward to remove all incompatible
     // plans before they are used by any source part.
@@ -502,18 +545,23 @@ Metadata CreateMetadata(const GraphOfParts& parts, const HardwareCapabilities& h
         mOfPa.m_Comp.clear();
         mOfPa.m_Source.clear();
         mOfPa.m_Destination.clear();
-        comPlsOfPa.clear();
 
         const Part& fPart                      = parts.GetPart(p);
         mOfPa.m_PartId                         = p;
         const std::vector<const Edge*> dsEdges = fPart.GetOutputs();
+
+        // The compatible plans of each plan of this part along each output edge only depend on the parts
+        // after this one, so can all be found in parallel. Each result is stored in its own slot so that
+        // the metadata is the same regardless of the order in which they are found.
+        std::vector<std::vector<CompatiblePlans>> cPlsOfEdges(dsEdges.size());
+        std::vector<std::future<void>> tasksDone;
         for (uint32_t n = 0; n < dsEdges.size(); ++n)
         {
             const Edge* dsEdge = dsEdges.at(n);
 
             const InPart inPa = parts.GetInputPart(*dsEdge);
             assert(inPa.first == true);
-            const std::vector<PlanId> incompPlansOfDstPart = incompPlans.at(inPa.second);
+            const std::vector<PlanId>& incompPlansOfDstPart = incompPlans.at(inPa.second);
 
             const Part& sPart = parts.GetPart(inPa.second);
             // Requires Dram if the part is not directly connected with next part
@@ -521,31 +569,41 @@ Metadata CreateMetadata(const GraphOfParts& parts, const HardwareCapabilities& h
             // part has multiple inputs
             const bool reqDram = ((p + 1U) != inPa.second) || (dsEdges.size() > 1U) || (sPart.GetInputs().size() > 1U);
 
+            cPlsOfEdges[n].resize(fPart.GetNumPlans());
             for (uint32_t f = 0; f < fPart.GetNumPlans(); ++f)
             {
-                cPls.clear();
-
-                const Plan& fPl = fPart.GetPlan(f);
-
-                for (uint32_t s = 0; s < sPart.GetNumPlans(); ++s)
+                const Plan& fPl          = fPart.GetPlan(f);
+                CompatiblePlans& cPls    = cPlsOfEdges[n][f];
+                auto findCompatiblePlans = [&cPls, &fPl, &sPart, &incompPlansOfDstPart, dsEdge, reqDram, &hwCap]() {
+                    cPls = FindCompatiblePlans(fPl, sPart, incompPlansOfDstPart, *dsEdge, reqDram, hwCap);
+                };
+                if (threadPool)
                 {
-                    if (incompPlansOfDstPart.end() !=
-                        std::find(incompPlansOfDstPart.begin(), incompPlansOfDstPart.end(), s))
-                    {
-                        // Skip this plan.
-                        continue;
-                    }
-                    const Plan& sPl                   = sPart.GetPlan(s);
-                    PlanCompatibilityResult plCompRes = ArePlansCompatible(fPl, sPl, *dsEdge, hwCap);
-                    if (plCompRes.m_IsCompatible)
-                    {
-                        if (reqDram && !IsOutputBufferInDram(fPl, *dsEdge) && !plCompRes.m_RequiresGlue)
-                        {
-                            continue;
-                        }
-                        cPls.push_back(CompatiblePlan{ std::move(plCompRes.m_Glue), s });
-                    }
+                    tasksDone.push_back(threadPool->AddTask(findCompatiblePlans));
+                }
+                else
+                {
+                    findCompatiblePlans();
                 }
+            }
+        }
+
+        // Wait for all the tasks before rethrowing any exception, as they reference local variables
+        for (std::future<void>& t : tasksDone)
+        {
+            t.wait();
+        }
+        for (std::future<void>& t : tasksDone)
+        {
+            t.get();
+        }
+
+        for (uint32_t n = 0; n < dsEdges.size(); ++n)
+        {
+            comPlsOfPa.clear();
+            for (uint32_t f = 0; f < fPart.GetNumPlans(); ++f)
+            {
+                CompatiblePlans& cPls = cPlsOfEdges[n][f];
                 if (cPls.size() > 0)
                 {
                     comPlsOfPa.insert(std::make_pair(f, std::move(cPls)));
@@ -559,7 +617,7 @@ Metadata CreateMetadata(const GraphOfParts& parts, const HardwareCapabilities& h
             size_t comSize = comPlsOfPa.size();
             if (comSize > 0)
             {
-                mOfPa.m_Comp.insert(std::make_pair(dsEdge, std::move(comPlsOfPa)));
+                mOfPa.m_Comp.insert(std::make_pair(dsEdges.at(n), std::move(comPlsOfPa)));
             }
         }
         size_t sizeOfCompatiblePlan = mOfPa.m_Comp.size();
@@ -731,7 +789,8 @@ GrownSeeds GrowSeeds(const Combinations& combs,
 Combination PruneCombinations(const GraphOfParts& parts,
                               const HardwareCapabilities& caps,
                               const Combinations& combs,
-                              const EstimationOptions& estimationOpts)
+                              const EstimationOptions& estimationOpts,
+                              PassStatsCache* passStatsCache = nullptr)
 {
     if (combs.size() > 0)
     {
@@ -743,7 +802,7 @@ Combination PruneCombinations(const GraphOfParts& parts,
             {
                 OpGraph combiOpGraph = GetOpGraphForCombination(combination, parts);
                 EstimatedOpGraph curNetPerfData =
-                    ethosn::support_library::EstimateOpGraph(combiOpGraph, caps, estimationOpts);
+                    ethosn::support_library::EstimateOpGraph(combiOpGraph, caps, estimationOpts, passStatsCache);
 
                 if (!result.has_value() ||
                     utils::IsLeftMoreDataPerformantThanRight(curNetPerfData.m_PerfData, refNetPerfData))
@@ -771,7 +830,8 @@ Combinations Cascading::Combine(const GraphOfParts& parts)
 {
     using namespace ethosn::utils;
 
-    m_Metadata = CreateMetadata(parts, m_Capabilities);
+    m_PassStatsCache.Clear();
+    m_Metadata = CreateMetadata(parts, m_Capabilities, m_CompilationOptions.m_NumCascadingThreads);
 
     if (m_DebuggingContext.m_DebugInfo->m_DumpDebugFiles >= CompilationOptions::DebugLevel::High)
     {
@@ -837,7 +897,8 @@ Combinations Cascading::Combine(const GraphOfParts& parts)
                 currSeeds = history.front();
                 history.clear();
             }
-            pruned.push_back(PruneCombinations(parts, m_Capabilities, currSeeds, GetEstimationOptions()));
+            pruned.push_back(
+                PruneCombinations(parts, m_Capabilities, currSeeds, GetEstimationOptions(), &m_PassStatsCache));
             grownSeeds = GrowSeeds(pruned, parts, 0U, m_Metadata, m_Capabilities, GrowScheme::DramOnly);
         }
         currSeeds = grownSeeds.m_Combinations;
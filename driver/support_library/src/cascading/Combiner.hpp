@@ -205,7 +205,9 @@ PlanCompatibilityResult
 //
 // For each plan in PartX list all the compatible plans of PartY.
 // No SRAM allocation verification is performed at this stage.
-Metadata CreateMetadata(const GraphOfParts&, const HardwareCapabilities&);
+// The compatible plans are found using the given number of threads (see ThreadPool),
+// and the result does not depend on this.
+Metadata CreateMetadata(const GraphOfParts&, const HardwareCapabilities&, const uint32_t numThreads = 1);
 
 // Create the seeds from which all the combinations are going to be derived.
 // The seeds are created from the first part in topological order.
@@ -33,13 +33,29 @@ DataFormat GetWeightsFormat(const MceOp& mceOp)
 
 }    // namespace
 
+PassStats PassStatsCache::GetOrCalculate(const Key& key, const std::function<PassStats()>& calculate)
+{
+    auto it = m_Stats.find(key);
+    if (it == m_Stats.end())
+    {
+        it = m_Stats.emplace(key, calculate()).first;
+    }
+    return it->second;
+}
+
+void PassStatsCache::Clear()
+{
+    m_Stats.clear();
+}
+
 /// Estimates a pass that contains the given Op and possibly some of its neighbours.
 /// Removes Ops from the given unestimatedOps set that it has included in its estimation.
 EstimatedPass EstimatePassGrownFrom(const OpGraph& opGraph,
                                     Op* op,
                                     const HardwareCapabilities& capabilities,
                                     const EstimationOptions& estimationOpts,
-                                    std::unordered_set<Op*>& unestimatedOps)
+                                    std::unordered_set<Op*>& unestimatedOps,
+                                    PassStatsCache* passStatsCache)
 {
     EstimatedPass result;
 
@@ -48,6 +64,11 @@ EstimatedPass EstimatePassGrownFrom(const OpGraph& opGraph,
         result.m_Ops.insert(op);
     };
 
+    // First find the Ops in the pass and the Buffers that its stats depend on, then calculate the stats from those.
+    // These Ops and Buffers identify the pass in the PassStatsCache, so all of them are recorded in the key,
+    // in the order they are found (with null placeholders for optional ones that are not present).
+    PassStatsCache::Key key;
+
     assert(unestimatedOps.count(op) > 0);
     MceOp* mceOp = GetObjectAs<MceOp>(op);
     PleOp* pleOp = GetObjectAs<PleOp>(op);
@@ -86,15 +107,14 @@ EstimatedPass EstimatePassGrownFrom(const OpGraph& opGraph,
             }
         }
     }
-
-    // Calculate MCE and weight stats if we have an MceOp
-    // Remember weights info as we need it for the input stats. Set a default in case we have no weights (i.e. Ple-only)
-    TensorInfo weightsTensorInfo = {
-        { { 1, 1, 1, 1 } },
-        DataType::UINT8_QUANTIZED,
-        DataFormat::HWIM,
-        { 0, 0.1f },
-    };
+    key.push_back(mceOp);
+    key.push_back(pleOp);
+
+    // Find the buffers needed for the MCE and weight stats if we have an MceOp
+    Buffer* mceInputBuffer  = nullptr;
+    Buffer* weightsSram     = nullptr;
+    Buffer* weightsDram     = nullptr;
+    Buffer* mceOutputBuffer = nullptr;
     if (mceOp != nullptr)
     {
         // Check for weights as second input to the MceOp
@@ -102,13 +122,9 @@ EstimatedPass EstimatePassGrownFrom(const OpGraph& opGraph,
         {
             throw NotSupportedException("MceOp must have exactly 2 inputs");
         }
-        Buffer* inputBuffer     = opGraph.GetInputs(mceOp)[0];
-        Buffer* weightsSram     = opGraph.GetInputs(mceOp)[1];
-        Buffer* mceOutputBuffer = opGraph.GetOutput(mceOp);    // Validated above that this is non-null
-
-        result.m_Stats.m_Mce =
-            GetMceStats(capabilities, mceOp->m_Stride, mceOp->m_Op, mceOp->m_Algo, inputBuffer->m_TensorShape,
-                        mceOutputBuffer->m_TensorShape, weightsSram->m_TensorShape);
+        mceInputBuffer  = opGraph.GetInputs(mceOp)[0];
+        weightsSram     = opGraph.GetInputs(mceOp)[1];
+        mceOutputBuffer = opGraph.GetOutput(mceOp);    // Validated above that this is non-null
 
         if (weightsSram->m_Location != Location::Sram)
         {
@@ -123,7 +139,7 @@ EstimatedPass EstimatePassGrownFrom(const OpGraph& opGraph,
         {
             throw NotSupportedException("DmaOp must have exactly one input");
         }
-        Buffer* weightsDram = opGraph.GetInputs(dmaOp)[0];
+        weightsDram = opGraph.GetInputs(dmaOp)[0];
         if (weightsDram->m_Location != Location::Dram)
         {
             throw NotSupportedException("Weights buffer must be Dma'd from Dram");
@@ -133,28 +149,20 @@ EstimatedPass EstimatePassGrownFrom(const OpGraph& opGraph,
             throw NotSupportedException("Weights Dram buffer must not have a producer");
         }
 
-        weightsTensorInfo = TensorInfo(weightsDram->m_TensorShape, DataType::UINT8_QUANTIZED, GetWeightsFormat(*mceOp),
-                                       weightsDram->m_QuantizationInfo);
-        result.m_Stats.m_Weights =
-            GetWeightsStats(capabilities, *weightsDram->m_EncodedWeights, weightsTensorInfo, weightsSram->m_StripeShape,
-                            weightsSram->m_SizeInBytes, inputBuffer->m_TensorShape, inputBuffer->m_StripeShape);
-
         includeOp(dmaOp);
         includeOp(mceOp);
     }
+    key.insert(key.end(), { mceInputBuffer, weightsSram, weightsDram, mceOutputBuffer });
 
-    // Calculate PLE stats if we have a PleOp
+    // Find the input buffers needed for the PLE stats if we have a PleOp
+    OpGraph::BufferList pleInputBuffers;
     if (pleOp != nullptr)
     {
-        std::vector<TensorShape> inputShapes;
-        for (Buffer* inputBuffer : opGraph.GetInputs(pleOp))
-        {
-            inputShapes.push_back(inputBuffer->m_TensorShape);
-        }
-
-        result.m_Stats.m_Ple = GetPleStats(capabilities, inputShapes, pleOp->m_Op);
+        pleInputBuffers = opGraph.GetInputs(pleOp);
         includeOp(pleOp);
     }
+    key.insert(key.end(), pleInputBuffers.begin(), pleInputBuffers.end());
+    key.push_back(nullptr);
 
     Op* frontOp = mceOp ? static_cast<Op*>(mceOp) : pleOp;
     Op* backOp  = pleOp;
@@ -164,9 +172,17 @@ EstimatedPass EstimatePassGrownFrom(const OpGraph& opGraph,
     {
         throw NotSupportedException("Must have an output buffer");
     }
+    key.push_back(sramOutputBuffer);
 
     // Check for a DmaOp beforehand, and use that to calculate input stats
     // Do this for each input
+    struct PassInput
+    {
+        Buffer* m_SramBuffer;
+        /// The buffer that is Dma'd into m_SramBuffer as part of this pass, if any.
+        Buffer* m_DmaInputBuffer;
+    };
+    std::vector<PassInput> inputs;
     for (uint32_t inputIdx = 0; inputIdx < opGraph.GetInputs(frontOp).size(); ++inputIdx)
     {
         if (frontOp == mceOp && inputIdx > 0)
@@ -182,73 +198,118 @@ EstimatedPass EstimatePassGrownFrom(const OpGraph& opGraph,
         {
             throw NotSupportedException("Input buffer to PleOp/MceOp must be in Sram");
         }
-        Location inputLocation = Location::Sram;
-        bool isCompressed      = false;
-        DmaOp* dmaOp           = GetObjectAs<DmaOp>(opGraph.GetProducer(sramInputBuffer));
+        Buffer* dramBuffer = nullptr;
+        DmaOp* dmaOp       = GetObjectAs<DmaOp>(opGraph.GetProducer(sramInputBuffer));
         if (dmaOp != nullptr && unestimatedOps.count(dmaOp) > 0)
         {
             if (opGraph.GetInputs(dmaOp).size() != 1)
             {
                 throw NotSupportedException("DmaOp must have exactly one input");
             }
-            Buffer* dramBuffer = opGraph.GetInputs(dmaOp)[0];
-            inputLocation      = dramBuffer->m_Location;
-            isCompressed       = IsCompressed(dramBuffer->m_Format);
+            dramBuffer = opGraph.GetInputs(dmaOp)[0];
             includeOp(dmaOp);
         }
-
-        // Number of output stripes affects the number of input data reloads for some streaming strategies.
-        uint32_t numOutStripeC =
-            utils::DivRoundUp(sramOutputBuffer->m_TensorShape[3], sramOutputBuffer->m_StripeShape[3]);
-
-        const InputStats uncompressedStats =
-            GetInputStats(capabilities, sramInputBuffer->m_TensorShape, sramInputBuffer->m_StripeShape, inputLocation,
-                          sramInputBuffer->m_SizeInBytes, weightsTensorInfo, numOutStripeC);
-        const InputStats inputStats =
-            isCompressed
-                ? AccountForActivationCompression(uncompressedStats, estimationOpts.m_ActivationCompressionSaving)
-                : uncompressedStats;
-        result.m_Stats.m_Input += inputStats;
+        inputs.push_back({ sramInputBuffer, dramBuffer });
+        key.insert(key.end(), { sramInputBuffer, dramBuffer });
     }
+    key.push_back(nullptr);
 
     // Check for a DmaOp afterwards, and use that to calculate output stats
+    if (sramOutputBuffer->m_Location != Location::Sram)
+    {
+        throw NotSupportedException("Output buffer from PleOp must be in Sram");
+    }
+    Buffer* dmaOutputBuffer = nullptr;
+    if (opGraph.GetConsumers(sramOutputBuffer).size() == 1)
     {
-        if (sramOutputBuffer->m_Location != Location::Sram)
+        DmaOp* dmaOp = GetObjectAs<DmaOp>(opGraph.GetConsumers(sramOutputBuffer)[0].first);
+        if (dmaOp != nullptr && unestimatedOps.count(dmaOp) > 0)
         {
-            throw NotSupportedException("Output buffer from PleOp must be in Sram");
+            dmaOutputBuffer = opGraph.GetOutput(dmaOp);
+            if (dmaOutputBuffer == nullptr)
+            {
+                throw NotSupportedException("Output Dma op must have an output");
+            }
+            includeOp(dmaOp);
         }
-        Location outputLocation      = Location::Sram;
-        CascadingBufferFormat format = sramOutputBuffer->m_Format;
-        bool isCompressed            = false;
-        if (opGraph.GetConsumers(sramOutputBuffer).size() == 1)
+    }
+    key.push_back(dmaOutputBuffer);
+
+    auto calculateStats = [&]() {
+        PassStats stats;
+
+        // Calculate MCE and weight stats if we have an MceOp
+        // Remember weights info as we need it for the input stats. Set a default in case we have no weights (i.e. Ple-only)
+        TensorInfo weightsTensorInfo = {
+            { { 1, 1, 1, 1 } },
+            DataType::UINT8_QUANTIZED,
+            DataFormat::HWIM,
+            { 0, 0.1f },
+        };
+        if (mceOp != nullptr)
+        {
+            stats.m_Mce =
+                GetMceStats(capabilities, mceOp->m_Stride, mceOp->m_Op, mceOp->m_Algo, mceInputBuffer->m_TensorShape,
+                            mceOutputBuffer->m_TensorShape, weightsSram->m_TensorShape);
+
+            weightsTensorInfo = TensorInfo(weightsDram->m_TensorShape, DataType::UINT8_QUANTIZED,
+                                           GetWeightsFormat(*mceOp), weightsDram->m_QuantizationInfo);
+            stats.m_Weights   = GetWeightsStats(capabilities, weightsDram->m_EncodedWeightsSize->m_Metadata,
+                                              weightsDram->m_EncodedWeightsSize->m_Size, weightsTensorInfo,
+                                              weightsSram->m_StripeShape, weightsSram->m_SizeInBytes,
+                                              mceInputBuffer->m_TensorShape, mceInputBuffer->m_StripeShape);
+        }
+
+        // Calculate PLE stats if we have a PleOp
+        if (pleOp != nullptr)
         {
-            DmaOp* dmaOp = GetObjectAs<DmaOp>(opGraph.GetConsumers(sramOutputBuffer)[0].first);
-            if (dmaOp != nullptr && unestimatedOps.count(dmaOp) > 0)
+            std::vector<TensorShape> inputShapes;
+            for (Buffer* inputBuffer : pleInputBuffers)
             {
-                Buffer* dmaOutput = opGraph.GetOutput(dmaOp);
-                if (dmaOutput == nullptr)
-                {
-                    throw NotSupportedException("Output Dma op must have an output");
-                }
-                outputLocation = dmaOutput->m_Location;
-                format         = dmaOutput->m_Format;
-                isCompressed   = IsCompressed(format);
-                includeOp(dmaOp);
+                inputShapes.push_back(inputBuffer->m_TensorShape);
             }
+
+            stats.m_Ple = GetPleStats(capabilities, inputShapes, pleOp->m_Op);
+        }
+
+        for (const PassInput& input : inputs)
+        {
+            const Location inputLocation = input.m_DmaInputBuffer ? input.m_DmaInputBuffer->m_Location : Location::Sram;
+            const bool isCompressed      = input.m_DmaInputBuffer && IsCompressed(input.m_DmaInputBuffer->m_Format);
+
+            // Number of output stripes affects the number of input data reloads for some streaming strategies.
+            uint32_t numOutStripeC =
+                utils::DivRoundUp(sramOutputBuffer->m_TensorShape[3], sramOutputBuffer->m_StripeShape[3]);
+
+            const InputStats uncompressedStats =
+                GetInputStats(capabilities, input.m_SramBuffer->m_TensorShape, input.m_SramBuffer->m_StripeShape,
+                              inputLocation, input.m_SramBuffer->m_SizeInBytes, weightsTensorInfo, numOutStripeC);
+            const InputStats inputStats =
+                isCompressed
+                    ? AccountForActivationCompression(uncompressedStats, estimationOpts.m_ActivationCompressionSaving)
+                    : uncompressedStats;
+            stats.m_Input += inputStats;
         }
 
+        const Location outputLocation      = dmaOutputBuffer ? dmaOutputBuffer->m_Location : Location::Sram;
+        const CascadingBufferFormat format = dmaOutputBuffer ? dmaOutputBuffer->m_Format : sramOutputBuffer->m_Format;
+        const bool isCompressed            = dmaOutputBuffer && IsCompressed(format);
+
         const TensorShape& roundedUpOutputShape =
             format != CascadingBufferFormat::NHWC ? RoundUpHeightAndWidthToBrickGroup(sramOutputBuffer->m_TensorShape)
                                                   : sramOutputBuffer->m_TensorShape;
 
         const OutputStats uncompressedStats =
             GetOutputStats(roundedUpOutputShape, sramOutputBuffer->m_StripeShape, outputLocation);
-        result.m_Stats.m_Output =
+        stats.m_Output =
             isCompressed
                 ? AccountForActivationCompression(uncompressedStats, estimationOpts.m_ActivationCompressionSaving)
                 : uncompressedStats;
-    }
 
+        return stats;
+    };
+
+    result.m_Stats = passStatsCache ? passStatsCache->GetOrCalculate(key, calculateStats) : calculateStats();
     return result;
 }
 
@@ -305,7 +366,8 @@ std::string GetParentIds(const EstimatedOpGraph& estimatedOpGraph,
 
 EstimatedOpGraph EstimateOpGraph(const OpGraph& opGraph,
                                  const HardwareCapabilities& capabilities,
-                                 const EstimationOptions& estimationOpts)
+                                 const EstimationOptions& estimationOpts,
+                                 PassStatsCache* passStatsCache)
 {
     EstimatedOpGraph result;
 
@@ -327,7 +389,7 @@ EstimatedOpGraph EstimateOpGraph(const OpGraph& opGraph,
         if (IsObjectOfType<MceOp>(op) || IsObjectOfType<PleOp>(op))
         {
             EstimatedPass estimatedPass =
-                EstimatePassGrownFrom(opGraph, op, capabilities, estimationOpts, unestimatedOps);
+                EstimatePassGrownFrom(opGraph, op, capabilities, estimationOpts, unestimatedOps, passStatsCache);
 
             result.m_PerfData.m_Stream.push_back({});
             PassPerformanceData& passData = result.m_PerfData.m_Stream.back();
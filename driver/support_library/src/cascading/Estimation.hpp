@@ -8,8 +8,11 @@
 #include "../include/ethosn_support_library/Support.hpp"
 #include "Combiner.hpp"
 
+#include <functional>
+#include <map>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace ethosn
 {
@@ -23,11 +26,32 @@ struct EstimatedPass
     std::unordered_set<Op*> m_Ops;
 };
 
+/// Caches the stats of the passes estimated by EstimatePassGrownFrom, so that estimating many OpGraphs which share
+/// most of their Ops and Buffers (e.g. those for different Combinations of the same Plans and Glues) only needs to
+/// calculate the stats of each distinct pass once.
+/// Passes are identified by the addresses of their Ops and Buffers, so these must not be modified or destroyed while
+/// the cache is in use. A cache must only be used with a single set of HardwareCapabilities and EstimationOptions.
+class PassStatsCache
+{
+public:
+    /// The Ops and Buffers which the stats of a pass are calculated from.
+    using Key = std::vector<const DebuggableObject*>;
+
+    /// Returns the cached stats for the given key, first calculating them with the given function if necessary.
+    PassStats GetOrCalculate(const Key& key, const std::function<PassStats()>& calculate);
+
+    void Clear();
+
+private:
+    std::map<Key, PassStats> m_Stats;
+};
+
 EstimatedPass EstimatePassGrownFrom(const OpGraph& opGraph,
                                     Op* op,
                                     const HardwareCapabilities& capabilities,
                                     const EstimationOptions& estimationOpts,
-                                    std::unordered_set<Op*>& unestimatedOps);
+                                    std::unordered_set<Op*>& unestimatedOps,
+                                    PassStatsCache* passStatsCache = nullptr);
 
 struct EstimatedOpGraph
 {
@@ -36,9 +60,12 @@ struct EstimatedOpGraph
     std::unordered_map<Op*, uint32_t> m_OpToPass;
 };
 
+/// Estimates the performance of the given OpGraph.
+/// If a PassStatsCache is given then it is used to avoid re-calculating the stats of passes estimated previously.
 EstimatedOpGraph EstimateOpGraph(const OpGraph& opGraph,
                                  const HardwareCapabilities& capabilities,
-                                 const EstimationOptions& estimationOpts);
+                                 const EstimationOptions& estimationOpts,
+                                 PassStatsCache* passStatsCache = nullptr);
 
 }    // namespace support_library
 }    // namespace ethosn
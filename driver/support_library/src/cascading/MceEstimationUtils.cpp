@@ -187,7 +187,8 @@ uint32_t GetWeightsNumReloads(const HardwareCapabilities& caps,
 }
 
 WeightsStats GetWeightsStats(const HardwareCapabilities& caps,
-                             EncodedWeights& encodedWeights,
+                             const std::vector<WeightsMetadata>& weightsMetadata,
+                             const uint32_t encodedWeightsSize,
                              const TensorInfo& info,
                              const TensorShape& stripeShape,
                              const uint32_t tileSize,
@@ -200,7 +201,7 @@ WeightsStats GetWeightsStats(const HardwareCapabilities& caps,
         utils::EstimateWeightSizeBytes(stripeShape, caps, info.m_DataFormat == DataFormat::HWIM);
 
     // Account for the reloading of the weights data, this happens when streaming input data in depth and height.
-    data.m_StripesStats.m_NumCentralStripes = static_cast<uint32_t>(encodedWeights.m_Metadata.size());
+    data.m_StripesStats.m_NumCentralStripes = static_cast<uint32_t>(weightsMetadata.size());
     data.m_StripesStats.m_NumReloads        = GetWeightsNumReloads(caps, inShape, inStripeShape, info, tileSize);
 
     // Check if there is more than a stripe in the tile.
@@ -210,21 +211,21 @@ WeightsStats GetWeightsStats(const HardwareCapabilities& caps,
     {
         // At least a weights stripe needs to be in internal memory before starting the processing, use the metadata information
         // to get the amount of data.
-        data.m_MemoryStats.m_DramNonParallel = encodedWeights.m_Metadata[0].m_Size;
+        data.m_MemoryStats.m_DramNonParallel = weightsMetadata[0].m_Size;
         data.m_MemoryStats.m_DramParallel =
-            (data.m_StripesStats.m_NumReloads + 1U) * static_cast<uint32_t>(encodedWeights.m_Data.size()) -
+            (data.m_StripesStats.m_NumReloads + 1U) * encodedWeightsSize -
             data.m_MemoryStats.m_DramNonParallel;
     }
     else
     {
         data.m_MemoryStats.m_DramNonParallel =
-            (data.m_StripesStats.m_NumReloads + 1U) * static_cast<uint32_t>(encodedWeights.m_Data.size());
+            (data.m_StripesStats.m_NumReloads + 1U) * encodedWeightsSize;
     }
     // Clamp the savings to 0
     // if the weights are uncompressable then the encoded weight size is larger than the weights provided
     // because of the header
     data.m_WeightCompressionSavings =
-        std::max(0.0f, 1.0f - (static_cast<float>(encodedWeights.m_Data.size()) /
+        std::max(0.0f, 1.0f - (static_cast<float>(encodedWeightsSize) /
                                static_cast<float>(utils::GetNumElements(info.m_Dimensions))));
 
     return data;
@@ -24,7 +24,8 @@ MceStats GetMceStats(const HardwareCapabilities& caps,
                      const TensorShape& weightsShape);
 
 WeightsStats GetWeightsStats(const HardwareCapabilities& caps,
-                             EncodedWeights& encodedWeights,
+                             const std::vector<WeightsMetadata>& weightsMetadata,
+                             const uint32_t encodedWeightsSize,
                              const TensorInfo& info,
                              const TensorShape& stripeShape,
                              const uint32_t tileSize,
@@ -118,8 +118,8 @@ CascadingBufferFormat GetCascadingBufferFormatFromCompilerDataFormat(const Compi
 class WeightEncoderCache
 {
 public:
-    WeightEncoderCache(const HardwareCapabilities& caps)
-        : m_Encoder(WeightEncoder::CreateWeightEncoder(caps))
+    WeightEncoderCache(const HardwareCapabilities& caps, const WeightEncoderOptions& options)
+        : m_Encoder(WeightEncoder::CreateWeightEncoder(caps, options))
     {}
 
     struct Params
@@ -151,16 +151,16 @@ public:
         }
     };
 
-    EncodedWeights Encode(const Params& params)
+    EncodedWeightsSize CalculateEncodedSize(const Params& params)
     {
         auto it = m_Entries.find(params);
         if (it == m_Entries.end())
         {
-            EncodedWeights w =
-                m_Encoder->Encode(params.weightsTensorInfo, params.weightsData.data(), params.biasTensorInfo,
-                                  params.biasData.data(), params.inputQuantizationInfo, params.outputQuantizationInfo,
-                                  params.stripeDepth, params.strideY, params.strideX, params.paddingTop,
-                                  params.paddingLeft, params.iterationSize, params.operation, params.algorithm);
+            EncodedWeightsSize w = m_Encoder->CalculateEncodedSize(
+                params.weightsTensorInfo, params.weightsData.data(), params.biasTensorInfo, params.biasData.data(),
+                params.inputQuantizationInfo, params.outputQuantizationInfo, params.stripeDepth, params.strideY,
+                params.strideX, params.paddingTop, params.paddingLeft, params.iterationSize, params.operation,
+                params.algorithm);
             m_Entries[params] = w;
             return w;
         }
@@ -192,7 +192,7 @@ private:
     };
 
     std::unique_ptr<WeightEncoder> m_Encoder;
-    std::unordered_map<Params, EncodedWeights, Hasher> m_Entries;
+    std::unordered_map<Params, EncodedWeightsSize, Hasher> m_Entries;
 };
 
 bool Part::NumStripes::operator<(const NumStripes& rhs) const
@@ -578,7 +578,7 @@ void Part::CreatePlans()
     }
     else
     {
-        WeightEncoderCache weightEncoderCache(m_Capabilities);
+        WeightEncoderCache weightEncoderCache(m_Capabilities, m_WeightEncoderOptions);
         GenerateWithTraversalOrders(node, weightEncoderCache);
     }
 
@@ -689,7 +689,7 @@ void AddWeightBuffersAndDmaOpToMceOp(OwnedOpGraph& opGraph,
     opGraph.SetProducer(weightsBufferInSram, dmaOp);
     opGraph.AddConsumer(weightsBufferInSram, op, 1);
 
-    // Encode weights
+    // Calculate the size of the encoded weights
     const uint32_t weightStripeSize  = mceOp->m_WeightsStripeShape[2];
     const uint32_t weightStripeDepth = GetWeightStripeDepth(weightInfo, mceOp);
 
@@ -697,25 +697,27 @@ void AddWeightBuffersAndDmaOpToMceOp(OwnedOpGraph& opGraph,
     Buffer* mceInput  = opGraph.GetInputs(mceOp)[0];
 
     WeightEncoderCache::Params wp;
-    wp.weightsTensorInfo                  = weightInfo;
-    wp.weightsData                        = weightData;
-    wp.biasTensorInfo                     = biasInfo;
-    wp.biasData                           = biasData;
-    wp.inputQuantizationInfo              = mceInput->m_QuantizationInfo;
-    wp.outputQuantizationInfo             = mceOutput->m_QuantizationInfo;
-    wp.stripeDepth                        = weightStripeDepth;
-    wp.strideY                            = mceOp->m_Stride.m_Y;
-    wp.strideX                            = mceOp->m_Stride.m_X;
-    wp.paddingTop                         = mceOp->m_PadTop;
-    wp.paddingLeft                        = mceOp->m_PadLeft;
-    wp.iterationSize                      = weightStripeSize;
-    wp.operation                          = mceOp->m_Op;
-    wp.algorithm                          = mceOp->m_Algo;
-    weightsBufferInDram->m_EncodedWeights = std::make_unique<EncodedWeights>(weightEncoderCache.Encode(wp));
-
-    // Use the encoded weights to determine the size of the sram and dram buffers
-    weightsBufferInDram->m_SizeInBytes = static_cast<uint32_t>(weightsBufferInDram->m_EncodedWeights->m_Data.size());
-    weightsBufferInSram->m_SizeInBytes = weightsBufferInDram->m_EncodedWeights->m_MaxSize * numWeightStripes;
+    wp.weightsTensorInfo      = weightInfo;
+    wp.weightsData            = weightData;
+    wp.biasTensorInfo         = biasInfo;
+    wp.biasData               = biasData;
+    wp.inputQuantizationInfo  = mceInput->m_QuantizationInfo;
+    wp.outputQuantizationInfo = mceOutput->m_QuantizationInfo;
+    wp.stripeDepth            = weightStripeDepth;
+    wp.strideY                = mceOp->m_Stride.m_Y;
+    wp.strideX                = mceOp->m_Stride.m_X;
+    wp.paddingTop             = mceOp->m_PadTop;
+    wp.paddingLeft            = mceOp->m_PadLeft;
+    wp.iterationSize          = weightStripeSize;
+    wp.operation              = mceOp->m_Op;
+    wp.algorithm              = mceOp->m_Algo;
+
+    weightsBufferInDram->m_EncodedWeightsSize =
+        std::make_unique<EncodedWeightsSize>(weightEncoderCache.CalculateEncodedSize(wp));
+
+    // Use the size of the encoded weights to determine the size of the sram and dram buffers
+    weightsBufferInDram->m_SizeInBytes = weightsBufferInDram->m_EncodedWeightsSize->m_Size;
+    weightsBufferInSram->m_SizeInBytes = weightsBufferInDram->m_EncodedWeightsSize->m_MaxSize * numWeightStripes;
 }
 
 Buffer* Part::AddIdentityMceOpForSubGraph(OwnedOpGraph& opGraph,
@@ -35,6 +35,7 @@ using Plans          = std::vector<std::unique_ptr<Plan>>;
 using StripeSizeType = TensorShape::value_type;
 
 class WeightEncoderCache;
+struct WeightEncoderOptions;
 
 class Part : public DebuggableObject
 {
@@ -64,11 +65,15 @@ public:
         bool operator<(const StripeInfos& rhs) const;
     };
 
-    Part(const EstimationOptions& estOpt, const CompilationOptions& compOpt, const HardwareCapabilities& capabilities)
+    Part(const EstimationOptions& estOpt,
+         const CompilationOptions& compOpt,
+         const HardwareCapabilities& capabilities,
+         const WeightEncoderOptions& weightEncoderOptions)
         : DebuggableObject("Part")
         , m_EstimationOptions(estOpt)
         , m_CompilationOptions(compOpt)
         , m_Capabilities(capabilities)
+        , m_WeightEncoderOptions(weightEncoderOptions)
     {}
 
     void CreatePlans();
@@ -161,6 +166,7 @@ private:
     const EstimationOptions& m_EstimationOptions;
     const CompilationOptions& m_CompilationOptions;
     const HardwareCapabilities& m_Capabilities;
+    const WeightEncoderOptions& m_WeightEncoderOptions;
 };
 
 using Parts = std::vector<std::unique_ptr<Part>>;
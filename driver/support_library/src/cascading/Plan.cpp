@@ -200,16 +200,15 @@ Buffer* OwnedOpGraph::AddBuffer(std::unique_ptr<Buffer> buffer)
     return raw;
 }
 
-int DebuggableObject::ms_IdCounter = 0;
+std::atomic<int> DebuggableObject::ms_IdCounter(0);
 
 DebuggableObject::DebuggableObject(const char* defaultTagPrefix)
 {
     // Generate an arbitrary and unique (but deterministic) default debug tag for this object.
     // This means that if no-one sets anything more useful, we still have a way to identify it.
-    m_DebugTag = std::string(defaultTagPrefix) + " " + std::to_string(ms_IdCounter);
     //m_DebugId is very useful for conditional breakpoints
-    m_DebugId = ms_IdCounter;
-    ++ms_IdCounter;
+    m_DebugId  = ms_IdCounter++;
+    m_DebugTag = std::string(defaultTagPrefix) + " " + std::to_string(m_DebugId);
 }
 
 Op::Op(const char* defaultTagPrefix)
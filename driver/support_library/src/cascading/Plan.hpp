@@ -11,6 +11,7 @@
 
 #include <ethosn_command_stream/CommandStream.hpp>
 
+#include <atomic>
 #include <map>
 #include <unordered_map>
 
@@ -160,7 +161,9 @@ public:
 
     /// Counter for generating unique debug tags (see DebuggableObject constructor).
     /// This is publicly exposed so can be manipulated by tests.
-    static int ms_IdCounter;
+    /// It is atomic as objects may be created on multiple threads (see CreateMetadata), in which case the tags
+    /// are still unique but their order depends on the order in which the objects were created.
+    static std::atomic<int> ms_IdCounter;
 };
 
 class Plan : public DebuggableObject
@@ -289,8 +292,9 @@ public:
     /// but is useful to store by itself nonetheless.
     uint32_t m_NumStripes;
 
-    /// Relevant only if this is a weights buffer in Dram.
-    std::unique_ptr<EncodedWeights> m_EncodedWeights;
+    /// Relevant only if this is a weights buffer in Dram. Only the size and layout of the encoded weights are needed
+    /// to estimate a Plan, so the encoded data itself is not produced.
+    std::unique_ptr<EncodedWeightsSize> m_EncodedWeightsSize;
 };
 
 bool IsOutputBufferInDram(const Plan& plan, const Edge& edge);
@@ -509,6 +509,7 @@ std::unique_ptr<ethosn::support_library::McePlePass>
                                std::vector<command_stream::BlockConfig> allowedBlockConfigs,
                                bool enableIntermediateCompression,
                                bool enableWinograd,
+                               const WeightEncoderOptions& weightEncoderOptions,
                                Node* firstNode,
                                SramAllocator& sramAllocator,
                                bool forwardEst)
@@ -624,7 +625,7 @@ std::unique_ptr<ethosn::support_library::McePlePass>
 
     std::unique_ptr<ethosn::support_library::McePlePass> result = std::make_unique<McePlePass>(
         capabilities, id, linearNodes.m_WorkingNodes, linearNodes.m_TensorConfig, linearNodes.m_OutputLocation,
-        intermediateOutputCompressedFormat, linearNodes.m_Algorithm, sramOffset);
+        intermediateOutputCompressedFormat, linearNodes.m_Algorithm, sramOffset, weightEncoderOptions);
 
     return result;
 }
@@ -636,12 +637,13 @@ McePlePass::McePlePass(const HardwareCapabilities& capabilities,
                        BufferLocation outputLocation,
                        CompilerDataCompressedFormat intermediateCompressedFormat,
                        CompilerMceAlgorithm algorithm,
-                       uint32_t sramOffset)
+                       uint32_t sramOffset,
+                       const WeightEncoderOptions& weightEncoderOptions)
     : Pass(capabilities, id)
     , m_ExtractSubtensorNode(nullptr)
     , m_MceOperation(nullptr)
     , m_PleOperation(nullptr)
-    , m_WeightEncoder(WeightEncoder::CreateWeightEncoder(capabilities))
+    , m_WeightEncoder(WeightEncoder::CreateWeightEncoder(capabilities, weightEncoderOptions))
     , m_TensorConfig(tensorConfig)
 {
     m_Nodes = nodes;
@@ -1141,15 +1143,16 @@ PassStats McePlePass::GetStats(const EstimationOptions& estimationOptions)
                                                    ? m_MceOperation->GetQuantizationInfo()
                                                    : m_RequantizeNodes.back()->GetQuantizationInfo();
 
-    // Encode weights to know the actual amount of data including headers.
+    // Calculate the size of the encoded weights to know the actual amount of data including headers.
+    // The encoded data itself is not needed so the (much cheaper) size-only encoding is used.
     uint32_t weightStripeSize;
     uint32_t weightStripeDepth;
     std::tie(weightStripeSize, weightStripeDepth) = GetWeightStripeSizeAndDepth();
-    EncodedWeights encodedWeights =
-        m_WeightEncoder->Encode(*m_MceOperation, weightStripeDepth, weightStripeSize, quantizationInfo);
+    EncodedWeightsSize encodedWeightsSize =
+        m_WeightEncoder->CalculateEncodedSize(*m_MceOperation, weightStripeDepth, weightStripeSize, quantizationInfo);
 
-    perfData.m_Weights = GetWeightsStats(m_Capabilities, encodedWeights, weightsInfo, weightsStripeShape,
-                                         weightsTileSize, inputShape, inputStripeShape);
+    perfData.m_Weights = GetWeightsStats(m_Capabilities, encodedWeightsSize.m_Metadata, encodedWeightsSize.m_Size,
+                                         weightsInfo, weightsStripeShape, weightsTileSize, inputShape, inputStripeShape);
 
     perfData.m_Mce = GetMceStats(m_Capabilities, m_MceOperation->GetStride(), m_MceOperation->GetOperation(),
                                  m_MceOperation->GetAlgorithm(), inputShape, mceOutputShape, weightsInfo.m_Dimensions);
@@ -49,6 +49,7 @@ public:
                                                       std::vector<command_stream::BlockConfig> allowedBlockConfigs,
                                                       bool enableIntermediateCompression,
                                                       bool enableWinograd,
+                                                      const WeightEncoderOptions& weightEncoderOptions,
                                                       Node* firstNode,
                                                       SramAllocator& sramAllocator,
                                                       bool forwardEst);
@@ -60,7 +61,8 @@ public:
                BufferLocation outputLocation,
                CompilerDataCompressedFormat intermediateCompressedFormat,
                CompilerMceAlgorithm algorithm,
-               uint32_t sramOffset);
+               uint32_t sramOffset,
+               const WeightEncoderOptions& weightEncoderOptions = {});
 
     /// Generates this Pass by adding appropriate entries to the given command stream, memory map and buffer table.
     void Generate(command_stream::CommandStreamBuffer& cmdStream, BufferManager& bufferManager, bool dumpRam) override;
@@ -5,8 +5,18 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <utility>
+#include <vector>
+
 #if defined(__unix__)
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
 #elif defined(_MSC_VER)
 #define NOMINMAX
 #define WIN32_LEAN_AND_MEAN
@@ -29,5 +39,153 @@ inline bool MakeDirectory(const char* dir)
 #endif
 }
 
+/// Read-only view of the contents of a file.
+/// Where supported the file is memory-mapped, otherwise its contents are read into memory.
+class MappedFile
+{
+public:
+    MappedFile()
+        : m_Data(nullptr)
+        , m_Size(0)
+        , m_IsValid(false)
+        , m_IsMapped(false)
+        , m_MapBase(nullptr)
+        , m_MapSize(0)
+    {}
+
+    /// Opens the whole of the given file. Use IsValid() to check whether this was successful.
+    explicit MappedFile(const char* path)
+        : MappedFile()
+    {
+#if defined(__unix__)
+        int fd = open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            return;
+        }
+        MapFd(fd);
+        close(fd);
+#else
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream.good())
+        {
+            return;
+        }
+        m_Buffer.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        m_Data    = m_Buffer.data();
+        m_Size    = m_Buffer.size();
+        m_IsValid = true;
+#endif
+    }
+
+#if defined(__unix__)
+    /// Maps the file referred to by the given file descriptor, from the descriptor's current offset to the end of
+    /// the file. The descriptor's offset is not changed and the descriptor is not closed, so it may be closed by the
+    /// caller once this has returned.
+    explicit MappedFile(int fd)
+        : MappedFile()
+    {
+        MapFd(fd);
+    }
+#endif
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other)
+        : MappedFile()
+    {
+        Swap(other);
+    }
+
+    MappedFile& operator=(MappedFile&& other)
+    {
+        MappedFile tmp(std::move(other));
+        Swap(tmp);
+        return *this;
+    }
+
+    ~MappedFile()
+    {
+#if defined(__unix__)
+        if (m_IsMapped)
+        {
+            munmap(m_MapBase, m_MapSize);
+        }
+#endif
+    }
+
+    bool IsValid() const
+    {
+        return m_IsValid;
+    }
+
+    const uint8_t* GetData() const
+    {
+        return m_Data;
+    }
+
+    size_t GetSize() const
+    {
+        return m_Size;
+    }
+
+private:
+#if defined(__unix__)
+    void MapFd(int fd)
+    {
+        struct stat fileStat;
+        if (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode))
+        {
+            return;
+        }
+        const off_t pos = lseek(fd, 0, SEEK_CUR);
+        if (pos < 0 || pos > fileStat.st_size)
+        {
+            return;
+        }
+        if (pos < fileStat.st_size)
+        {
+            // mmap() needs a page-aligned offset, so map from the start of the page containing the current offset
+            const off_t pageSize  = static_cast<off_t>(sysconf(_SC_PAGESIZE));
+            const off_t mapOffset = pos - pos % pageSize;
+            const size_t mapSize  = static_cast<size_t>(fileStat.st_size - mapOffset);
+            void* data            = mmap(nullptr, mapSize, PROT_READ, MAP_PRIVATE, fd, mapOffset);
+            if (data == MAP_FAILED)
+            {
+                return;
+            }
+            m_MapBase  = data;
+            m_MapSize  = mapSize;
+            m_Data     = static_cast<const uint8_t*>(data) + (pos - mapOffset);
+            m_Size     = static_cast<size_t>(fileStat.st_size - pos);
+            m_IsMapped = true;
+        }
+        m_IsValid = true;
+    }
+#endif
+
+    void Swap(MappedFile& other)
+    {
+        std::swap(m_Data, other.m_Data);
+        std::swap(m_Size, other.m_Size);
+        std::swap(m_IsValid, other.m_IsValid);
+        std::swap(m_IsMapped, other.m_IsMapped);
+        std::swap(m_MapBase, other.m_MapBase);
+        std::swap(m_MapSize, other.m_MapSize);
+        // The data pointer of an unmapped file points into the buffer, which is not invalidated by a swap
+        std::swap(m_Buffer, other.m_Buffer);
+    }
+
+    const uint8_t* m_Data;
+    size_t m_Size;
+    bool m_IsValid;
+    bool m_IsMapped;
+    /// The whole mapping, which may start before m_Data as mappings must start on a page boundary.
+    void* m_MapBase;
+    size_t m_MapSize;
+    std::vector<uint8_t> m_Buffer;
+};
+
 }    // namespace utils
 }    // namespace ethosn
@@ -27,10 +27,15 @@
 
 #include <linux/anon_inodes.h>
 #include <linux/device.h>
+#include <linux/dma-buf.h>
+#include <linux/dma-mapping.h>
 #include <linux/file.h>
 #include <linux/fs.h>
+#include <linux/mm.h>
+#include <linux/scatterlist.h>
 #include <linux/slab.h>
 #include <linux/types.h>
+#include <linux/version.h>
 
 #if (MB_RDONLY != O_RDONLY) ||	   \
 	(MB_WRONLY != O_WRONLY) || \
@@ -38,6 +43,11 @@
 #error "MB_ flags are not correctly defined"
 #endif
 
+/* pin_user_pages() is for memory whose contents are accessed by DMA. */
+#if (KERNEL_VERSION(5, 6, 0) <= LINUX_VERSION_CODE)
+#define ETHOSN_HAVE_PIN_USER_PAGES
+#endif
+
 static int ethosn_buffer_release(struct inode *inode,
 				 struct file *file);
 static int ethosn_buffer_mmap(struct file *file,
@@ -74,8 +84,8 @@ static bool is_ethosn_dma_view_file(const struct file *const file)
 	return file->f_op == &ethosn_dma_view_fops;
 }
 
-static void buffer_unmap_and_free_dma(struct ethosn_buffer *buf,
-				      int num_cores)
+static void buffer_unmap_dma(struct ethosn_buffer *buf,
+			     int num_cores)
 {
 	struct ethosn_device *ethosn = buf->ethosn;
 	int i;
@@ -86,8 +96,54 @@ static void buffer_unmap_and_free_dma(struct ethosn_buffer *buf,
 			ethosn->core[i]->allocator,
 			buf->dma_info,
 			ETHOSN_STREAM_DMA);
+}
 
-	ethosn_dma_free(ethosn->allocator, buf->dma_info);
+static void buffer_unmap_and_free_dma(struct ethosn_buffer *buf,
+				      int num_cores)
+{
+	buffer_unmap_dma(buf, num_cores);
+	ethosn_dma_free(buf->ethosn->allocator, buf->dma_info);
+}
+
+static void unpin_pages_dirty(struct page **pages,
+			      int nr_pages)
+{
+#ifdef ETHOSN_HAVE_PIN_USER_PAGES
+	unpin_user_pages_dirty_lock(pages, nr_pages, true);
+#else
+	int i;
+
+	for (i = 0; i < nr_pages; ++i) {
+		set_page_dirty_lock(pages[i]);
+		put_page(pages[i]);
+	}
+
+#endif
+}
+
+/**
+ * buffer_release_import() - Release the memory wrapped by an imported buffer
+ * @import: [in]	Imported memory, which may be partially acquired
+ */
+static void buffer_release_import(struct ethosn_buffer_import *import)
+{
+	/* The NPU may have written to any of the pages */
+	if (import->nr_pinned_pages > 0)
+		unpin_pages_dirty(import->pages, import->nr_pinned_pages);
+
+	kfree(import->pages);
+
+	if (import->sgt)
+		dma_buf_unmap_attachment(import->attachment, import->sgt,
+					 DMA_BIDIRECTIONAL);
+
+	if (import->attachment)
+		dma_buf_detach(import->dmabuf, import->attachment);
+
+	if (import->dmabuf)
+		dma_buf_put(import->dmabuf);
+
+	kfree(import);
 }
 
 static int ethosn_buffer_release(struct inode *const inode,
@@ -108,6 +164,9 @@ static int ethosn_buffer_release(struct inode *const inode,
 
 	buffer_unmap_and_free_dma(buf, ethosn->num_cores);
 
+	if (buf->import)
+		buffer_release_import(buf->import);
+
 	put_device(buf->ethosn->dev);
 
 	kfree(buf);
@@ -130,6 +189,10 @@ static int ethosn_buffer_mmap(struct file *const file,
 	buf = file->private_data;
 	allocator = buf->ethosn->allocator;
 
+	/* The exporter maps its memory for the CPU */
+	if (buf->import && buf->import->dmabuf)
+		return dma_buf_mmap(buf->import->dmabuf, vma, 0);
+
 	return ethosn_dma_mmap(allocator, vma, buf->dma_info);
 }
 
@@ -161,6 +224,59 @@ static loff_t ethosn_buffer_llseek(struct file *const file,
 		return -EINVAL;
 }
 
+/**
+ * buffer_map_and_get_fd() - Map a buffer for every core and create its file
+ * @buf: [in]	Buffer, whose memory has been allocated or imported
+ * @flags: [in]	MB_ flags of the buffer
+ *
+ * Return:
+ * * File descriptor for the buffer on success
+ * * Negative error code on failure, in which case the buffer is left unmapped
+ */
+static int buffer_map_and_get_fd(struct ethosn_buffer *buf,
+				 u32 flags)
+{
+	struct ethosn_device *ethosn = buf->ethosn;
+	int fd;
+	int ret;
+	int i;
+
+	/* Map iova per core through core allocator */
+	for (i = 0; i < ethosn->num_cores; ++i) {
+		ret = ethosn_dma_map(
+			ethosn->core[i]->allocator,
+			buf->dma_info,
+			ETHOSN_PROT_READ | ETHOSN_PROT_WRITE,
+			ETHOSN_STREAM_DMA);
+
+		if (ret < 0)
+			goto err_unmap;
+	}
+
+	fd = anon_inode_getfd("ethosn-buffer",
+			      &ethosn_buffer_fops,
+			      buf,
+			      (flags & O_ACCMODE) | O_CLOEXEC);
+	if (fd < 0) {
+		ret = fd;
+		goto err_unmap;
+	}
+
+	buf->file = fget(fd);
+	buf->file->f_mode |= FMODE_LSEEK;
+
+	fput(buf->file);
+
+	get_device(ethosn->dev);
+
+	return fd;
+
+err_unmap:
+	buffer_unmap_dma(buf, i);
+
+	return ret;
+}
+
 /**
  * ethosn_buffer_register() - Register a new Ethos-N buffer
  * @ethosn: [in]     pointer to Ethos-N device
@@ -177,7 +293,6 @@ int ethosn_buffer_register(struct ethosn_device *ethosn,
 	struct ethosn_log_uapi_buffer_req log;
 	int fd;
 	int ret = -ENOMEM;
-	int i;
 
 	buf = kzalloc(sizeof(*buf), GFP_KERNEL);
 	if (!buf)
@@ -200,34 +315,12 @@ int ethosn_buffer_register(struct ethosn_device *ethosn,
 	if (IS_ERR_OR_NULL(buf->dma_info))
 		goto err_kfree;
 
-	/* Map iova per core through core allocator */
-	for (i = 0; i < ethosn->num_cores; ++i) {
-		int ret = ethosn_dma_map(
-			ethosn->core[i]->allocator,
-			buf->dma_info,
-			ETHOSN_PROT_READ | ETHOSN_PROT_WRITE,
-			ETHOSN_STREAM_DMA);
-
-		if (ret < 0)
-			goto err_dma_free;
-	}
-
-	ret = anon_inode_getfd("ethosn-buffer",
-			       &ethosn_buffer_fops,
-			       buf,
-			       (buf_req->flags & O_ACCMODE) | O_CLOEXEC);
+	ret = buffer_map_and_get_fd(buf, buf_req->flags);
 	if (ret < 0)
 		goto err_dma_free;
 
 	fd = ret;
 
-	buf->file = fget(fd);
-	buf->file->f_mode |= FMODE_LSEEK;
-
-	fput(buf->file);
-
-	get_device(ethosn->dev);
-
 	if (buf_req->flags & MB_ZERO) {
 		memset(buf->dma_info->cpu_addr, 0, buf->dma_info->size);
 		dev_dbg(ethosn->dev, "Zeroed ethosn buffer 0x%pK\n", buf);
@@ -245,13 +338,211 @@ int ethosn_buffer_register(struct ethosn_device *ethosn,
 	return fd;
 
 err_dma_free:
-	buffer_unmap_and_free_dma(buf, i);
+	ethosn_dma_free(ethosn->allocator, buf->dma_info);
+err_kfree:
+	kfree(buf);
+
+	return ret;
+}
+
+static int import_user_pages(struct ethosn_buffer_import *import,
+			     u64 addr)
+{
+	int ret;
+
+	if (!PAGE_ALIGNED(addr))
+		return -EINVAL;
+
+	import->pages = kcalloc(import->nr_pages, sizeof(*import->pages),
+				GFP_KERNEL);
+	if (!import->pages)
+		return -ENOMEM;
+
+	/* The NPU may write to the pages, whatever the access mode of the
+	 * buffer in user space is. They stay pinned for as long as the buffer
+	 * exists, so must not be in a movable zone or CMA.
+	 */
+#if defined(ETHOSN_HAVE_PIN_USER_PAGES)
+	ret = pin_user_pages_fast((unsigned long)addr, import->nr_pages,
+				  FOLL_WRITE | FOLL_LONGTERM,
+				  import->pages);
+#elif (KERNEL_VERSION(5, 2, 0) > LINUX_VERSION_CODE)
+	ret = get_user_pages_fast((unsigned long)addr, import->nr_pages, 1,
+				  import->pages);
+#else
+	ret = get_user_pages_fast((unsigned long)addr, import->nr_pages,
+				  FOLL_WRITE | FOLL_LONGTERM,
+				  import->pages);
+#endif
+	if (ret < 0)
+		return ret;
+
+	import->nr_pinned_pages = ret;
+
+	if (import->nr_pinned_pages != import->nr_pages)
+		return -EFAULT;
+
+	return 0;
+}
+
+static int import_dma_buf(struct ethosn_device *ethosn,
+			  struct ethosn_buffer_import *import,
+			  int dmabuf_fd)
+{
+	int ret;
+
+	import->dmabuf = dma_buf_get(dmabuf_fd);
+	if (IS_ERR(import->dmabuf)) {
+		ret = PTR_ERR(import->dmabuf);
+		import->dmabuf = NULL;
+
+		return ret;
+	}
+
+	if (import->dmabuf->size < (size_t)import->nr_pages * PAGE_SIZE)
+		return -EINVAL;
+
+	import->attachment = dma_buf_attach(import->dmabuf, ethosn->dev);
+	if (IS_ERR(import->attachment)) {
+		ret = PTR_ERR(import->attachment);
+		import->attachment = NULL;
+
+		return ret;
+	}
+
+	import->sgt = dma_buf_map_attachment(import->attachment,
+					     DMA_BIDIRECTIONAL);
+	if (IS_ERR(import->sgt)) {
+		ret = PTR_ERR(import->sgt);
+		import->sgt = NULL;
+
+		return ret;
+	}
+
+	return 0;
+}
+
+/**
+ * ethosn_buffer_import() - Register an Ethos-N buffer wrapping existing memory
+ * @ethosn: [in]	pointer to Ethos-N device
+ * @import_req: [in]	memory to import and buffer flags
+ *
+ * Return:
+ * * File descriptor for the new Ethos-N buffer on success
+ * * Negative error code on failure
+ */
+int ethosn_buffer_import(struct ethosn_device *ethosn,
+			 struct ethosn_buffer_import_req *import_req)
+{
+	struct ethosn_buffer *buf;
+	struct ethosn_buffer_import *import;
+	int ret = -ENOMEM;
+
+	if (!import_req->size || !PAGE_ALIGNED(import_req->size) ||
+	    (import_req->flags & MB_ZERO))
+		return -EINVAL;
+
+	buf = kzalloc(sizeof(*buf), GFP_KERNEL);
+	if (!buf)
+		return -ENOMEM;
+
+	import = kzalloc(sizeof(*import), GFP_KERNEL);
+	if (!import)
+		goto err_kfree;
+
+	dev_dbg(ethosn->dev,
+		"Import buffer. handle=0x%pK, type=%u, size=%u\n",
+		buf, import_req->type, import_req->size);
+
+	buf->ethosn = ethosn;
+	buf->import = import;
+
+	import->nr_pages = import_req->size >> PAGE_SHIFT;
+
+	/* A dma-buf is imported through the sg table of its attachment, which
+	 * stays mapped until the buffer is released, and user memory through
+	 * its pinned pages.
+	 */
+	switch (import_req->type) {
+	case ETHOSN_BUFFER_IMPORT_DMA_BUF:
+		ret = import_dma_buf(ethosn, import, (int)import_req->handle);
+		if (!ret)
+			buf->dma_info = ethosn_dma_import_sgt(
+				ethosn->allocator, import->sgt,
+				import_req->size);
+
+		break;
+	case ETHOSN_BUFFER_IMPORT_USER_PTR:
+		ret = import_user_pages(import, import_req->handle);
+		if (!ret)
+			buf->dma_info = ethosn_dma_import(ethosn->allocator,
+							  import->pages,
+							  import->nr_pages);
+
+		break;
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	if (ret)
+		goto err_release_import;
+
+	if (IS_ERR(buf->dma_info)) {
+		ret = PTR_ERR(buf->dma_info);
+		goto err_release_import;
+	}
+
+	ret = buffer_map_and_get_fd(buf, import_req->flags);
+	if (ret < 0)
+		goto err_dma_free;
+
+	return ret;
+
+err_dma_free:
+	ethosn_dma_free(ethosn->allocator, buf->dma_info);
+err_release_import:
+	buffer_release_import(import);
 err_kfree:
 	kfree(buf);
 
 	return ret;
 }
 
+/**
+ * ethosn_buffer_sync_for_device() - Transfer ownership of a buffer to the
+ * Ethos-N
+ * @buf: [in]	Ethos-N buffer
+ */
+void ethosn_buffer_sync_for_device(struct ethosn_buffer *buf)
+{
+	/* Imported dma-bufs are synced through the attachment they are mapped
+	 * with. begin/end_cpu_access are left to the CPU users of the dma-buf.
+	 */
+	if (buf->import && buf->import->sgt)
+		dma_sync_sg_for_device(buf->ethosn->dev,
+				       buf->import->sgt->sgl,
+				       buf->import->sgt->orig_nents,
+				       DMA_BIDIRECTIONAL);
+	else
+		ethosn_dma_sync_for_device(buf->ethosn->allocator,
+					   buf->dma_info);
+}
+
+/**
+ * ethosn_buffer_sync_for_cpu() - Transfer ownership of a buffer to the CPU
+ * @buf: [in]	Ethos-N buffer
+ */
+void ethosn_buffer_sync_for_cpu(struct ethosn_buffer *buf)
+{
+	if (buf->import && buf->import->sgt)
+		dma_sync_sg_for_cpu(buf->ethosn->dev, buf->import->sgt->sgl,
+				    buf->import->sgt->orig_nents,
+				    DMA_BIDIRECTIONAL);
+	else
+		ethosn_dma_sync_for_cpu(buf->ethosn->allocator, buf->dma_info);
+}
+
 /**
  * ethosn_buffer_get() - Returns the ethosn_buffer structure related to an fd
  * @fd: [in]    fd associated with the ethosn_buffer to be returned
@@ -29,16 +29,47 @@
 
 #include <linux/types.h>
 
+struct dma_buf;
+struct dma_buf_attachment;
+struct page;
+struct sg_table;
+
+/**
+ * struct ethosn_buffer_import - Memory wrapped by an imported buffer
+ * @pages:		The pinned user pages, in order, for
+ *			ETHOSN_BUFFER_IMPORT_USER_PTR
+ * @nr_pages:		Number of pages
+ * @nr_pinned_pages:	Number of user pages pinned
+ * @dmabuf:		The dma-buf, for ETHOSN_BUFFER_IMPORT_DMA_BUF
+ * @attachment:		Attachment of the device to the dma-buf
+ * @sgt:		Scatter list of the mapped attachment, which the
+ *			Ethos-N accesses the memory through
+ */
+struct ethosn_buffer_import {
+	struct page               **pages;
+	int                       nr_pages;
+	int                       nr_pinned_pages;
+	struct dma_buf            *dmabuf;
+	struct dma_buf_attachment *attachment;
+	struct sg_table           *sgt;
+};
+
 struct ethosn_buffer {
-	struct ethosn_device   *ethosn;
-	struct ethosn_dma_info *dma_info;
+	struct ethosn_device        *ethosn;
+	struct ethosn_dma_info      *dma_info;
 	/* file pointer used for user-space mmap and for ref-counting */
-	struct file            *file;
+	struct file                 *file;
+	/* Set if the buffer wraps imported memory rather than owning it */
+	struct ethosn_buffer_import *import;
 };
 
 int ethosn_buffer_register(struct ethosn_device *ethosn,
 			   struct ethosn_buffer_req *buf_req);
+int ethosn_buffer_import(struct ethosn_device *ethosn,
+			 struct ethosn_buffer_import_req *import_req);
 struct ethosn_buffer *ethosn_buffer_get(int fd);
+void ethosn_buffer_sync_for_device(struct ethosn_buffer *buf);
+void ethosn_buffer_sync_for_cpu(struct ethosn_buffer *buf);
 void put_ethosn_buffer(struct ethosn_buffer *buf);
 
 int ethosn_get_dma_view_fd(struct ethosn_device *ethosn,
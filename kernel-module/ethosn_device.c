@@ -1349,6 +1349,37 @@ static ssize_t mailbox_fops_read(struct file *file,
 	return simple_read_from_buffer(buf_user, count, position, buf, n);
 }
 
+/**
+ * scheduler_fops_read - Inference scheduler read file operation.
+ * @file:		File handle.
+ * @buf_user:		User space buffer.
+ * @count:		Size of user space buffer.
+ * @position:		Current file position.
+ *
+ * Return: Number of bytes read, else error code.
+ */
+static ssize_t scheduler_fops_read(struct file *file,
+				   char __user *buf_user,
+				   size_t count,
+				   loff_t *position)
+{
+	struct ethosn_device *ethosn = file->f_inode->i_private;
+	struct ethosn_inference_queue *queue = &ethosn->queue;
+	char buf[ETHOSN_SCHED_STATS_MAX_SIZE];
+	size_t n;
+	int ret;
+
+	ret = mutex_lock_interruptible(&queue->inference_queue_mutex);
+	if (ret)
+		return ret;
+
+	n = ethosn_sched_print_stats(&queue->sched, buf, sizeof(buf));
+
+	mutex_unlock(&queue->inference_queue_mutex);
+
+	return simple_read_from_buffer(buf_user, count, position, buf, n);
+}
+
 /**
  * firmware_profiling_read - Called when a userspace process reads the
  *			     firmware_profiling debugfs entry,
@@ -1542,6 +1573,33 @@ static void dfs_init(struct ethosn_core *core)
 			    &firmware_profiling_fops);
 }
 
+void ethosn_device_debugfs_init(struct ethosn_device *ethosn,
+				int id)
+{
+	static const struct file_operations scheduler_fops = {
+		.owner = THIS_MODULE,
+		.read  = &scheduler_fops_read
+	};
+	char name[24];
+
+	snprintf(name, sizeof(name), "ethosn_device%d", id);
+	ethosn->debug_dir = debugfs_create_dir(name, NULL);
+	if (IS_ERR_OR_NULL(ethosn->debug_dir))
+		return;
+
+	/* Inference scheduler statistics. The inference queue is shared by
+	 * all the cores, so it is reported here rather than for each core.
+	 */
+	debugfs_create_file("scheduler", 0400, ethosn->debug_dir, ethosn,
+			    &scheduler_fops);
+}
+
+void ethosn_device_debugfs_deinit(struct ethosn_device *ethosn)
+{
+	debugfs_remove_recursive(ethosn->debug_dir);
+	ethosn->debug_dir = NULL;
+}
+
 /****************************************************************************
  * Device setup
  ****************************************************************************/
@@ -27,6 +27,7 @@
 #include "scylla_regs_public.h"
 #include "ethosn_dma.h"
 #include "ethosn_firmware.h"
+#include "ethosn_sched.h"
 #include "uapi/ethosn.h"
 
 #include <linux/atomic.h>
@@ -39,6 +40,9 @@
 #include <linux/timer.h>
 #include <linux/wait.h>
 
+/* About 134 ms */
+#define ETHOSN_RECENT_BUSY_HALF_LIFE_SHIFT 27
+
 struct ethosn_inference;
 
 struct ethosn_addr_map {
@@ -47,8 +51,8 @@ struct ethosn_addr_map {
 };
 
 struct ethosn_inference_queue {
-	struct mutex     inference_queue_mutex;
-	struct list_head inference_queue;
+	struct mutex        inference_queue_mutex;
+	struct ethosn_sched sched;
 };
 
 struct ethosn_device {
@@ -59,6 +63,7 @@ struct ethosn_device {
 	int                           num_cores;
 	struct ethosn_inference_queue queue;
 	struct ethosn_dma_allocator   *allocator;
+	struct dentry                 *debug_dir;
 };
 
 enum ethosn_core_status {
@@ -120,10 +125,32 @@ struct ethosn_core {
 
 	struct ethosn_inference *current_inference;
 
+	/* The next inference to run on the core, dequeued and prepared while
+	 * current_inference runs so it can be sent to the firmware as soon as
+	 * current_inference completes.
+	 */
+	struct ethosn_inference *staged_inference;
+
 	/* Indicates if the core is busy or free.
 	 */
 	enum ethosn_core_status status;
 
+	/* Utilisation of the core, used to balance inferences across cores
+	 * and reported by ETHOSN_IOCTL_GET_COUNTER_VALUE. Protected by mutex.
+	 */
+	struct {
+		/* When current_inference was sent to the firmware */
+		u64 start_ns;
+		/* Total time spent running inferences */
+		u64 busy_ns;
+		/* Time spent running inferences, halved every
+		 * 2^ETHOSN_RECENT_BUSY_HALF_LIFE_SHIFT ns since recent_update_ns
+		 */
+		u64 recent_busy_ns;
+		u64 recent_update_ns;
+		u32 num_inferences;
+	} utilisation;
+
 	/*
 	 * This tells us if the device initialization has been completed.
 	 * Set it to 1 before returning from ethon_device_init().
@@ -181,6 +208,22 @@ int ethosn_device_init(struct ethosn_core *core);
  */
 void ethosn_device_deinit(struct ethosn_core *core);
 
+/**
+ * ethosn_device_debugfs_init() - Create the debugfs entries of the Ethos-N
+ *                                device which are shared by all its cores.
+ * @ethosn:	Pointer to Ethos-N device.
+ * @id:		Id of the device.
+ */
+void ethosn_device_debugfs_init(struct ethosn_device *ethosn,
+				int id);
+
+/**
+ * ethosn_device_debugfs_deinit() - Remove the debugfs entries of the Ethos-N
+ *                                  device.
+ * @ethosn:	Pointer to Ethos-N device.
+ */
+void ethosn_device_debugfs_deinit(struct ethosn_device *ethosn);
+
 /**
  * to_ethosn_addr() - Convert Linux address to Ethos-N address.
  * @linux_addr:		Linux address.
@@ -84,6 +84,54 @@ exit:
 	return dma_info;
 }
 
+struct ethosn_dma_info *ethosn_dma_import(
+	struct ethosn_dma_allocator *allocator,
+	struct page *const pages[],
+	int nr_pages)
+{
+	const struct ethosn_dma_allocator_ops *ops = get_ops(allocator);
+	struct ethosn_dma_info *dma_info;
+
+	if (!ops || !ops->import)
+		return ERR_PTR(-EOPNOTSUPP);
+
+	dma_info = ops->import(allocator, pages, nr_pages);
+
+	if (IS_ERR(dma_info))
+		dev_err(allocator->dev, "failed to dma_import %d pages\n",
+			nr_pages);
+	else
+		dev_dbg(allocator->dev,
+			"DMA import. handle=0x%pK, cpu_addr=0x%pK, size=%zu\n",
+			dma_info, dma_info->cpu_addr, dma_info->size);
+
+	return dma_info;
+}
+
+struct ethosn_dma_info *ethosn_dma_import_sgt(
+	struct ethosn_dma_allocator *allocator,
+	struct sg_table *sgt,
+	size_t size)
+{
+	const struct ethosn_dma_allocator_ops *ops = get_ops(allocator);
+	struct ethosn_dma_info *dma_info;
+
+	if (!ops || !ops->import_sgt)
+		return ERR_PTR(-EOPNOTSUPP);
+
+	dma_info = ops->import_sgt(allocator, sgt, size);
+
+	if (IS_ERR(dma_info))
+		dev_err(allocator->dev, "failed to dma_import %zu bytes\n",
+			size);
+	else
+		dev_dbg(allocator->dev,
+			"DMA import. handle=0x%pK, size=%zu\n",
+			dma_info, dma_info->size);
+
+	return dma_info;
+}
+
 int ethosn_dma_map(struct ethosn_dma_allocator *allocator,
 		   struct ethosn_dma_info *dma_info,
 		   int prot,
@@ -34,6 +34,7 @@
 #define ETHOSN_PROT_WRITE (1 << 1)
 
 struct device;
+struct sg_table;
 struct vm_area_struct;
 
 /*
@@ -60,6 +61,10 @@ struct ethosn_dma_allocator {
  * struct ethosn_dma_allocator_ops - Allocator operations for DMA memory
  * @destroy:           Deinitialize the allocator and free private resources
  * @alloc:             Allocate DMA memory
+ * @import             Wrap pages allocated elsewhere, which are not freed by
+ *                     free. Optional.
+ * @import_sgt         Wrap the pages of a mapped dma-buf attachment, which are
+ *                     not unmapped by free. Optional.
  * @free               Free DMA memory allocated with alloc
  * @map                Map virtual addresses
  * @unmap              Unmap virtual addresses
@@ -78,6 +83,14 @@ struct ethosn_dma_allocator_ops {
 	struct ethosn_dma_info *(*alloc)(struct ethosn_dma_allocator *allocator,
 					 size_t size,
 					 gfp_t gfp);
+	struct ethosn_dma_info *(*import)(
+		struct ethosn_dma_allocator *allocator,
+		struct page *const pages[],
+		int nr_pages);
+	struct ethosn_dma_info *(*import_sgt)(
+		struct ethosn_dma_allocator *allocator,
+		struct sg_table *sgt,
+		size_t size);
 	int                    (*map)(struct ethosn_dma_allocator *allocator,
 				      struct ethosn_dma_info *dma_info,
 				      int prot,
@@ -153,6 +166,44 @@ struct ethosn_dma_info *ethosn_dma_alloc(struct ethosn_dma_allocator *allocator,
 					 size_t size,
 					 gfp_t gfp);
 
+/**
+ * ethosn_dma_import() - Wrap pages allocated elsewhere as DMA memory, without
+ * mapping. The pages must stay allocated until the memory is freed, which
+ * does not free them.
+ * @allocator: Allocator object
+ * @pages: The pages, in order
+ * @nr_pages: Number of pages
+ *
+ * Return:
+ *  Pointer to ethosn_dma_info struct representing the memory
+ *  Or negative error code on failure, -EOPNOTSUPP if the allocator can't
+ *  import memory
+ */
+struct ethosn_dma_info *ethosn_dma_import(
+	struct ethosn_dma_allocator *allocator,
+	struct page *const pages[],
+	int nr_pages);
+
+/**
+ * ethosn_dma_import_sgt() - Wrap memory which a dma-buf exporter has mapped
+ * for the device, using the physical addresses of the pages in its scatter
+ * list. The memory must stay mapped until it is freed, which does not unmap
+ * it. It has no CPU address, nor can it be memory mapped or synced through
+ * the allocator.
+ * @allocator: Allocator object
+ * @sgt: Scatter list of the mapped dma-buf attachment
+ * @size: Size of the memory, a multiple of the page size
+ *
+ * Return:
+ *  Pointer to ethosn_dma_info struct representing the memory
+ *  Or negative error code on failure, -EOPNOTSUPP if the allocator can't
+ *  import memory
+ */
+struct ethosn_dma_info *ethosn_dma_import_sgt(
+	struct ethosn_dma_allocator *allocator,
+	struct sg_table *sgt,
+	size_t size);
+
 /**
  * ethosn_dma_map() - Map DMA memory
  * @allocator: Allocator object
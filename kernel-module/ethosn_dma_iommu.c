@@ -27,6 +27,7 @@
 #include <linux/iommu.h>
 #include <linux/iova.h>
 #include <linux/kernel.h>
+#include <linux/scatterlist.h>
 #include <linux/version.h>
 #include <linux/vmalloc.h>
 
@@ -72,8 +73,26 @@ struct ethosn_dma_info_internal {
 	/* Allocator private members */
 	dma_addr_t             *dma_addr;
 	struct page            **pages;
+	/* Set if the pages were imported, and so are not freed with the info */
+	bool                   imported;
+	/* Set if the memory came from the sg table of a dma-buf attachment.
+	 * phys_addr holds the physical address of each page, and there is
+	 * neither dma_addr nor pages, as the exporter owns the memory.
+	 */
+	bool                   exporter_mapped;
+	phys_addr_t            *phys_addr;
 };
 
+/* Address of a page of the memory, to map into the Ethos-N's address space */
+static phys_addr_t iommu_page_addr(struct ethosn_dma_info_internal *dma_info,
+				   int i)
+{
+	if (dma_info->exporter_mapped)
+		return dma_info->phys_addr[i];
+
+	return page_to_phys(dma_info->pages[i]);
+}
+
 static struct ethosn_iommu_stream *iommu_get_stream(
 	struct ethosn_iommu_domain *domain,
 	enum ethosn_stream_id stream_id)
@@ -194,7 +213,8 @@ static void iommu_free_iova(dma_addr_t start,
 static void iommu_free_pages(struct ethosn_dma_allocator *allocator,
 			     dma_addr_t dma_addr[],
 			     struct page *pages[],
-			     int nr_pages)
+			     int nr_pages,
+			     bool owned)
 {
 	int i;
 
@@ -203,7 +223,7 @@ static void iommu_free_pages(struct ethosn_dma_allocator *allocator,
 			dma_unmap_page(allocator->dev, dma_addr[i],
 				       PAGE_SIZE, DMA_BIDIRECTIONAL);
 
-		if (pages[i])
+		if (owned && pages[i])
 			__free_page(pages[i]);
 	}
 }
@@ -282,7 +302,7 @@ ret:
 	return &dma_info->info;
 
 free_pages:
-	iommu_free_pages(allocator, dma_addr, pages, i);
+	iommu_free_pages(allocator, dma_addr, pages, i, true);
 free_pages_list:
 	devm_kfree(allocator->dev, pages);
 free_dma_info:
@@ -292,6 +312,162 @@ early_exit:
 	return ERR_PTR(-ENOMEM);
 }
 
+static struct ethosn_dma_info *iommu_import(
+	struct ethosn_dma_allocator *allocator,
+	struct page *const pages[],
+	int nr_pages)
+{
+	struct ethosn_dma_info_internal *dma_info;
+	void *cpu_addr;
+	int i = 0;
+
+	if (nr_pages <= 0)
+		return ERR_PTR(-EINVAL);
+
+	dma_info =
+		devm_kzalloc(allocator->dev,
+			     sizeof(struct ethosn_dma_info_internal),
+			     GFP_KERNEL);
+	if (!dma_info)
+		goto early_exit;
+
+	dma_info->pages = (struct page **)
+			  devm_kzalloc(allocator->dev,
+				       sizeof(struct page *) * nr_pages,
+				       GFP_KERNEL);
+	if (!dma_info->pages)
+		goto free_dma_info;
+
+	memcpy(dma_info->pages, pages, sizeof(struct page *) * nr_pages);
+
+	dma_info->dma_addr = (dma_addr_t *)
+			     devm_kzalloc(allocator->dev,
+					  sizeof(dma_addr_t) * nr_pages,
+					  GFP_KERNEL);
+	if (!dma_info->dma_addr)
+		goto free_pages_list;
+
+	for (i = 0; i < nr_pages; ++i) {
+		dma_info->dma_addr[i] =
+			dma_map_page(allocator->dev, pages[i], 0,
+				     PAGE_SIZE,
+				     DMA_BIDIRECTIONAL);
+
+		if (dma_mapping_error(allocator->dev, dma_info->dma_addr[i])) {
+			dev_err(allocator->dev,
+				"failed to dma map pa 0x%llX\n",
+				page_to_phys(pages[i]));
+			goto unmap_pages;
+		}
+	}
+
+	cpu_addr = vmap(dma_info->pages, nr_pages, 0, PAGE_KERNEL);
+	if (!cpu_addr)
+		goto unmap_pages;
+
+	dma_info->info = (struct ethosn_dma_info) {
+		.size = (size_t)nr_pages * PAGE_SIZE,
+		.cpu_addr = cpu_addr,
+		.iova_addr = 0
+	};
+	dma_info->imported = true;
+
+	dev_dbg(allocator->dev, "Imported DMA. handle=%p", dma_info);
+
+	return &dma_info->info;
+
+unmap_pages:
+	iommu_free_pages(allocator, dma_info->dma_addr, dma_info->pages, i,
+			 false);
+	devm_kfree(allocator->dev, dma_info->dma_addr);
+free_pages_list:
+	devm_kfree(allocator->dev, dma_info->pages);
+free_dma_info:
+	devm_kfree(allocator->dev, dma_info);
+early_exit:
+
+	return ERR_PTR(-ENOMEM);
+}
+
+static struct ethosn_dma_info *iommu_import_sgt(
+	struct ethosn_dma_allocator *allocator,
+	struct sg_table *sgt,
+	size_t size)
+{
+	struct ethosn_dma_info_internal *dma_info;
+	struct scatterlist *sg;
+	int nr_pages = DIV_ROUND_UP(size, PAGE_SIZE);
+	int i = 0;
+	int k;
+
+	if (!size || !PAGE_ALIGNED(size))
+		return ERR_PTR(-EINVAL);
+
+	dma_info =
+		devm_kzalloc(allocator->dev,
+			     sizeof(struct ethosn_dma_info_internal),
+			     GFP_KERNEL);
+	if (!dma_info)
+		return ERR_PTR(-ENOMEM);
+
+	dma_info->phys_addr = (phys_addr_t *)
+			      devm_kzalloc(allocator->dev,
+					   sizeof(phys_addr_t) * nr_pages,
+					   GFP_KERNEL);
+	if (!dma_info->phys_addr) {
+		devm_kfree(allocator->dev, dma_info);
+
+		return ERR_PTR(-ENOMEM);
+	}
+
+	/* The addresses the exporter mapped for ethosn->dev are bus addresses,
+	 * which may be offset, bounced or translated by another IOMMU, so
+	 * they can't be put in the Ethos-N's own page tables. Use the physical
+	 * address of the memory behind each entry instead.
+	 */
+	for_each_sg(sgt->sgl, sg, sgt->orig_nents, k) {
+		phys_addr_t addr;
+		unsigned int len = sg->length;
+
+		if (!sg_page(sg))
+			goto invalid;
+
+		addr = sg_phys(sg);
+		if (!PAGE_ALIGNED(addr) || !PAGE_ALIGNED(len))
+			goto invalid;
+
+		while (len && i < nr_pages) {
+			dma_info->phys_addr[i++] = addr;
+			addr += PAGE_SIZE;
+			len -= PAGE_SIZE;
+		}
+	}
+
+	if (i != nr_pages)
+		goto invalid;
+
+	dma_info->info = (struct ethosn_dma_info) {
+		.size = size,
+		.cpu_addr = NULL,
+		.iova_addr = 0
+	};
+	dma_info->imported = true;
+	dma_info->exporter_mapped = true;
+
+	dev_dbg(allocator->dev, "Imported DMA from sg table. handle=%p",
+		dma_info);
+
+	return &dma_info->info;
+
+invalid:
+	dev_err(allocator->dev,
+		"dma-buf memory is not page aligned or has no pages\n");
+	devm_kfree(allocator->dev, dma_info->phys_addr);
+	devm_kfree(allocator->dev, dma_info);
+
+	return ERR_PTR(-EINVAL);
+}
+
 static void iommu_unmap_iova_pages(struct ethosn_dma_info_internal *dma_info,
 				   struct iommu_domain *domain,
 				   struct ethosn_iommu_stream *stream)
@@ -303,7 +479,7 @@ static void iommu_unmap_iova_pages(struct ethosn_dma_info_internal *dma_info,
 		unsigned long iova_addr =
 			dma_info->info.iova_addr + i * PAGE_SIZE;
 
-		if (dma_info->pages[i]) {
+		if (dma_info->exporter_mapped || dma_info->pages[i]) {
 			/* TODO: Should handle error here */
 			iommu_unmap(domain, iova_addr, PAGE_SIZE);
 
@@ -343,7 +519,7 @@ static int iommu_iova_map(struct ethosn_dma_allocator *allocator,
 	if (!stream)
 		goto early_exit;
 
-	if (!dma_info->pages)
+	if (!dma_info->pages && !dma_info->exporter_mapped)
 		goto early_exit;
 
 	start_addr = iommu_alloc_iova(dma_info, domain, stream);
@@ -370,7 +546,7 @@ static int iommu_iova_map(struct ethosn_dma_allocator *allocator,
 		err = iommu_map(
 			domain->iommu_domain,
 			start_addr + i * PAGE_SIZE,
-			page_to_phys(dma_info->pages[i]),
+			iommu_page_addr(dma_info, i),
 			PAGE_SIZE,
 			iommu_prot);
 
@@ -378,7 +554,7 @@ static int iommu_iova_map(struct ethosn_dma_allocator *allocator,
 			dev_err(allocator->dev,
 				"failed to iommu map iova 0x%llX pa 0x%llX size %lu\n",
 				start_addr + i * PAGE_SIZE,
-				page_to_phys(dma_info->pages[i]), PAGE_SIZE);
+				iommu_page_addr(dma_info, i), PAGE_SIZE);
 			goto unmap_pages;
 		}
 	}
@@ -433,9 +609,12 @@ static void iommu_free(struct ethosn_dma_allocator *allocator,
 
 	vunmap(dma_info->info.cpu_addr);
 
-	if (dma_info->info.size) {
+	if (dma_info->exporter_mapped) {
+		/* The exporter unmaps the memory when it is detached */
+		devm_kfree(allocator->dev, dma_info->phys_addr);
+	} else if (dma_info->info.size) {
 		iommu_free_pages(allocator, dma_info->dma_addr, dma_info->pages,
-				 nr_pages);
+				 nr_pages, !dma_info->imported);
 
 		devm_kfree(allocator->dev, dma_info->dma_addr);
 		devm_kfree(allocator->dev, dma_info->pages);
@@ -453,6 +632,10 @@ static void iommu_sync_for_device(struct ethosn_dma_allocator *allocator,
 	int nr_pages = DIV_ROUND_UP(_dma_info->size, PAGE_SIZE);
 	int i;
 
+	/* Imported dma-bufs are synced through the dma-buf */
+	if (dma_info->exporter_mapped)
+		return;
+
 	for (i = 0; i < nr_pages; ++i)
 		dma_sync_single_for_device(allocator->dev,
 					   dma_info->dma_addr[i], PAGE_SIZE,
@@ -468,6 +651,9 @@ static void iommu_sync_for_cpu(struct ethosn_dma_allocator *allocator,
 
 	int i;
 
+	if (dma_info->exporter_mapped)
+		return;
+
 	for (i = 0; i < nr_pages; ++i)
 		dma_sync_single_for_cpu(allocator->dev,
 					dma_info->dma_addr[i],
@@ -483,6 +669,10 @@ static int iommu_mmap(struct ethosn_dma_allocator *allocator,
 	int nr_pages = DIV_ROUND_UP(_dma_info->size, PAGE_SIZE);
 	int i;
 
+	/* Imported dma-bufs are mapped through the dma-buf */
+	if (dma_info->exporter_mapped)
+		return -EINVAL;
+
 	for (i = 0; i < nr_pages; ++i) {
 		unsigned long addr = vma->vm_start + i * PAGE_SIZE;
 		unsigned long pfn = page_to_pfn(dma_info->pages[i]);
@@ -610,6 +800,8 @@ struct ethosn_dma_allocator *ethosn_dma_iommu_allocator_create(
 	static const struct ethosn_dma_allocator_ops ops = {
 		.destroy         = iommu_allocator_destroy,
 		.alloc           = iommu_alloc,
+		.import          = iommu_import,
+		.import_sgt      = iommu_import_sgt,
 		.free            = iommu_free,
 		.mmap            = iommu_mmap,
 		.map             = iommu_iova_map,
@@ -48,6 +48,7 @@
 #include <linux/uaccess.h>
 #include <linux/version.h>
 #include <linux/iommu.h>
+#include <linux/math64.h>
 
 #define ETHOSN_DRIVER_NAME    "ethosn"
 #define ETHOSN_DRIVER_VERSION "0.01"
@@ -724,6 +725,31 @@ static long ethosn_ioctl(struct file *const filep,
 
 		break;
 	}
+	case ETHOSN_IOCTL_IMPORT_BUFFER: {
+		struct ethosn_buffer_import_req import_req;
+
+		if (copy_from_user(&import_req, udata, sizeof(import_req))) {
+			ret = -EFAULT;
+			break;
+		}
+
+		ret = mutex_lock_interruptible(&ethosn->mutex);
+		if (ret)
+			break;
+
+		dev_dbg(ethosn->dev,
+			"IOCTL: Import buffer. type=%u, size=%u, flags=0x%x\n",
+			import_req.type, import_req.size, import_req.flags);
+
+		ret = ethosn_buffer_import(ethosn, &import_req);
+
+		dev_dbg(ethosn->dev,
+			"IOCTL: Imported buffer. fd=%d\n", ret);
+
+		mutex_unlock(&ethosn->mutex);
+
+		break;
+	}
 	case ETHOSN_IOCTL_REGISTER_NETWORK: {
 		struct ethosn_network_req net_req;
 
@@ -841,33 +867,58 @@ configure_profiling_end:
 		break;
 	}
 	case ETHOSN_IOCTL_GET_COUNTER_VALUE: {
-		struct ethosn_core *core = ethosn->core[0];
+		struct ethosn_core *core;
 		enum ethosn_poll_counter_name counter_name;
-
-		ret = mutex_lock_interruptible(&core->mutex);
-		if (ret)
-			break;
-
-		if (!core->profiling.config.enable_profiling) {
-			ret = -ENODATA;
-			dev_err(core->dev, "Profiling counter: no data\n");
-			goto get_counter_value_end;
-		}
+		u32 core_id;
 
 		if (copy_from_user(&counter_name, udata,
 				   sizeof(counter_name))) {
 			ret = -EFAULT;
-			dev_err(core->dev,
+			dev_err(ethosn->dev,
 				"Profiling counter: error in copy_from_user\n");
-			goto get_counter_value_end;
+			break;
 		}
 
+		core_id = (u32)counter_name >> ETHOSN_POLL_COUNTER_CORE_SHIFT;
+		if (core_id >= ethosn->num_cores) {
+			ret = -EINVAL;
+			dev_err(ethosn->dev,
+				"Profiling counter: invalid core_id\n");
+			break;
+		}
+
+		core = ethosn->core[core_id];
+		counter_name &= ETHOSN_POLL_COUNTER_NAME_MASK;
+
+		ret = mutex_lock_interruptible(&core->mutex);
+		if (ret)
+			break;
+
 		switch (counter_name) {
 		case ETHOSN_POLL_COUNTER_NAME_MAILBOX_MESSAGES_SENT:
-			ret = core->profiling.mailbox_messages_sent;
-			break;
 		case ETHOSN_POLL_COUNTER_NAME_MAILBOX_MESSAGES_RECEIVED:
-			ret = core->profiling.mailbox_messages_received;
+			if (!core->profiling.config.enable_profiling) {
+				ret = -ENODATA;
+				dev_err(core->dev,
+					"Profiling counter: no data\n");
+				break;
+			}
+
+			ret = counter_name ==
+			      ETHOSN_POLL_COUNTER_NAME_MAILBOX_MESSAGES_SENT ?
+			      core->profiling.mailbox_messages_sent :
+			      core->profiling.mailbox_messages_received;
+			break;
+		case ETHOSN_POLL_COUNTER_NAME_INFERENCES_RUN:
+			ret = core->utilisation.num_inferences & INT_MAX;
+			break;
+		case ETHOSN_POLL_COUNTER_NAME_BUSY_TIME_MS:
+			ret = div_u64(core->utilisation.busy_ns,
+				      NSEC_PER_MSEC) & INT_MAX;
+			break;
+		case ETHOSN_POLL_COUNTER_NAME_QUEUE_DEPTH:
+			ret = (core->current_inference ? 1 : 0) +
+			      (core->staged_inference ? 1 : 0);
 			break;
 		default:
 			ret = -EINVAL;
@@ -876,7 +927,6 @@ configure_profiling_end:
 			break;
 		}
 
-get_counter_value_end:
 		mutex_unlock(&core->mutex);
 
 		break;
@@ -958,6 +1008,8 @@ static void ethosn_device_release(void *const opaque)
 
 	sysfs_remove_files(&ethosn->dev->kobj, attrs);
 
+	ethosn_device_debugfs_deinit(ethosn);
+
 	device_destroy(&ethosn_class, cdev->dev);
 	cdev_del(cdev);
 	ida_simple_remove(&ethosn_ida, MINOR(cdev->dev));
@@ -1005,6 +1057,8 @@ static int ethosn_device_create(struct ethosn_device *ethosn)
 	if (ret)
 		goto destroy_device;
 
+	ethosn_device_debugfs_init(ethosn, id);
+
 	return devm_add_action_or_reset(ethosn->dev,
 					ethosn_device_release,
 					ethosn);
@@ -1305,7 +1359,7 @@ static int ethosn_pdev_probe(struct platform_device *pdev)
 	if (IS_ERR_OR_NULL(ethosn->allocator))
 		goto err_free_ethosn;
 
-	INIT_LIST_HEAD(&ethosn->queue.inference_queue);
+	ethosn_sched_init(&ethosn->queue.sched);
 
 	/* Allocate space for num_of_npus ethosn cores */
 	ethosn->core = devm_kzalloc(&pdev->dev,
@@ -31,6 +31,7 @@
 
 #include <linux/anon_inodes.h>
 #include <linux/atomic.h>
+#include <linux/capability.h>
 #include <linux/device.h>
 #include <linux/file.h>
 #include <linux/fs.h>
@@ -72,27 +73,73 @@ struct ethosn_network {
 	u32                       num_outputs;
 	struct ethosn_buffer_info *outputs;
 
+	/* Id of the binding set whose input and output bindings are currently
+	 * in the inference data of each core, or 0 if none.
+	 */
+	u64                       *bound_binding_set_ids;
+
+	/* The network is the client its inferences are queued by */
+	struct ethosn_sched_client sched_client;
+
+	/* Priority class of the inferences scheduled and the binding sets
+	 * created from now on. Set without any lock held, so it is accessed
+	 * with READ_ONCE()/WRITE_ONCE().
+	 */
+	u32                       priority;
+
+	/* The core that last ran an inference of the network, or NULL */
+	struct ethosn_core        *last_core;
+
 	/* file pointer used for ref-counting */
 	struct file               *file;
 };
 
-struct ethosn_inference {
-	struct ethosn_core    *core;
+struct ethosn_binding_set {
 	struct ethosn_network *network;
 
-	struct list_head      queue_node;
+	/* Unique (non-zero) id, used to tell whether the bindings of this set
+	 * are already in the inference data of a core.
+	 */
+	u64                   id;
+
+	u32                   priority;
 
 	struct ethosn_buffer  **inputs;
 	struct ethosn_buffer  **outputs;
 
-	u32                   status;
+	/* file pointer used for ref-counting */
+	struct file           *file;
+};
+
+struct ethosn_inference {
+	struct ethosn_core        *core;
+	struct ethosn_network     *network;
+
+	struct ethosn_sched_entry sched_entry;
+	u32                       priority;
+
+	/* If not NULL, inputs and outputs are owned by the binding set */
+	struct ethosn_binding_set *binding_set;
+
+	struct ethosn_buffer      **inputs;
+	struct ethosn_buffer      **outputs;
 
-	wait_queue_head_t     poll_wqh;
+	u32                       status;
+
+	/* Set once the work done by schedule_inference() has been done ahead
+	 * of time, while the inference was staged on its core.
+	 */
+	bool                      buffers_synced;
+	bool                      bindings_updated;
+
+	wait_queue_head_t         poll_wqh;
 
 	/* Reference counting */
-	struct kref           kref;
+	struct kref               kref;
 };
 
+static atomic64_t binding_set_id_counter = ATOMIC64_INIT(0);
+
 static struct device *net_to_dev(const struct ethosn_network *const net)
 {
 	return net->ethosn->dev;
@@ -247,8 +294,12 @@ static void inference_kref_release(struct kref *kref)
 
 	put_network(network);
 
-	free_buffers(network->num_inputs, inference->inputs);
-	free_buffers(network->num_outputs, inference->outputs);
+	if (inference->binding_set) {
+		fput(inference->binding_set->file);
+	} else {
+		free_buffers(network->num_inputs, inference->inputs);
+		free_buffers(network->num_outputs, inference->outputs);
+	}
 
 	kfree(inference);
 }
@@ -324,34 +375,58 @@ err_free_bufs:
 }
 
 /**
- * schedule_inference() - Send an inference to Ethos-N
+ * sync_inference_buffers() - Sync the input and output buffers of an
+ *                            inference for the device
+ * @inference:	Inference with a core assigned.
+ */
+static void sync_inference_buffers(struct ethosn_inference *inference)
+{
+	struct ethosn_network *network = inference->network;
+	u32 i;
+
+	for (i = 0; i < network->num_inputs; ++i)
+		ethosn_buffer_sync_for_device(inference->inputs[i]);
+
+	for (i = 0; i < network->num_outputs; ++i)
+		ethosn_buffer_sync_for_device(inference->outputs[i]);
+
+	inference->buffers_synced = true;
+}
+
+/**
+ * bind_inference() - Write the bindings of an inference into the inference
+ *                    data of its network for its core
+ * @inference:	Inference with a core assigned.
+ *
+ * The inference data of a network is shared by all the inferences of the
+ * network on a core, so this must not be called while an inference of the same
+ * network is running on the core.
  *
- * If an inference isn't already running, send it to Ethos-N for execution.
  * Return:
  * * 0 - OK
  * * Negative error code
  */
-static int schedule_inference(struct ethosn_inference *inference)
+static int bind_inference(struct ethosn_inference *inference)
 {
 	struct ethosn_network *network = inference->network;
 	struct ethosn_core *core = inference->core;
 	uint32_t core_id = core->core_id;
-	struct device *dev = core->dev;
+	struct ethosn_binding_set *binding_set = inference->binding_set;
+	bool bound;
 	u32 i;
 	int ret;
 
-	if (inference->status != ETHOSN_INFERENCE_SCHEDULED)
-		return 0;
-
-	inference->status = ETHOSN_INFERENCE_RUNNING;
+	/* The input and output bindings don't need updating if the last
+	 * inference of this network on this core used the same binding set.
+	 */
+	bound = binding_set &&
+		(network->bound_binding_set_ids[core_id] == binding_set->id);
+	if (!bound)
+		network->bound_binding_set_ids[core_id] = 0;
 
-	for (i = 0; i < network->num_inputs; ++i) {
+	for (i = 0; i < network->num_inputs && !bound; ++i) {
 		struct ethosn_dma_info *dma_info =
 			inference->inputs[i]->dma_info;
-		struct ethosn_dma_allocator *allocator =
-			core->parent->allocator;
-
-		ethosn_dma_sync_for_device(allocator, dma_info);
 
 		ret = update_bindings(network,
 				      core_id,
@@ -362,16 +437,12 @@ static int schedule_inference(struct ethosn_inference *inference)
 				      false,
 				      true);
 		if (WARN_ON(ret))
-			goto out_inference_error;
+			return ret;
 	}
 
-	for (i = 0; i < network->num_outputs; ++i) {
+	for (i = 0; i < network->num_outputs && !bound; ++i) {
 		struct ethosn_dma_info *dma_info =
 			inference->outputs[i]->dma_info;
-		struct ethosn_dma_allocator *allocator =
-			core->parent->allocator;
-
-		ethosn_dma_sync_for_device(allocator, dma_info);
 
 		ret = update_bindings(network,
 				      core_id,
@@ -382,9 +453,12 @@ static int schedule_inference(struct ethosn_inference *inference)
 				      false,
 				      true);
 		if (WARN_ON(ret))
-			goto out_inference_error;
+			return ret;
 	}
 
+	if (binding_set)
+		network->bound_binding_set_ids[core_id] = binding_set->id;
+
 	ethosn_dma_sync_for_device(core->allocator,
 				   network->intermediate_data[core_id]);
 	ret = update_bindings(network,
@@ -397,10 +471,49 @@ static int schedule_inference(struct ethosn_inference *inference)
 			      network->intermediate_data[core_id]->size,
 			      false,
 			      true);
-
 	if (ret)
 		return ret;
 
+	ethosn_dma_sync_for_device(core->allocator,
+				   network->inference_data[core_id]);
+
+	inference->bindings_updated = true;
+
+	return 0;
+}
+
+/**
+ * schedule_inference() - Send an inference to Ethos-N
+ *
+ * If an inference isn't already running, send it to Ethos-N for execution.
+ * The buffers and bindings are only prepared here if that was not already done
+ * while the inference was staged.
+ * Return:
+ * * 0 - OK
+ * * Negative error code
+ */
+static int schedule_inference(struct ethosn_inference *inference)
+{
+	struct ethosn_network *network = inference->network;
+	struct ethosn_core *core = inference->core;
+	uint32_t core_id = core->core_id;
+	struct device *dev = core->dev;
+	int ret;
+
+	if (inference->status != ETHOSN_INFERENCE_SCHEDULED)
+		return 0;
+
+	inference->status = ETHOSN_INFERENCE_RUNNING;
+
+	if (!inference->buffers_synced)
+		sync_inference_buffers(inference);
+
+	if (!inference->bindings_updated) {
+		ret = bind_inference(inference);
+		if (ret)
+			goto out_inference_error;
+	}
+
 	if (ethosn_mailbox_empty(core->mailbox_request->cpu_addr) &&
 	    core->profiling.config.enable_profiling) {
 		/* Send sync message */
@@ -411,8 +524,6 @@ static int schedule_inference(struct ethosn_inference *inference)
 
 	/* kick off execution */
 	dev_dbg(dev, "Starting execution of inference");
-	ethosn_dma_sync_for_device(core->allocator,
-				   network->inference_data[core_id]);
 	core->current_inference = inference;
 
 	/* send the inference to the core (ethosn) assigned to it */
@@ -426,6 +537,8 @@ static int schedule_inference(struct ethosn_inference *inference)
 	}
 
 	get_inference(inference);
+	core->utilisation.start_ns = ktime_get_ns();
+	WRITE_ONCE(network->last_core, core);
 	dev_dbg(dev, "Scheduled inference 0x%pK on core_id = %d\n", inference,
 		core->core_id);
 
@@ -440,99 +553,248 @@ out_inference_error:
 }
 
 /**
- * get_free_core() - Get the next free core.
+ * recent_busy_time() - Get the time a core has recently spent running
+ *                      inferences.
+ * @core:	Ethos-N core.
+ * @now:	Current time in ns.
+ *
+ * Return: Busy time in ns, decayed by half every
+ * 2^ETHOSN_RECENT_BUSY_HALF_LIFE_SHIFT ns.
+ */
+static u64 recent_busy_time(const struct ethosn_core *core,
+			    u64 now)
+{
+	u64 half_lives = (now - core->utilisation.recent_update_ns) >>
+			 ETHOSN_RECENT_BUSY_HALF_LIFE_SHIFT;
+
+	if (half_lives >= 64)
+		return 0;
+
+	return core->utilisation.recent_busy_ns >> half_lives;
+}
+
+/**
+ * end_busy_period() - Account for the current inference of a core having
+ *                     stopped running.
+ * @core:	Ethos-N core, with its mutex held.
+ */
+static void end_busy_period(struct ethosn_core *core)
+{
+	u64 now = ktime_get_ns();
+	u64 busy = now - core->utilisation.start_ns;
+
+	core->utilisation.busy_ns += busy;
+	core->utilisation.recent_busy_ns = recent_busy_time(core, now) + busy;
+	core->utilisation.recent_update_ns = now;
+	++core->utilisation.num_inferences;
+}
+
+/**
+ * get_free_core() - Get the free core best suited to the next inference.
  * @ethosn:	ethosn_parent_device
+ * @preferred:	Core that last ran the network of the next inference, or NULL.
  *
- * Iterates through the list of cores present in the parent device and returns
- * the first free core.
+ * Returns @preferred if it is free, as the bindings of the network may not need
+ * updating there. Otherwise, balances the load by returning the free core
+ * which has been the least busy recently.
  *
  * Return: Pointer to ethosn_device (corresponding to the free core), else
  * NULL (if all the cores are busy)
  */
-static struct ethosn_core *get_free_core(struct ethosn_device *ethosn)
+static struct ethosn_core *get_free_core(struct ethosn_device *ethosn,
+					 struct ethosn_core *preferred)
 {
-	int i = 0, ret = 0;
+	struct ethosn_core *core;
 	bool found = false;
-	struct ethosn_core *core = NULL;
+	int i, ret;
 
-	while (i < ethosn->num_cores) {
-		/* Check the status of the core
-		 */
-		ret = mutex_lock_interruptible(&ethosn->core[i]->mutex);
+	do {
+		u64 now = ktime_get_ns();
+		u64 best_busy = U64_MAX;
+
+		core = NULL;
+
+		/* Check the status of the cores */
+		for (i = 0; i < ethosn->num_cores; ++i) {
+			struct ethosn_core *candidate = ethosn->core[i];
+			u64 busy;
 
+			ret = mutex_lock_interruptible(&candidate->mutex);
+			if (ret)
+				return NULL;
+
+			busy = recent_busy_time(candidate, now);
+			if (candidate->status == ETHOSN_CORE_FREE &&
+			    (candidate == preferred || busy < best_busy)) {
+				core = candidate;
+				best_busy = candidate == preferred ? 0 : busy;
+			}
+
+			mutex_unlock(&candidate->mutex);
+		}
+
+		if (!core)
+			break;
+
+		/* The core may have been taken since it was checked */
+		ret = mutex_lock_interruptible(&core->mutex);
 		if (ret)
-			goto end;
+			return NULL;
 
-		if (ethosn->core[i]->status == ETHOSN_CORE_FREE) {
-			core = ethosn->core[i];
+		if (core->status == ETHOSN_CORE_FREE) {
 			core->status = ETHOSN_CORE_BUSY;
 			found = true;
 		}
 
-		mutex_unlock(&ethosn->core[i]->mutex);
+		mutex_unlock(&core->mutex);
+	} while (!found);
 
-		if (found)
-			break;
+	return core;
+}
 
-		i++;
-	}
+/**
+ * preferred_core() - Get the core that last ran the network of the next
+ *                    queued inference.
+ * @ethosn:	Ethos-N device
+ *
+ * Return: Pointer to the core, else NULL if there is none.
+ */
+static struct ethosn_core *preferred_core(struct ethosn_device *ethosn)
+{
+	struct ethosn_sched_entry *entry;
+	struct ethosn_core *core = NULL;
+
+	if (mutex_lock_interruptible(&ethosn->queue.inference_queue_mutex))
+		return NULL;
 
-end:
+	/* The queued inference holds a reference to its network */
+	entry = ethosn_sched_peek(&ethosn->queue.sched);
+	if (entry)
+		core = READ_ONCE(container_of(entry, struct ethosn_inference,
+					      sched_entry)->network->last_core);
+
+	mutex_unlock(&ethosn->queue.inference_queue_mutex);
 
 	return core;
 }
 
 /**
- * schedule_queued_inference() - Schedule a queue inference.
+ * dequeue_inference() - Take the next inference off the queue for a core.
  * @core:	Ethos-N core.
  *
- * Pop the inference queue until either the queue is empty or an inference has
- * been successfully scheduled.
+ * The inference is assigned to @core and a reference to it is taken, so that
+ * it can't be freed before it has been sent to the firmware, even if its file
+ * descriptor is closed in the meantime.
+ *
+ * Return: Inference to be put by the caller, else NULL if the queue is empty.
  */
-static void schedule_queued_inference(struct ethosn_core *core)
+static struct ethosn_inference *dequeue_inference(struct ethosn_core *core)
 {
 	struct ethosn_inference *inference = NULL;
 	struct ethosn_device *ethosn = core->parent;
+	struct ethosn_sched_entry *entry;
 	int ret = 0;
-	bool found = false;
 
-	if (!list_empty(&ethosn->queue.inference_queue)) {
-		/* This will be invoked from the irq handlers of multiple npus.
-		 * The inference queue needs to be protected against concurrent
-		 * operation.
-		 */
-		ret = mutex_lock_interruptible(
-			&ethosn->queue.inference_queue_mutex);
-		if (ret)
-			return;
+	if (ethosn_sched_empty(&ethosn->queue.sched))
+		return NULL;
 
-		found = false;
+	/* This will be invoked from the irq handlers of multiple npus.
+	 * The inference queue needs to be protected against concurrent
+	 * operation.
+	 */
+	ret = mutex_lock_interruptible(&ethosn->queue.inference_queue_mutex);
+	if (ret)
+		return NULL;
 
-		inference = list_first_entry(&ethosn->queue.inference_queue,
-					     typeof(*inference),
-					     queue_node);
-		if (inference == NULL) {
-			dev_dbg(ethosn->dev,
-				"Inference is NULL\n");
-			found = false;
-		} else {
-			found = true;
-		}
+	entry = ethosn_sched_dequeue(&ethosn->queue.sched);
+	if (entry) {
+		inference = container_of(entry, struct ethosn_inference,
+					 sched_entry);
 
-		if (found) {
-			/* Schedule the inference on a particular core */
-			inference->core = core;
+		/* Schedule the inference on a particular core */
+		inference->core = core;
+		get_inference(inference);
+	} else {
+		dev_dbg(ethosn->dev,
+			"Inference is NULL\n");
+	}
 
-			list_del(&inference->queue_node);
-		}
+	mutex_unlock(&ethosn->queue.inference_queue_mutex);
 
-		mutex_unlock(&ethosn->queue.inference_queue_mutex);
+	return inference;
+}
 
-		if (found)
-			(void)schedule_inference(inference);
+/**
+ * schedule_queued_inference() - Schedule a queue inference.
+ * @core:	Ethos-N core.
+ *
+ * Pop the inference queue until either the queue is empty or an inference has
+ * been successfully scheduled.
+ */
+static void schedule_queued_inference(struct ethosn_core *core)
+{
+	struct ethosn_inference *inference = dequeue_inference(core);
+
+	if (inference) {
+		(void)schedule_inference(inference);
+		put_inference(inference);
 	}
 }
 
+/**
+ * stage_queued_inference() - Prepare the next queued inference on a busy core.
+ * @core:	Ethos-N core, with its mutex held.
+ *
+ * Take the next inference off the queue and do as much of the work of
+ * scheduling it as possible while the current inference runs, so that the
+ * core doesn't idle while it is prepared once the current inference completes.
+ * The bindings can only be updated ahead of time for an inference of a
+ * different network, as bind_inference() would otherwise overwrite the
+ * bindings of the running inference.
+ */
+static void stage_queued_inference(struct ethosn_core *core)
+{
+	struct ethosn_inference *inference;
+
+	if (!core->current_inference || core->staged_inference)
+		return;
+
+	inference = dequeue_inference(core);
+	if (!inference)
+		return;
+
+	sync_inference_buffers(inference);
+
+	/* Failures are reported when the inference is scheduled */
+	if (inference->network != core->current_inference->network)
+		(void)bind_inference(inference);
+
+	/* The staged inference keeps the reference taken when dequeuing it */
+	core->staged_inference = inference;
+
+	dev_dbg(core->dev, "Staged inference 0x%pK on core_id = %d\n",
+		inference, core->core_id);
+}
+
+/**
+ * enqueue_inference() - Queue an inference with the priority its network had
+ *                       when it was created, on behalf of its network.
+ * @inference:	Inference, whose priority has already been validated.
+ *
+ * Must be called with the inference queue mutex held.
+ */
+static void enqueue_inference(struct ethosn_inference *inference)
+{
+	struct ethosn_network *network = inference->network;
+	int ret;
+
+	ret = ethosn_sched_enqueue(&network->ethosn->queue.sched,
+				   &inference->sched_entry,
+				   &network->sched_client,
+				   inference->priority);
+	WARN_ON(ret);
+}
+
 /**
  * inference_create() - Create and schedule an inference job
  * @network: Inference network
@@ -559,7 +821,9 @@ struct ethosn_inference *inference_create(struct ethosn_network *network,
 	get_network(network);
 
 	inference->network = network;
+	inference->priority = READ_ONCE(network->priority);
 	inference->status = ETHOSN_INFERENCE_SCHEDULED;
+	ethosn_sched_entry_init(&inference->sched_entry);
 	init_waitqueue_head(&inference->poll_wqh);
 	kref_init(&inference->kref);
 
@@ -589,12 +853,45 @@ err_put_inference:
 	return ERR_PTR(ret);
 }
 
+/**
+ * inference_create_from_binding_set() - Create an inference job using the
+ *                                       buffers of a binding set
+ * @binding_set: Binding set
+ *
+ * Return: Valid pointer on success, else error pointer.
+ */
+static struct ethosn_inference *inference_create_from_binding_set(
+	struct ethosn_binding_set *binding_set)
+{
+	struct ethosn_network *network = binding_set->network;
+	struct ethosn_inference *inference;
+
+	inference = kzalloc(sizeof(*inference), GFP_KERNEL);
+	if (!inference)
+		return ERR_PTR(-ENOMEM);
+
+	get_network(network);
+	get_file(binding_set->file);
+
+	inference->network = network;
+	inference->binding_set = binding_set;
+	inference->inputs = binding_set->inputs;
+	inference->outputs = binding_set->outputs;
+	inference->priority = binding_set->priority;
+	inference->status = ETHOSN_INFERENCE_SCHEDULED;
+	ethosn_sched_entry_init(&inference->sched_entry);
+	init_waitqueue_head(&inference->poll_wqh);
+	kref_init(&inference->kref);
+
+	return inference;
+}
+
 static int inference_release(struct inode *inode,
 			     struct file *filep)
 {
 	struct ethosn_inference *inference = filep->private_data;
 	struct ethosn_core *core = inference->core;
-	struct ethosn_device *ethosn = core->parent;
+	struct ethosn_device *ethosn = inference->network->ethosn;
 
 	/* The inference queue belongs to the parent device and should
 	 * be protected by the parent's mutex.
@@ -602,13 +899,29 @@ static int inference_release(struct inode *inode,
 	 * sure we release the network so we don't leak resources.
 	 * This would prevent the kernel module from being unloaded
 	 * when requested.
+	 * The core is only assigned once the inference is running and the
+	 * inference may not have been queued yet, if it is being released
+	 * because a batch failed to be scheduled.
 	 */
 	if (inference->status == ETHOSN_INFERENCE_SCHEDULED) {
 		mutex_lock(
 			&ethosn->queue.inference_queue_mutex);
-		list_del(&inference->queue_node);
+		ethosn_sched_remove(&ethosn->queue.sched,
+				    &inference->sched_entry);
+		core = inference->core;
 		mutex_unlock(
 			&ethosn->queue.inference_queue_mutex);
+
+		/* A dequeued inference may be staged on a core. */
+		if (core) {
+			mutex_lock(&core->mutex);
+			if (core->staged_inference == inference) {
+				core->staged_inference = NULL;
+				put_inference(inference);
+			}
+
+			mutex_unlock(&core->mutex);
+		}
 	}
 
 	if (inference->status == ETHOSN_INFERENCE_RUNNING) {
@@ -673,30 +986,85 @@ static ssize_t inference_read(struct file *file,
 	       sizeof(inference->status);
 }
 
+static const struct file_operations inference_fops = {
+	.owner   = THIS_MODULE,
+	.release = &inference_release,
+	.poll    = &inference_poll,
+	.read    = &inference_read,
+};
+
 /**
- * ethosn_inference_register() - Create an inference job
+ * schedule_on_free_cores() - Schedule queued inferences on the free cores.
+ * @ethosn:	Ethos-N device
+ *
+ * Keep scheduling until either the queue is empty or no core is free, then
+ * stage the next inference on the busy cores.
+ */
+static void schedule_on_free_cores(struct ethosn_device *ethosn)
+{
+	struct ethosn_core *core;
+	int i;
+
+	while (!ethosn_sched_empty(&ethosn->queue.sched)) {
+		/* Get the free core best suited to the next inference. */
+		core = get_free_core(ethosn, preferred_core(ethosn));
+
+		if (!core) {
+			dev_dbg(ethosn->dev,
+				"Could not find any free core. Total cores = %d\n",
+				ethosn->num_cores);
+			break;
+		}
+
+		if (mutex_lock_interruptible(&core->mutex))
+			break;
+
+		schedule_queued_inference(core);
+
+		/* If no inference was scheduled on the core, set the status
+		 * as free.
+		 */
+		if (core->current_inference == NULL)
+			core->status = ETHOSN_CORE_FREE;
+
+		mutex_unlock(&core->mutex);
+	}
+
+	/* Prepare the next inference of the busy cores that have none. */
+	for (i = 0; i < ethosn->num_cores; ++i) {
+		if (ethosn_sched_empty(&ethosn->queue.sched))
+			break;
+
+		core = ethosn->core[i];
+		if (mutex_lock_interruptible(&core->mutex))
+			break;
+
+		stage_queued_inference(core);
+
+		mutex_unlock(&core->mutex);
+	}
+}
+
+/**
+ * inference_submit() - Create a file descriptor for an inference job and
+ *                      queue it for execution
+ * @network: Inference network
+ * @inference: Inference created from @req or from a binding set
+ * @req: Inference description to log, or NULL if there is none
+ *
+ * Takes ownership of the reference to @inference.
  *
  * Return: File descriptor on success, else error code.
  */
-static int ethosn_inference_register(struct ethosn_network *network,
-				     struct ethosn_inference_req *req)
+static int inference_submit(struct ethosn_network *network,
+			    struct ethosn_inference *inference,
+			    const struct ethosn_inference_req *req)
 {
-	static const struct file_operations inference_fops = {
-		.owner   = THIS_MODULE,
-		.release = &inference_release,
-		.poll    = &inference_poll,
-		.read    = &inference_read,
-	};
 	struct ethosn_device *ethosn = network->ethosn;
 	struct ethosn_core *core = ethosn->core[0];
-	struct ethosn_inference *inference;
 	struct ethosn_log_uapi_inference_req log;
 	int ret_fd, ret;
 
-	inference = inference_create(network, req);
-	if (IS_ERR(inference))
-		return PTR_ERR(inference);
-
 	ret_fd = anon_inode_getfd("ethosn-inference",
 				  &inference_fops,
 				  inference,
@@ -711,14 +1079,16 @@ static int ethosn_inference_register(struct ethosn_network *network,
 	dev_dbg(ifr_to_dev(inference),
 		"Registered inference. handle=0x%pK\n", inference);
 
-	log.request = *req;
-	log.handle = (ptrdiff_t)inference;
-	log.network_handle = (ptrdiff_t)network;
-	log.fd = ret_fd;
-	ethosn_log_uapi(core, ETHOSN_IOCTL_SCHEDULE_INFERENCE, &log,
-			sizeof(log));
+	if (req) {
+		log.request = *req;
+		log.handle = (ptrdiff_t)inference;
+		log.network_handle = (ptrdiff_t)network;
+		log.fd = ret_fd;
+		ethosn_log_uapi(core, ETHOSN_IOCTL_SCHEDULE_INFERENCE, &log,
+				sizeof(log));
+	}
 
-	ret = mutex_lock_interruptible(&ethosn->mutex);
+	ret = mutex_lock_interruptible(&ethosn->queue.inference_queue_mutex);
 	if (ret) {
 		put_inference(inference);
 
@@ -726,36 +1096,371 @@ static int ethosn_inference_register(struct ethosn_network *network,
 	}
 
 	/* Queue and schedule inference. */
-	list_add_tail(&inference->queue_node, &ethosn->queue.inference_queue);
+	enqueue_inference(inference);
 
-	mutex_unlock(&ethosn->mutex);
+	mutex_unlock(&ethosn->queue.inference_queue_mutex);
 
-	/* Get the next free core. */
-	core = get_free_core(ethosn);
+	schedule_on_free_cores(ethosn);
 
-	if (!core) {
-		dev_dbg(ethosn->dev,
-			"Could not find any free core. Total cores = %d\n",
-			ethosn->num_cores);
-	} else {
-		ret = mutex_lock_interruptible(&core->mutex);
+	return ret_fd;
+}
 
-		/* Return the file descriptor */
-		if (ret)
-			return ret_fd;
+/**
+ * ethosn_inference_register() - Create an inference job
+ *
+ * Return: File descriptor on success, else error code.
+ */
+static int ethosn_inference_register(struct ethosn_network *network,
+				     struct ethosn_inference_req *req)
+{
+	struct ethosn_inference *inference;
 
-		schedule_queued_inference(core);
+	inference = inference_create(network, req);
+	if (IS_ERR(inference))
+		return PTR_ERR(inference);
 
-		/* If no inference was scheduled on the core, set the status
-		 * as free.
-		 */
-		if (core->current_inference == NULL)
-			core->status = ETHOSN_CORE_FREE;
+	return inference_submit(network, inference, req);
+}
 
-		mutex_unlock(&core->mutex);
+/**
+ * ethosn_inferences_register() - Create and queue a batch of inference jobs
+ * @network: Inference network
+ * @batch_req: Batch description. One inference file descriptor per
+ *             inference is written to batch_req->inference_fds.
+ *
+ * Either all the inferences of the batch are queued, or none are and no
+ * file descriptors are created.
+ *
+ * Return: 0 on success, else error code.
+ */
+static int ethosn_inferences_register(struct ethosn_network *network,
+				      struct ethosn_inference_batch_req *batch_req)
+{
+	struct ethosn_device *ethosn = network->ethosn;
+	const u32 num = batch_req->num_inferences;
+	struct ethosn_inference_req *reqs;
+	struct ethosn_inference **inferences;
+	struct file **files;
+	int *fds;
+	struct ethosn_log_uapi_inference_req log;
+	u32 num_created = 0;
+	u32 num_fds = 0;
+	u32 num_files = 0;
+	u32 i;
+	int ret;
+
+	if (num == 0 || num > ETHOSN_MAX_BATCH)
+		return -EINVAL;
+
+	reqs = kcalloc(num, sizeof(*reqs), GFP_KERNEL);
+	inferences = kcalloc(num, sizeof(*inferences), GFP_KERNEL);
+	files = kcalloc(num, sizeof(*files), GFP_KERNEL);
+	fds = kcalloc(num, sizeof(*fds), GFP_KERNEL);
+	if (!reqs || !inferences || !files || !fds) {
+		ret = -ENOMEM;
+		goto out_free_arrays;
+	}
+
+	if (copy_from_user(reqs, batch_req->inferences,
+			   num * sizeof(*reqs))) {
+		ret = -EFAULT;
+		goto out_free_arrays;
+	}
+
+	for (num_created = 0; num_created < num; ++num_created) {
+		inferences[num_created] =
+			inference_create(network, &reqs[num_created]);
+		if (IS_ERR(inferences[num_created])) {
+			ret = PTR_ERR(inferences[num_created]);
+			goto err_put_inferences;
+		}
+	}
+
+	for (num_fds = 0; num_fds < num; ++num_fds) {
+		fds[num_fds] = get_unused_fd_flags(O_RDONLY | O_CLOEXEC);
+		if (fds[num_fds] < 0) {
+			ret = fds[num_fds];
+			goto err_put_fds;
+		}
+	}
+
+	for (num_files = 0; num_files < num; ++num_files) {
+		files[num_files] = anon_inode_getfile("ethosn-inference",
+						      &inference_fops,
+						      inferences[num_files],
+						      O_RDONLY);
+		if (IS_ERR(files[num_files])) {
+			ret = PTR_ERR(files[num_files]);
+			goto err_put_files;
+		}
+	}
+
+	if (copy_to_user(batch_req->inference_fds, fds, num * sizeof(*fds))) {
+		ret = -EFAULT;
+		goto err_put_files;
+	}
+
+	ret = mutex_lock_interruptible(&ethosn->queue.inference_queue_mutex);
+	if (ret)
+		goto err_put_files;
+
+	/* Queue the whole batch. Nothing can fail past this point. */
+	for (i = 0; i < num; ++i)
+		enqueue_inference(inferences[i]);
+
+	mutex_unlock(&ethosn->queue.inference_queue_mutex);
+
+	for (i = 0; i < num; ++i) {
+		dev_dbg(ifr_to_dev(inferences[i]),
+			"Registered inference. handle=0x%pK\n", inferences[i]);
+
+		log.request = reqs[i];
+		log.handle = (ptrdiff_t)inferences[i];
+		log.network_handle = (ptrdiff_t)network;
+		log.fd = fds[i];
+		ethosn_log_uapi(ethosn->core[0],
+				ETHOSN_IOCTL_SCHEDULE_INFERENCE, &log,
+				sizeof(log));
+	}
+
+	schedule_on_free_cores(ethosn);
+
+	/* Install the file descriptors last. Once installed, user space can
+	 * close them, which puts the inferences, so they must not be accessed
+	 * again.
+	 */
+	for (i = 0; i < num; ++i)
+		fd_install(fds[i], files[i]);
+
+	ret = 0;
+	goto out_free_arrays;
+
+err_put_files:
+	/* Releasing the files also puts their inferences. */
+	for (i = 0; i < num_files; ++i)
+		fput(files[i]);
+
+err_put_fds:
+	for (i = 0; i < num_fds; ++i)
+		put_unused_fd(fds[i]);
+
+err_put_inferences:
+	for (i = num_files; i < num_created; ++i)
+		put_inference(inferences[i]);
+
+out_free_arrays:
+	kfree(fds);
+	kfree(files);
+	kfree(inferences);
+	kfree(reqs);
+
+	return ret;
+}
+
+static int binding_set_release(struct inode *inode,
+			       struct file *filep)
+{
+	struct ethosn_binding_set *binding_set = filep->private_data;
+	struct ethosn_network *network = binding_set->network;
+
+	dev_dbg(net_to_dev(network),
+		"Released binding set. handle=0x%pK\n", binding_set);
+
+	free_buffers(network->num_inputs, binding_set->inputs);
+	free_buffers(network->num_outputs, binding_set->outputs);
+
+	put_network(network);
+
+	kfree(binding_set);
+
+	return 0;
+}
+
+/**
+ * binding_set_ioctl() - Take binding set command from user space
+ * @filep: File struct
+ * @cmd: User command
+ * * ETHOSN_IOCTL_SCHEDULE_BINDING_SET
+ *
+ * Return:
+ * * Inference file descriptor on success
+ * * Negative error code on failure
+ */
+static long binding_set_ioctl(struct file *filep,
+			      unsigned int cmd,
+			      unsigned long arg)
+{
+	struct ethosn_binding_set *binding_set = filep->private_data;
+	struct ethosn_inference *inference;
+	int ret;
+
+	switch (cmd) {
+	case ETHOSN_IOCTL_SCHEDULE_BINDING_SET: {
+		inference = inference_create_from_binding_set(binding_set);
+		if (IS_ERR(inference)) {
+			ret = PTR_ERR(inference);
+			break;
+		}
+
+		ret = inference_submit(binding_set->network, inference, NULL);
+		break;
+	}
+	default: {
+		ret = -EINVAL;
+	}
 	}
 
+	return ret;
+}
+
+/**
+ * ethosn_binding_set_register() - Create a binding set
+ * @network: Network the buffers are bound to
+ * @req: Input and output buffers of the binding set
+ *
+ * Return: File descriptor on success, else error code.
+ */
+static int ethosn_binding_set_register(struct ethosn_network *network,
+				       struct ethosn_inference_req *req)
+{
+	static const struct file_operations binding_set_fops = {
+		.owner          = THIS_MODULE,
+		.release        = &binding_set_release,
+		.unlocked_ioctl = &binding_set_ioctl,
+#ifdef CONFIG_COMPAT
+		.compat_ioctl   = &binding_set_ioctl,
+#endif
+	};
+	struct ethosn_binding_set *binding_set;
+	struct ethosn_log_uapi_inference_req log;
+	int ret_fd, ret;
+
+	if ((req->num_inputs != network->num_inputs) ||
+	    (req->num_outputs != network->num_outputs))
+		return -EINVAL;
+
+	binding_set = kzalloc(sizeof(*binding_set), GFP_KERNEL);
+	if (!binding_set)
+		return -ENOMEM;
+
+	binding_set->network = network;
+	binding_set->priority = READ_ONCE(network->priority);
+	binding_set->id = atomic64_inc_return(&binding_set_id_counter);
+
+	binding_set->inputs = read_buffer_fds(network,
+					      req->num_inputs,
+					      req->input_fds,
+					      network->inputs);
+	if (IS_ERR(binding_set->inputs)) {
+		ret = PTR_ERR(binding_set->inputs);
+		goto err_free_binding_set;
+	}
+
+	binding_set->outputs = read_buffer_fds(network,
+					       req->num_outputs,
+					       req->output_fds,
+					       network->outputs);
+	if (IS_ERR(binding_set->outputs)) {
+		ret = PTR_ERR(binding_set->outputs);
+		goto err_free_inputs;
+	}
+
+	get_network(network);
+
+	ret_fd = anon_inode_getfd("ethosn-binding-set",
+				  &binding_set_fops,
+				  binding_set,
+				  O_RDONLY | O_CLOEXEC);
+	if (ret_fd < 0) {
+		ret = ret_fd;
+		put_network(network);
+		goto err_free_outputs;
+	}
+
+	binding_set->file = fget(ret_fd);
+	fput(binding_set->file);
+
+	dev_dbg(net_to_dev(network),
+		"Registered binding set. handle=0x%pK\n", binding_set);
+
+	log.request = *req;
+	log.handle = (ptrdiff_t)binding_set;
+	log.network_handle = (ptrdiff_t)network;
+	log.fd = ret_fd;
+	ethosn_log_uapi(network->ethosn->core[0],
+			ETHOSN_IOCTL_CREATE_BINDING_SET, &log, sizeof(log));
+
 	return ret_fd;
+
+err_free_outputs:
+	free_buffers(network->num_outputs, binding_set->outputs);
+err_free_inputs:
+	free_buffers(network->num_inputs, binding_set->inputs);
+err_free_binding_set:
+	kfree(binding_set);
+
+	return ret;
+}
+
+/**
+ * set_scheduling_priority() - Set the priority class of the inferences
+ *                             subsequently scheduled by a network
+ * @network: Network
+ * @priority: One of ETHOSN_INFERENCE_PRIORITY_*
+ *
+ * The high priority class is always scheduled first, so one network using it
+ * could keep every other network from running. It is therefore reserved for
+ * callers which may raise their own scheduling priority.
+ *
+ * Return: 0 on success, else error code.
+ */
+static int set_scheduling_priority(struct ethosn_network *network,
+				   u32 priority)
+{
+	if (priority >= ETHOSN_SCHED_NUM_PRIORITIES)
+		return -EINVAL;
+
+	if ((priority == ETHOSN_INFERENCE_PRIORITY_HIGH) &&
+	    !capable(CAP_SYS_NICE))
+		return -EPERM;
+
+	WRITE_ONCE(network->priority, priority);
+
+	return 0;
+}
+
+/**
+ * set_scheduling_weight() - Set the weight of a network in the round-robin
+ *                           between the networks of a priority class
+ * @network: Network
+ * @weight: Weight, which is limited to ETHOSN_SCHEDULING_WEIGHT_MAX
+ *
+ * As for the high priority class, large weights are reserved for callers
+ * which may raise their own scheduling priority.
+ *
+ * Return: 0 on success, else error code.
+ */
+static int set_scheduling_weight(struct ethosn_network *network,
+				 u32 weight)
+{
+	struct ethosn_device *ethosn = network->ethosn;
+	int ret;
+
+	if ((weight > ETHOSN_SCHEDULING_WEIGHT_MAX_UNPRIVILEGED) &&
+	    !capable(CAP_SYS_NICE))
+		return -EPERM;
+
+	weight = min_t(u32, weight, ETHOSN_SCHEDULING_WEIGHT_MAX);
+
+	ret = mutex_lock_interruptible(&ethosn->queue.inference_queue_mutex);
+	if (ret)
+		return ret;
+
+	ret = ethosn_sched_client_set_weight(&network->sched_client, weight);
+
+	mutex_unlock(&ethosn->queue.inference_queue_mutex);
+
+	return ret;
 }
 
 /**
@@ -763,9 +1468,16 @@ static int ethosn_inference_register(struct ethosn_network *network,
  * @filep: File struct
  * @cmd: User command
  * * ETHOSN_IOCTL_SCHEDULE_INFERENCE
+ * * ETHOSN_IOCTL_SCHEDULE_INFERENCES
+ * * ETHOSN_IOCTL_CREATE_BINDING_SET
+ * * ETHOSN_IOCTL_SET_SCHEDULING_WEIGHT
+ * * ETHOSN_IOCTL_SET_SCHEDULING_PRIORITY
  *
  * Return:
- * * Inference file descriptor on success
+ * * Inference or binding set file descriptor on success
+ * * 0 on success for ETHOSN_IOCTL_SCHEDULE_INFERENCES,
+ *   ETHOSN_IOCTL_SET_SCHEDULING_WEIGHT and
+ *   ETHOSN_IOCTL_SET_SCHEDULING_PRIORITY
  * * Negative error code on failure
  */
 static long network_ioctl(struct file *filep,
@@ -794,6 +1506,57 @@ static long network_ioctl(struct file *filep,
 
 		break;
 	}
+	case ETHOSN_IOCTL_SCHEDULE_INFERENCES: {
+		struct ethosn_inference_batch_req batch_req;
+
+		if (copy_from_user(&batch_req, udata, sizeof(batch_req))) {
+			ret = -EFAULT;
+			break;
+		}
+
+		ret = ethosn_inferences_register(network, &batch_req);
+
+		dev_dbg(net_to_dev(network), "SCHEDULE_INFERENCES: %llu",
+			time);
+
+		break;
+	}
+	case ETHOSN_IOCTL_CREATE_BINDING_SET: {
+		struct ethosn_inference_req binding_req;
+
+		if (copy_from_user(&binding_req, udata, sizeof(binding_req))) {
+			ret = -EFAULT;
+			break;
+		}
+
+		ret = ethosn_binding_set_register(network, &binding_req);
+
+		break;
+	}
+	case ETHOSN_IOCTL_SET_SCHEDULING_WEIGHT: {
+		u32 weight;
+
+		if (copy_from_user(&weight, udata, sizeof(weight))) {
+			ret = -EFAULT;
+			break;
+		}
+
+		ret = set_scheduling_weight(network, weight);
+
+		break;
+	}
+	case ETHOSN_IOCTL_SET_SCHEDULING_PRIORITY: {
+		u32 priority;
+
+		if (copy_from_user(&priority, udata, sizeof(priority))) {
+			ret = -EFAULT;
+			break;
+		}
+
+		ret = set_scheduling_priority(network, priority);
+
+		break;
+	}
 	case ETHOSN_IOCTL_GET_INTERMEDIATE_BUFFER: {
 		if (network->ethosn->num_cores > 1)
 			dev_warn(net_to_dev(
@@ -1023,6 +1786,12 @@ static int alloc_init_inference_data(struct ethosn_network *network,
 	if (!network->intermediate_data)
 		return ret;
 
+	network->bound_binding_set_ids = kzalloc(
+		(sizeof(*(network->bound_binding_set_ids)) * num_cores),
+		GFP_KERNEL);
+	if (!network->bound_binding_set_ids)
+		return ret;
+
 	for (i = 0; i < num_cores; i++) {
 		core = network->ethosn->core[i];
 		ret = -ENOMEM;
@@ -1098,6 +1867,7 @@ static void free_network(struct ethosn_network *network)
 	ethosn_dma_free(ethosn->allocator, network->constant_dma_data);
 	ethosn_dma_free(ethosn->allocator, network->constant_cu_data);
 
+	kfree(network->bound_binding_set_ids);
 	kfree(network->intermediate_data);
 	kfree(network->inference_data);
 	kfree(network->intermediates);
@@ -1138,6 +1908,8 @@ static struct ethosn_network *create_network(struct ethosn_device *ethosn,
 		return ERR_PTR(-ENOMEM);
 
 	network->ethosn = ethosn;
+	ethosn_sched_client_init(&network->sched_client);
+	network->priority = ETHOSN_INFERENCE_PRIORITY_MEDIUM;
 
 	/* Increment ref-count on device. Not sure why this is necessary,
 	 * but it needs to be before any potential failures so that when we
@@ -1286,17 +2058,30 @@ void ethosn_network_poll(struct ethosn_core *core,
 			 struct ethosn_inference *inference,
 			 int status)
 {
+	struct ethosn_inference *staged = core->staged_inference;
+
+	if (core->current_inference)
+		end_busy_period(core);
+
+	/* Reset current running inference. */
+	core->current_inference = NULL;
+
+	/* Send the staged inference to the firmware before completing the
+	 * current one, so that the core starts working on it straight away.
+	 */
+	if (staged) {
+		core->staged_inference = NULL;
+		(void)schedule_inference(staged);
+		put_inference(staged);
+	}
+
 	if (inference) {
-		struct ethosn_dma_allocator *allocator =
-			core->parent->allocator;
 		int i;
 
 		inference->status = status;
 
 		for (i = 0; i < inference->network->num_outputs; ++i)
-			ethosn_dma_sync_for_cpu(
-				allocator,
-				inference->outputs[i]->dma_info);
+			ethosn_buffer_sync_for_cpu(inference->outputs[i]);
 
 		wake_up_poll(&inference->poll_wqh, POLLIN);
 		put_inference(inference);
@@ -1306,9 +2091,10 @@ void ethosn_network_poll(struct ethosn_core *core,
 			ktime_get_ns(), core->core_id);
 	}
 
-	/* Reset current running inference. */
-	core->current_inference = NULL;
+	/* Schedule next queued inference, unless the staged one was. */
+	if (!core->current_inference)
+		schedule_queued_inference(core);
 
-	/* Schedule next queued inference. */
-	schedule_queued_inference(core);
+	/* Prepare the inference after it while it runs. */
+	stage_queued_inference(core);
 }
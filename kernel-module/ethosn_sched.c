@@ -0,0 +1,225 @@
+/*
+ *
+ * (C) COPYRIGHT 2021 Arm Limited. All rights reserved.
+ *
+ * This program is free software and is provided to you under the terms of the
+ * GNU General Public License version 2 as published by the Free Software
+ * Foundation, and any use by you of this program is subject to the terms
+ * of such GNU licence.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you can access it online at
+ * http://www.gnu.org/licenses/gpl-2.0.html.
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ */
+
+#include "ethosn_sched.h"
+
+#ifdef __KERNEL__
+#include <linux/errno.h>
+#include <linux/kernel.h>
+#include <linux/string.h>
+#endif
+
+static const char *const priority_names[ETHOSN_SCHED_NUM_PRIORITIES] = {
+	[ETHOSN_INFERENCE_PRIORITY_LOW]    = "low",
+	[ETHOSN_INFERENCE_PRIORITY_MEDIUM] = "medium",
+	[ETHOSN_INFERENCE_PRIORITY_HIGH]   = "high",
+};
+
+void ethosn_sched_init(struct ethosn_sched *sched)
+{
+	u32 p;
+
+	memset(sched, 0, sizeof(*sched));
+
+	for (p = 0; p < ETHOSN_SCHED_NUM_PRIORITIES; ++p)
+		INIT_LIST_HEAD(&sched->active_clients[p]);
+}
+
+void ethosn_sched_client_init(struct ethosn_sched_client *client)
+{
+	u32 p;
+
+	for (p = 0; p < ETHOSN_SCHED_NUM_PRIORITIES; ++p) {
+		struct ethosn_sched_client_queue *queue = &client->queues[p];
+
+		INIT_LIST_HEAD(&queue->entries);
+		INIT_LIST_HEAD(&queue->active_node);
+		queue->client = client;
+		queue->credits = 0;
+	}
+
+	client->weight = ETHOSN_SCHEDULING_WEIGHT_DEFAULT;
+}
+
+int ethosn_sched_client_set_weight(struct ethosn_sched_client *client,
+				   u32 weight)
+{
+	if (weight == 0)
+		return -EINVAL;
+
+	/* Takes effect from the next round of each priority class */
+	client->weight = weight;
+
+	return 0;
+}
+
+void ethosn_sched_entry_init(struct ethosn_sched_entry *entry)
+{
+	INIT_LIST_HEAD(&entry->node);
+	entry->client = NULL;
+	entry->priority = 0;
+}
+
+int ethosn_sched_enqueue(struct ethosn_sched *sched,
+			 struct ethosn_sched_entry *entry,
+			 struct ethosn_sched_client *client,
+			 u32 priority)
+{
+	struct ethosn_sched_client_queue *queue;
+
+	if (priority >= ETHOSN_SCHED_NUM_PRIORITIES)
+		return -EINVAL;
+
+	queue = &client->queues[priority];
+
+	/* A client joins the round-robin at the back, with full credits */
+	if (list_empty(&queue->entries)) {
+		queue->credits = client->weight;
+		list_add_tail(&queue->active_node,
+			      &sched->active_clients[priority]);
+	}
+
+	entry->client = client;
+	entry->priority = priority;
+	list_add_tail(&entry->node, &queue->entries);
+
+	++sched->num_queued;
+	++sched->depth[priority];
+	++sched->stats.num_enqueued[priority];
+	if (sched->depth[priority] > sched->stats.max_depth[priority])
+		sched->stats.max_depth[priority] = sched->depth[priority];
+
+	return 0;
+}
+
+static void remove_entry(struct ethosn_sched *sched,
+			 struct ethosn_sched_entry *entry)
+{
+	struct ethosn_sched_client_queue *queue =
+		&entry->client->queues[entry->priority];
+
+	list_del_init(&entry->node);
+
+	--sched->num_queued;
+	--sched->depth[entry->priority];
+
+	if (list_empty(&queue->entries))
+		list_del_init(&queue->active_node);
+}
+
+/* The queue of the client to dequeue from next, or NULL if none is queued */
+static struct ethosn_sched_client_queue *next_queue(
+	const struct ethosn_sched *sched)
+{
+	u32 p;
+
+	for (p = ETHOSN_SCHED_NUM_PRIORITIES; p-- > 0;)
+		if (!list_empty(&sched->active_clients[p]))
+			return list_first_entry(&sched->active_clients[p],
+						struct ethosn_sched_client_queue,
+						active_node);
+
+	return NULL;
+}
+
+struct ethosn_sched_entry *ethosn_sched_peek(const struct ethosn_sched *sched)
+{
+	struct ethosn_sched_client_queue *queue = next_queue(sched);
+
+	if (!queue)
+		return NULL;
+
+	return list_first_entry(&queue->entries, struct ethosn_sched_entry,
+				node);
+}
+
+struct ethosn_sched_entry *ethosn_sched_dequeue(struct ethosn_sched *sched)
+{
+	struct ethosn_sched_client_queue *queue = next_queue(sched);
+	struct ethosn_sched_entry *entry;
+	u32 p;
+
+	if (!queue)
+		return NULL;
+
+	entry = list_first_entry(&queue->entries, struct ethosn_sched_entry,
+				 node);
+	p = entry->priority;
+
+	remove_entry(sched, entry);
+	++sched->stats.num_dequeued[p];
+
+	/* Move on to the next client once this one has used up its
+	 * credits, unless it has just left the round-robin.
+	 */
+	if (!list_empty(&queue->entries) && --queue->credits == 0) {
+		queue->credits = queue->client->weight;
+		list_move_tail(&queue->active_node,
+			       &sched->active_clients[p]);
+		++sched->stats.num_rotations[p];
+	}
+
+	return entry;
+}
+
+void ethosn_sched_remove(struct ethosn_sched *sched,
+			 struct ethosn_sched_entry *entry)
+{
+	if (list_empty(&entry->node))
+		return;
+
+	++sched->stats.num_removed[entry->priority];
+	remove_entry(sched, entry);
+}
+
+int ethosn_sched_print_stats(const struct ethosn_sched *sched,
+			     char *buf,
+			     size_t size)
+{
+	int n = 0;
+	u32 p;
+
+	n += scnprintf(&buf[n], size - n, "Queued        : %u\n",
+		       sched->num_queued);
+
+	for (p = ETHOSN_SCHED_NUM_PRIORITIES; p-- > 0;) {
+		const struct ethosn_sched_stats *stats = &sched->stats;
+
+		n += scnprintf(&buf[n], size - n,
+			       "Priority %s:\n"
+			       "  Depth       : %u\n"
+			       "  Max depth   : %u\n"
+			       "  Enqueued    : %llu\n"
+			       "  Dequeued    : %llu\n"
+			       "  Removed     : %llu\n"
+			       "  Rotations   : %llu\n",
+			       priority_names[p],
+			       sched->depth[p],
+			       stats->max_depth[p],
+			       stats->num_enqueued[p],
+			       stats->num_dequeued[p],
+			       stats->num_removed[p],
+			       stats->num_rotations[p]);
+	}
+
+	return n;
+}
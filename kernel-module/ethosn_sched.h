@@ -0,0 +1,236 @@
+/*
+ *
+ * (C) COPYRIGHT 2021 Arm Limited. All rights reserved.
+ *
+ * This program is free software and is provided to you under the terms of the
+ * GNU General Public License version 2 as published by the Free Software
+ * Foundation, and any use by you of this program is subject to the terms
+ * of such GNU licence.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you can access it online at
+ * http://www.gnu.org/licenses/gpl-2.0.html.
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ */
+
+#ifndef _ETHOSN_SCHED_H_
+#define _ETHOSN_SCHED_H_
+
+#ifdef __KERNEL__
+#include <linux/list.h>
+#include <linux/types.h>
+#else
+/* Before the uapi header, which uses bool */
+#include "ethosn_sched_user.h"
+#endif
+
+#include "uapi/ethosn.h"
+
+/*
+ * Inference queue policy.
+ *
+ * Queued inferences are scheduled strictly by priority class, highest first.
+ * Within a priority class, the clients with queued inferences are served in
+ * weighted round-robin order: a client has up to its weight inferences
+ * scheduled before the next client is served. The inferences of a client
+ * are scheduled in the order they were queued.
+ *
+ * This has no dependencies on the rest of the driver, and builds in user
+ * space with the definitions in ethosn_sched_user.h so that it can be tested
+ * there. No locks are taken: the caller must serialize all the accesses to a
+ * scheduler and to its clients.
+ */
+
+#define ETHOSN_SCHED_NUM_PRIORITIES (ETHOSN_INFERENCE_PRIORITY_HIGH + 1)
+
+/*
+ * Length of a line of ethosn_sched_print_stats() with a counter of up to the
+ * given number of digits.
+ */
+#define ETHOSN_SCHED_STATS_LINE_LEN(digits) \
+	(sizeof("Queued        : \n") - 1 + (digits))
+
+/*
+ * Size of a buffer which ethosn_sched_print_stats() can never truncate: a
+ * line for the number of queued entries, then for each priority class a
+ * header with the longest name and six counters at their maximum values.
+ */
+#define ETHOSN_SCHED_STATS_MAX_SIZE					\
+	(ETHOSN_SCHED_STATS_LINE_LEN(10) +				\
+	 ETHOSN_SCHED_NUM_PRIORITIES *					\
+		 (sizeof("Priority medium:\n") - 1 +			\
+		  2 * ETHOSN_SCHED_STATS_LINE_LEN(10) +			\
+		  4 * ETHOSN_SCHED_STATS_LINE_LEN(20)) +		\
+	 1)
+
+struct ethosn_sched_client;
+
+/**
+ * struct ethosn_sched_entry - A schedulable item, e.g. an inference.
+ * @node:	Node in the queue of the client, or empty if not queued.
+ * @client:	Client the entry was queued by.
+ * @priority:	Priority class the entry was queued with.
+ */
+struct ethosn_sched_entry {
+	struct list_head           node;
+	struct ethosn_sched_client *client;
+	u32                        priority;
+};
+
+/**
+ * struct ethosn_sched_client_queue - Queue of a client for one priority class.
+ * @entries:	Queued entries, in the order they were queued.
+ * @active_node:Node in the list of active clients of the priority class, or
+ *		empty if there are no queued entries.
+ * @client:	Client owning the queue.
+ * @credits:	Number of entries that can still be dequeued before the next
+ *		client of the priority class is served.
+ */
+struct ethosn_sched_client_queue {
+	struct list_head           entries;
+	struct list_head           active_node;
+	struct ethosn_sched_client *client;
+	u32                        credits;
+};
+
+/**
+ * struct ethosn_sched_client - A client of the scheduler, e.g. a network.
+ * @queues:	Queue for each priority class.
+ * @weight:	Number of entries dequeued in turn in each round-robin round.
+ */
+struct ethosn_sched_client {
+	struct ethosn_sched_client_queue queues[ETHOSN_SCHED_NUM_PRIORITIES];
+	u32                              weight;
+};
+
+/**
+ * struct ethosn_sched_stats - Scheduler statistics, per priority class.
+ * @num_enqueued:	Number of entries queued.
+ * @num_dequeued:	Number of entries dequeued to be scheduled.
+ * @num_removed:	Number of entries removed without being scheduled.
+ * @num_rotations:	Number of times a client used up its credits.
+ * @max_depth:		Maximum number of entries queued at once.
+ */
+struct ethosn_sched_stats {
+	u64 num_enqueued[ETHOSN_SCHED_NUM_PRIORITIES];
+	u64 num_dequeued[ETHOSN_SCHED_NUM_PRIORITIES];
+	u64 num_removed[ETHOSN_SCHED_NUM_PRIORITIES];
+	u64 num_rotations[ETHOSN_SCHED_NUM_PRIORITIES];
+	u32 max_depth[ETHOSN_SCHED_NUM_PRIORITIES];
+};
+
+/**
+ * struct ethosn_sched - Scheduler.
+ * @active_clients:	Queues of the clients with queued entries, for each
+ *			priority class, in round-robin order.
+ * @depth:		Number of queued entries, for each priority class.
+ * @num_queued:		Total number of queued entries.
+ * @stats:		Statistics.
+ */
+struct ethosn_sched {
+	struct list_head          active_clients[ETHOSN_SCHED_NUM_PRIORITIES];
+	u32                       depth[ETHOSN_SCHED_NUM_PRIORITIES];
+	u32                       num_queued;
+	struct ethosn_sched_stats stats;
+};
+
+/**
+ * ethosn_sched_init() - Initialize a scheduler with no queued entries.
+ * @sched:	Scheduler.
+ */
+void ethosn_sched_init(struct ethosn_sched *sched);
+
+/**
+ * ethosn_sched_client_init() - Initialize a client with a weight of
+ *                              ETHOSN_SCHEDULING_WEIGHT_DEFAULT.
+ * @client:	Client.
+ */
+void ethosn_sched_client_init(struct ethosn_sched_client *client);
+
+/**
+ * ethosn_sched_client_set_weight() - Set the weight of a client.
+ * @client:	Client.
+ * @weight:	Number of entries of the client dequeued in turn.
+ *
+ * Return: 0 on success, else -EINVAL if the weight is 0.
+ */
+int ethosn_sched_client_set_weight(struct ethosn_sched_client *client,
+				   u32 weight);
+
+/**
+ * ethosn_sched_entry_init() - Initialize an entry which is not queued.
+ * @entry:	Entry.
+ */
+void ethosn_sched_entry_init(struct ethosn_sched_entry *entry);
+
+/**
+ * ethosn_sched_enqueue() - Queue an entry.
+ * @sched:	Scheduler.
+ * @entry:	Entry, which must not be queued already.
+ * @client:	Client queueing the entry.
+ * @priority:	Priority class, one of ETHOSN_INFERENCE_PRIORITY_*.
+ *
+ * Return: 0 on success, else -EINVAL if the priority is invalid.
+ */
+int ethosn_sched_enqueue(struct ethosn_sched *sched,
+			 struct ethosn_sched_entry *entry,
+			 struct ethosn_sched_client *client,
+			 u32 priority);
+
+/**
+ * ethosn_sched_dequeue() - Dequeue the next entry to schedule.
+ * @sched:	Scheduler.
+ *
+ * Return: The entry, or NULL if none are queued.
+ */
+struct ethosn_sched_entry *ethosn_sched_dequeue(struct ethosn_sched *sched);
+
+/**
+ * ethosn_sched_peek() - Get the entry ethosn_sched_dequeue() would return,
+ *                       without dequeuing it.
+ * @sched:	Scheduler.
+ *
+ * Return: The entry, or NULL if none are queued.
+ */
+struct ethosn_sched_entry *ethosn_sched_peek(const struct ethosn_sched *sched);
+
+/**
+ * ethosn_sched_remove() - Remove an entry without scheduling it.
+ * @sched:	Scheduler.
+ * @entry:	Entry. Nothing is done if it is not queued.
+ */
+void ethosn_sched_remove(struct ethosn_sched *sched,
+			 struct ethosn_sched_entry *entry);
+
+/**
+ * ethosn_sched_empty() - Check whether any entries are queued.
+ * @sched:	Scheduler.
+ *
+ * Return: True if no entries are queued.
+ */
+static inline bool ethosn_sched_empty(const struct ethosn_sched *sched)
+{
+	return sched->num_queued == 0;
+}
+
+/**
+ * ethosn_sched_print_stats() - Print the statistics of a scheduler.
+ * @sched:	Scheduler.
+ * @buf:	Buffer to print to.
+ * @size:	Size of the buffer. The output is truncated if this is less than
+ *		ETHOSN_SCHED_STATS_MAX_SIZE.
+ *
+ * Return: Number of characters printed, excluding the terminating null.
+ */
+int ethosn_sched_print_stats(const struct ethosn_sched *sched,
+			     char *buf,
+			     size_t size);
+
+#endif /* _ETHOSN_SCHED_H_ */
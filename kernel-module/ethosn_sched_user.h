@@ -0,0 +1,111 @@
+/*
+ *
+ * (C) COPYRIGHT 2021 Arm Limited. All rights reserved.
+ *
+ * This program is free software and is provided to you under the terms of the
+ * GNU General Public License version 2 as published by the Free Software
+ * Foundation, and any use by you of this program is subject to the terms
+ * of such GNU licence.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you can access it online at
+ * http://www.gnu.org/licenses/gpl-2.0.html.
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ */
+
+#ifndef _ETHOSN_SCHED_USER_H_
+#define _ETHOSN_SCHED_USER_H_
+
+/*
+ * User space versions of the kernel types and helpers used by the scheduler,
+ * so that ethosn_sched.c can be built and tested outside the kernel. Only
+ * what the scheduler needs is provided, with the same semantics as the
+ * kernel versions.
+ */
+
+#include <errno.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef uint32_t u32;
+typedef unsigned long long u64;
+
+#define container_of(ptr, type, member) \
+	((type *)((char *)(ptr) - offsetof(type, member)))
+
+struct list_head {
+	struct list_head *next;
+	struct list_head *prev;
+};
+
+static inline void INIT_LIST_HEAD(struct list_head *list)
+{
+	list->next = list;
+	list->prev = list;
+}
+
+static inline bool list_empty(const struct list_head *head)
+{
+	return head->next == head;
+}
+
+static inline void list_add_tail(struct list_head *entry,
+				 struct list_head *head)
+{
+	entry->prev = head->prev;
+	entry->next = head;
+	head->prev->next = entry;
+	head->prev = entry;
+}
+
+static inline void list_del_init(struct list_head *entry)
+{
+	entry->prev->next = entry->next;
+	entry->next->prev = entry->prev;
+	INIT_LIST_HEAD(entry);
+}
+
+static inline void list_move_tail(struct list_head *entry,
+				  struct list_head *head)
+{
+	list_del_init(entry);
+	list_add_tail(entry, head);
+}
+
+#define list_first_entry(head, type, member) \
+	container_of((head)->next, type, member)
+
+/* Like snprintf(), but returns the number of characters actually written */
+static inline int scnprintf(char *buf,
+			    size_t size,
+			    const char *fmt,
+			    ...)
+{
+	va_list args;
+	int n;
+
+	if (size == 0)
+		return 0;
+
+	va_start(args, fmt);
+	n = vsnprintf(buf, size, fmt, args);
+	va_end(args);
+
+	if (n < 0)
+		return 0;
+
+	return (size_t)n >= size ? (int)size - 1 : n;
+}
+
+#endif /* _ETHOSN_SCHED_USER_H_ */
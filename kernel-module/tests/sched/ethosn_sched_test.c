@@ -0,0 +1,283 @@
+/*
+ *
+ * (C) COPYRIGHT 2021 Arm Limited. All rights reserved.
+ *
+ * This program is free software and is provided to you under the terms of the
+ * GNU General Public License version 2 as published by the Free Software
+ * Foundation, and any use by you of this program is subject to the terms
+ * of such GNU licence.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you can access it online at
+ * http://www.gnu.org/licenses/gpl-2.0.html.
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ */
+
+/*
+ * User space tests of the inference queue policy in ethosn_sched.c. Build and
+ * run from this directory with:
+ *
+ *   gcc -std=gnu99 -Wall -Wextra -Werror -I../.. ethosn_sched_test.c \
+ *       ../../ethosn_sched.c -o ethosn_sched_test && ./ethosn_sched_test
+ */
+
+#include "ethosn_sched.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define NUM_ITEMS 32
+
+struct item {
+	struct ethosn_sched_entry entry;
+	int                       id;
+};
+
+static int num_failures;
+
+#define CHECK(cond)							      \
+	do {								      \
+		if (!(cond)) {						      \
+			fprintf(stderr, "%s:%d: %s: check failed: %s\n",      \
+				__FILE__, __LINE__, __func__, #cond);	      \
+			++num_failures;					      \
+		}							      \
+	} while (0)
+
+static struct item items[NUM_ITEMS];
+static int num_items;
+
+static void enqueue(struct ethosn_sched *sched,
+		    struct ethosn_sched_client *client,
+		    u32 priority,
+		    int id)
+{
+	struct item *item = &items[num_items++];
+
+	ethosn_sched_entry_init(&item->entry);
+	item->id = id;
+	CHECK(ethosn_sched_enqueue(sched, &item->entry, client, priority) == 0);
+}
+
+/* Dequeues everything and checks the ids come out in the expected order */
+static void check_order(struct ethosn_sched *sched,
+			const int *expected,
+			int num_expected)
+{
+	int i;
+
+	for (i = 0; i < num_expected; ++i) {
+		struct ethosn_sched_entry *peeked = ethosn_sched_peek(sched);
+		struct ethosn_sched_entry *entry = ethosn_sched_dequeue(sched);
+
+		CHECK(entry != NULL);
+		CHECK(peeked == entry);
+		if (!entry)
+			return;
+
+		if (container_of(entry, struct item, entry)->id != expected[i]) {
+			fprintf(stderr, "  entry %d: expected %d, got %d\n", i,
+				expected[i],
+				container_of(entry, struct item, entry)->id);
+			++num_failures;
+		}
+	}
+
+	CHECK(ethosn_sched_empty(sched));
+	CHECK(ethosn_sched_peek(sched) == NULL);
+	CHECK(ethosn_sched_dequeue(sched) == NULL);
+}
+
+static void reset(struct ethosn_sched *sched,
+		  struct ethosn_sched_client *clients,
+		  int num_clients)
+{
+	int i;
+
+	ethosn_sched_init(sched);
+	for (i = 0; i < num_clients; ++i)
+		ethosn_sched_client_init(&clients[i]);
+
+	num_items = 0;
+}
+
+static void test_priority_classes(void)
+{
+	static const int expected[] = { 30, 31, 20, 10, 11, 12 };
+	struct ethosn_sched sched;
+	struct ethosn_sched_client clients[2];
+
+	reset(&sched, clients, 2);
+	enqueue(&sched, &clients[0], ETHOSN_INFERENCE_PRIORITY_LOW, 10);
+	enqueue(&sched, &clients[1], ETHOSN_INFERENCE_PRIORITY_MEDIUM, 20);
+	enqueue(&sched, &clients[0], ETHOSN_INFERENCE_PRIORITY_LOW, 11);
+	enqueue(&sched, &clients[1], ETHOSN_INFERENCE_PRIORITY_HIGH, 30);
+	enqueue(&sched, &clients[0], ETHOSN_INFERENCE_PRIORITY_LOW, 12);
+	enqueue(&sched, &clients[0], ETHOSN_INFERENCE_PRIORITY_HIGH, 31);
+
+	check_order(&sched, expected, 6);
+}
+
+static void test_weighted_round_robin(void)
+{
+	static const int expected[] = { 10, 11, 12, 20, 13, 14, 15, 21, 22, 23 };
+	struct ethosn_sched sched;
+	struct ethosn_sched_client clients[2];
+	int i;
+
+	reset(&sched, clients, 2);
+	CHECK(ethosn_sched_client_set_weight(&clients[0], 3) == 0);
+	for (i = 0; i < 6; ++i)
+		enqueue(&sched, &clients[0], ETHOSN_INFERENCE_PRIORITY_MEDIUM,
+			10 + i);
+
+	for (i = 0; i < 4; ++i)
+		enqueue(&sched, &clients[1], ETHOSN_INFERENCE_PRIORITY_MEDIUM,
+			20 + i);
+
+	check_order(&sched, expected, 10);
+	CHECK(sched.stats.num_rotations[ETHOSN_INFERENCE_PRIORITY_MEDIUM] ==
+	      4);
+}
+
+static void test_rejoin_at_back(void)
+{
+	static const int expected_first[] = { 10, 20 };
+	static const int expected_second[] = { 21, 11, 30 };
+	struct ethosn_sched sched;
+	struct ethosn_sched_client clients[3];
+
+	reset(&sched, clients, 3);
+	enqueue(&sched, &clients[0], ETHOSN_INFERENCE_PRIORITY_LOW, 10);
+	enqueue(&sched, &clients[1], ETHOSN_INFERENCE_PRIORITY_LOW, 20);
+	check_order(&sched, expected_first, 2);
+
+	/* Clients which left the round-robin rejoin it in the order they queue
+	 * again, not in their previous order.
+	 */
+	enqueue(&sched, &clients[1], ETHOSN_INFERENCE_PRIORITY_LOW, 21);
+	enqueue(&sched, &clients[0], ETHOSN_INFERENCE_PRIORITY_LOW, 11);
+	enqueue(&sched, &clients[2], ETHOSN_INFERENCE_PRIORITY_LOW, 30);
+	check_order(&sched, expected_second, 3);
+}
+
+static void test_weight_change(void)
+{
+	static const int expected[] = { 10, 20, 11, 12, 21, 13 };
+	struct ethosn_sched sched;
+	struct ethosn_sched_client clients[2];
+	int i;
+
+	reset(&sched, clients, 2);
+	for (i = 0; i < 4; ++i)
+		enqueue(&sched, &clients[0], ETHOSN_INFERENCE_PRIORITY_LOW,
+			10 + i);
+
+	enqueue(&sched, &clients[1], ETHOSN_INFERENCE_PRIORITY_LOW, 20);
+	enqueue(&sched, &clients[1], ETHOSN_INFERENCE_PRIORITY_LOW, 21);
+
+	/* Takes effect once the current credits of the client are used up */
+	CHECK(ethosn_sched_client_set_weight(&clients[0], 2) == 0);
+	CHECK(ethosn_sched_client_set_weight(&clients[0], 0) == -EINVAL);
+	CHECK(clients[0].weight == 2);
+
+	check_order(&sched, expected, 6);
+}
+
+static void test_remove(void)
+{
+	static const int expected[] = { 10, 30, 12 };
+	struct ethosn_sched sched;
+	struct ethosn_sched_client clients[3];
+
+	reset(&sched, clients, 3);
+	enqueue(&sched, &clients[0], ETHOSN_INFERENCE_PRIORITY_LOW, 10);
+	enqueue(&sched, &clients[0], ETHOSN_INFERENCE_PRIORITY_LOW, 11);
+	enqueue(&sched, &clients[1], ETHOSN_INFERENCE_PRIORITY_LOW, 20);
+	enqueue(&sched, &clients[0], ETHOSN_INFERENCE_PRIORITY_LOW, 12);
+	enqueue(&sched, &clients[2], ETHOSN_INFERENCE_PRIORITY_LOW, 30);
+
+	ethosn_sched_remove(&sched, &items[1].entry);
+	ethosn_sched_remove(&sched, &items[2].entry);
+
+	/* Removing an entry which is not queued does nothing */
+	ethosn_sched_remove(&sched, &items[2].entry);
+
+	CHECK(sched.num_queued == 3);
+	CHECK(sched.stats.num_removed[ETHOSN_INFERENCE_PRIORITY_LOW] == 2);
+
+	/* Client 1 has left the round-robin, so it is not served */
+	check_order(&sched, expected, 3);
+}
+
+static void test_invalid_priority(void)
+{
+	struct ethosn_sched sched;
+	struct ethosn_sched_client client;
+	struct ethosn_sched_entry entry;
+
+	reset(&sched, &client, 1);
+	ethosn_sched_entry_init(&entry);
+
+	CHECK(ethosn_sched_enqueue(&sched, &entry, &client,
+				   ETHOSN_SCHED_NUM_PRIORITIES) == -EINVAL);
+	CHECK(ethosn_sched_empty(&sched));
+}
+
+static void test_print_stats_max_size(void)
+{
+	char full[ETHOSN_SCHED_STATS_MAX_SIZE * 2];
+	char buf[ETHOSN_SCHED_STATS_MAX_SIZE];
+	struct ethosn_sched sched;
+	int full_len;
+	int n;
+	u32 p;
+
+	ethosn_sched_init(&sched);
+	sched.num_queued = UINT32_MAX;
+	for (p = 0; p < ETHOSN_SCHED_NUM_PRIORITIES; ++p) {
+		sched.depth[p] = UINT32_MAX;
+		sched.stats.max_depth[p] = UINT32_MAX;
+		sched.stats.num_enqueued[p] = ~0ULL;
+		sched.stats.num_dequeued[p] = ~0ULL;
+		sched.stats.num_removed[p] = ~0ULL;
+		sched.stats.num_rotations[p] = ~0ULL;
+	}
+
+	/* The largest possible output fits without being truncated */
+	full_len = ethosn_sched_print_stats(&sched, full, sizeof(full));
+	CHECK((size_t)full_len == strlen(full));
+	CHECK((size_t)full_len < ETHOSN_SCHED_STATS_MAX_SIZE);
+
+	n = ethosn_sched_print_stats(&sched, buf, sizeof(buf));
+	CHECK(n == full_len);
+	CHECK(strcmp(buf, full) == 0);
+}
+
+int main(void)
+{
+	test_priority_classes();
+	test_weighted_round_robin();
+	test_rejoin_at_back();
+	test_weight_change();
+	test_remove();
+	test_invalid_priority();
+	test_print_stats_max_size();
+
+	if (num_failures) {
+		fprintf(stderr, "%d check(s) failed\n", num_failures);
+
+		return 1;
+	}
+
+	printf("All tests passed\n");
+
+	return 0;
+}
@@ -147,6 +147,27 @@ struct ethosn_network_req {
 	struct ethosn_buffer_infos  output_buffers;
 };
 
+/*
+ * Priority classes of the inferences of a network, set with
+ * ETHOSN_IOCTL_SET_SCHEDULING_PRIORITY. Queued inferences of a higher
+ * priority class are always scheduled before those of a lower class.
+ * Setting ETHOSN_INFERENCE_PRIORITY_HIGH requires CAP_SYS_NICE.
+ */
+#define ETHOSN_INFERENCE_PRIORITY_LOW    0
+#define ETHOSN_INFERENCE_PRIORITY_MEDIUM 1
+#define ETHOSN_INFERENCE_PRIORITY_HIGH   2
+
+/*
+ * Weights of a network in the round-robin between the networks with queued
+ * inferences of the same priority class, set with
+ * ETHOSN_IOCTL_SET_SCHEDULING_WEIGHT. Weights above
+ * ETHOSN_SCHEDULING_WEIGHT_MAX_UNPRIVILEGED require CAP_SYS_NICE, and weights
+ * above ETHOSN_SCHEDULING_WEIGHT_MAX are reduced to it.
+ */
+#define ETHOSN_SCHEDULING_WEIGHT_DEFAULT          1
+#define ETHOSN_SCHEDULING_WEIGHT_MAX_UNPRIVILEGED 4
+#define ETHOSN_SCHEDULING_WEIGHT_MAX              64
+
 struct ethosn_inference_req {
 	__u32            num_inputs;
 	const int __user *input_fds;
@@ -155,11 +176,48 @@ struct ethosn_inference_req {
 	const int __user *output_fds;
 };
 
+/*
+ * A batch of inferences to schedule with ETHOSN_IOCTL_SCHEDULE_INFERENCES.
+ * inference_fds must point to num_inferences ints, which receive the
+ * inference file descriptor of each inference request. There can be at most
+ * ETHOSN_MAX_BATCH inferences in a batch.
+ */
+#define ETHOSN_MAX_BATCH 64
+
+struct ethosn_inference_batch_req {
+	__u32                                    num_inferences;
+	const struct ethosn_inference_req __user *inferences;
+	int __user                               *inference_fds;
+};
+
 struct ethosn_buffer_req {
 	__u32 size;
 	__u32 flags;
 };
 
+/*
+ * Sources of the memory imported with ETHOSN_IOCTL_IMPORT_BUFFER.
+ */
+#define ETHOSN_BUFFER_IMPORT_DMA_BUF  0
+#define ETHOSN_BUFFER_IMPORT_USER_PTR 1
+
+/*
+ * A request to wrap existing memory in a buffer, rather than allocating it.
+ * @handle: A dma-buf file descriptor for ETHOSN_BUFFER_IMPORT_DMA_BUF, or the
+ *          page-aligned user space address of the memory for
+ *          ETHOSN_BUFFER_IMPORT_USER_PTR.
+ * @type:   One of ETHOSN_BUFFER_IMPORT_*.
+ * @size:   Size of the memory, which must be a multiple of the page size.
+ * @flags:  Access mode of the buffer, as for struct ethosn_buffer_req.
+ *          MB_ZERO is not supported.
+ */
+struct ethosn_buffer_import_req {
+	__u64 handle;
+	__u32 type;
+	__u32 size;
+	__u32 flags;
+};
+
 /*****************************************************************************
  * Capabilities
  *****************************************************************************/
@@ -294,12 +352,28 @@ struct ethosn_profiling_config {
 /**
  * enum ethosn_poll_counter_name - All the counters that can be queried using
  *      ETHOSN_IOCTL_GET_COUNTER_VALUE.
+ *
+ * Counters are per core. The core is selected with ETHOSN_POLL_COUNTER_CORE()
+ * and is core 0 if none is given. The mailbox counters are only available
+ * while profiling is enabled on the core. Counters wrap around at INT_MAX.
  */
 enum ethosn_poll_counter_name {
 	ETHOSN_POLL_COUNTER_NAME_MAILBOX_MESSAGES_SENT,
 	ETHOSN_POLL_COUNTER_NAME_MAILBOX_MESSAGES_RECEIVED,
+	/* Number of inferences the core has run */
+	ETHOSN_POLL_COUNTER_NAME_INFERENCES_RUN,
+	/* Total time the core has spent running inferences, in milliseconds */
+	ETHOSN_POLL_COUNTER_NAME_BUSY_TIME_MS,
+	/* Number of inferences running or staged on the core */
+	ETHOSN_POLL_COUNTER_NAME_QUEUE_DEPTH,
 };
 
+#define ETHOSN_POLL_COUNTER_CORE_SHIFT 16
+#define ETHOSN_POLL_COUNTER_NAME_MASK \
+	((1U << ETHOSN_POLL_COUNTER_CORE_SHIFT) - 1)
+#define ETHOSN_POLL_COUNTER_CORE(name, core_id) \
+	((name) | ((core_id) << ETHOSN_POLL_COUNTER_CORE_SHIFT))
+
 /**
  * struct ethosn_log_firmware_header - Firmware log header.
  * @inference:		Current running inference handle.
@@ -336,6 +410,56 @@ struct ethosn_log_firmware_header {
 	ETHOSN_IO(0x08)
 #define ETHOSN_IOCTL_GET_INTERMEDIATE_BUFFER \
 	ETHOSN_IO(0x09)
+/*
+ * Create a binding set from a network file descriptor. A binding set holds
+ * the input and output buffers of an inference request, which are resolved
+ * once, so that the same buffers can be scheduled repeatedly with
+ * ETHOSN_IOCTL_SCHEDULE_BINDING_SET. The priority of the network when the
+ * binding set is created applies to every inference scheduled from it.
+ * Returns the binding set file descriptor.
+ */
+#define ETHOSN_IOCTL_CREATE_BINDING_SET \
+	ETHOSN_IOW(0x0a, struct ethosn_inference_req)
+/*
+ * Schedule an inference using the buffers of a binding set, called on the
+ * binding set file descriptor. Returns an inference file descriptor, as for
+ * ETHOSN_IOCTL_SCHEDULE_INFERENCE.
+ */
+#define ETHOSN_IOCTL_SCHEDULE_BINDING_SET \
+	ETHOSN_IO(0x0b)
+/*
+ * Schedule a batch of inferences from a network file descriptor. Either all
+ * the inferences are queued, or none are. Returns 0 on success.
+ */
+#define ETHOSN_IOCTL_SCHEDULE_INFERENCES \
+	ETHOSN_IOW(0x0c, struct ethosn_inference_batch_req)
+/*
+ * Set the weight of a network in the round-robin between the networks with
+ * queued inferences of the same priority class, from a network file
+ * descriptor. Up to weight inferences of the network are scheduled in turn.
+ * The default weight is ETHOSN_SCHEDULING_WEIGHT_DEFAULT. Returns -EPERM if
+ * the weight needs CAP_SYS_NICE and the caller does not have it.
+ */
+#define ETHOSN_IOCTL_SET_SCHEDULING_WEIGHT \
+	ETHOSN_IOW(0x0d, __u32)
+/*
+ * Create a buffer backed by existing memory instead of newly allocated memory,
+ * so that the NPU can read inputs from and write outputs to it without
+ * copying. The memory stays in use until the buffer file descriptor is
+ * released. Only supported when the NPU is behind an IOMMU.
+ * Returns the buffer file descriptor, as for ETHOSN_IOCTL_CREATE_BUFFER.
+ */
+#define ETHOSN_IOCTL_IMPORT_BUFFER \
+	ETHOSN_IOW(0x0e, struct ethosn_buffer_import_req)
+/*
+ * Set the priority class, one of ETHOSN_INFERENCE_PRIORITY_*, of the
+ * inferences subsequently scheduled and binding sets subsequently created
+ * from a network file descriptor. The default is
+ * ETHOSN_INFERENCE_PRIORITY_MEDIUM. Returns -EPERM if the priority needs
+ * CAP_SYS_NICE and the caller does not have it.
+ */
+#define ETHOSN_IOCTL_SET_SCHEDULING_PRIORITY \
+	ETHOSN_IOW(0x0f, __u32)
 
 /*
  * Results from reading an inference file descriptor.